@@ -43,6 +43,34 @@ project "UnitTests"
         links { "gtest" }
         staticruntime "on"
 
+-- The global new/delete override replaces the operators for the whole executable,
+-- so its tests get their own instead of running all other unit tests on top of it
+project "GlobalNewTests"
+    kind "ConsoleApp"
+    language "C++"
+    targetdir "build/global_new_tests/%{cfg.buildcfg}"
+
+    files { "src/GlobalNewTests/**.h", "src/GlobalNewTests/**.cpp" }
+
+    links { "MemorySystem", "Core" }
+	
+	filter { "platforms:Win64" }
+		libdirs { "./ext/*/lib/x64/" }
+	filter { "platforms:Win32" }
+		libdirs { "./ext/*/lib/x86/" }
+	filter {}
+		
+    includedirs { "ext/googletest/include", "src/MemorySystem/", "src/Core" }
+    filter "configurations:Debug"
+        symbols "On"
+        links { "gtestd" }
+        staticruntime "on"
+
+    filter "configurations:Release"
+	    symbols "Off"
+        links { "gtest" }
+        staticruntime "on"
+
 -- Spark subsystems that will emit .lib files as artifacts
 project "Core"
 	kind "StaticLib"
@@ -0,0 +1,153 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FreeList_Benchmarks.h"
+#include "../CommonStruct.h"
+#include "FreeList/FreeList.h"
+#include "FreeList/ConcurrentFreeList.h"
+#include "FreeList/RemoteFreeList.h"
+
+static const size_t NUM_OPERATIONS_PER_THREAD = 100000;
+static const size_t NUM_CHUNKS_IN_FLIGHT = 16;
+static const size_t NUM_PIPELINE_MESSAGES = 1000000;
+static const size_t PIPELINE_QUEUE_SIZE = 1024;
+
+static size_t GetBenchmarkThreadCount()
+{
+	const size_t hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 0 ? hardwareThreads : 4;
+}
+
+///
+/// Every thread repeatedly takes a handful of chunks, touches them and hands them
+/// back. The single-owner FreeList has to be guarded by a mutex for this, the
+/// ConcurrentFreeList is used as-is.
+///
+template <typename GetChunkFunc, typename ReturnChunkFunc>
+static void run_freelist_stress(GetChunkFunc getChunk, ReturnChunkFunc returnChunk)
+{
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < GetBenchmarkThreadCount(); ++t)
+	{
+		threads.emplace_back([&getChunk, &returnChunk]()
+		{
+			AllocationData* chunks[NUM_CHUNKS_IN_FLIGHT];
+
+			for (size_t op = 0; op < NUM_OPERATIONS_PER_THREAD; op += NUM_CHUNKS_IN_FLIGHT)
+			{
+				for (AllocationData*& chunk : chunks)
+				{
+					chunk = static_cast<AllocationData*>(getChunk());
+					chunk->data_block_2[0] = op;
+				}
+
+				for (AllocationData* chunk : chunks)
+				{
+					returnChunk(chunk);
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+void freelist_mt_100000_mutex()
+{
+	const size_t chunkCount = GetBenchmarkThreadCount() * NUM_CHUNKS_IN_FLIGHT;
+	std::vector<AllocationData> memory(chunkCount);
+
+	std::mutex mutex;
+	sp::core::FreeList freeList(memory.data(), memory.data() + chunkCount, sizeof(AllocationData));
+
+	run_freelist_stress(
+		[&mutex, &freeList]() { std::lock_guard<std::mutex> lock(mutex); return freeList.GetChunk(); },
+		[&mutex, &freeList](void* chunk) { std::lock_guard<std::mutex> lock(mutex); freeList.ReturnChunk(chunk); });
+}
+
+void freelist_mt_100000_lockfree()
+{
+	const size_t chunkCount = GetBenchmarkThreadCount() * NUM_CHUNKS_IN_FLIGHT;
+	std::vector<AllocationData> memory(chunkCount);
+
+	sp::core::ConcurrentFreeList freeList(memory.data(), memory.data() + chunkCount, sizeof(AllocationData));
+
+	run_freelist_stress(
+		[&freeList]() { return freeList.GetChunk(); },
+		[&freeList](void* chunk) { freeList.ReturnChunk(chunk); });
+}
+
+///
+/// One thread takes chunks and passes them through a bounded single-producer/single-consumer
+/// queue to a second thread, which hands them back, like a job system freeing the messages
+/// of another thread. Twice the queue size in chunks is enough to never run dry.
+///
+template <typename GetChunkFunc, typename ReturnChunkFunc>
+static void run_freelist_producer_consumer(GetChunkFunc getChunk, ReturnChunkFunc returnChunk)
+{
+	std::vector<AllocationData*> queue(PIPELINE_QUEUE_SIZE);
+	std::atomic<size_t> writeIndex(0);
+	std::atomic<size_t> readIndex(0);
+
+	std::thread consumer([&]()
+	{
+		for (size_t message = 0; message < NUM_PIPELINE_MESSAGES; ++message)
+		{
+			while (writeIndex.load(std::memory_order_acquire) == message)
+			{
+				std::this_thread::yield();
+			}
+
+			AllocationData* chunk = queue[message % PIPELINE_QUEUE_SIZE];
+			readIndex.store(message + 1, std::memory_order_release);
+			chunk->data_block_2[1] = chunk->data_block_2[0];
+			returnChunk(chunk);
+		}
+	});
+
+	for (size_t message = 0; message < NUM_PIPELINE_MESSAGES; ++message)
+	{
+		AllocationData* chunk = static_cast<AllocationData*>(getChunk());
+		chunk->data_block_2[0] = message;
+
+		while (message - readIndex.load(std::memory_order_acquire) == PIPELINE_QUEUE_SIZE)
+		{
+			std::this_thread::yield();
+		}
+
+		queue[message % PIPELINE_QUEUE_SIZE] = chunk;
+		writeIndex.store(message + 1, std::memory_order_release);
+	}
+
+	consumer.join();
+}
+
+void freelist_producer_consumer_1000000_mutex()
+{
+	std::vector<AllocationData> memory(2 * PIPELINE_QUEUE_SIZE);
+
+	std::mutex mutex;
+	sp::core::FreeList freeList(memory.data(), memory.data() + memory.size(), sizeof(AllocationData));
+
+	run_freelist_producer_consumer(
+		[&mutex, &freeList]() { std::lock_guard<std::mutex> lock(mutex); return freeList.GetChunk(); },
+		[&mutex, &freeList](void* chunk) { std::lock_guard<std::mutex> lock(mutex); freeList.ReturnChunk(chunk); });
+}
+
+void freelist_producer_consumer_1000000_remote()
+{
+	std::vector<AllocationData> memory(2 * PIPELINE_QUEUE_SIZE);
+
+	// Owned by the producer, the consumer only ever returns chunks remotely
+	sp::core::RemoteFreeList freeList(memory.data(), memory.data() + memory.size(), sizeof(AllocationData));
+
+	run_freelist_producer_consumer(
+		[&freeList]() { return freeList.GetChunk(); },
+		[&freeList](void* chunk) { freeList.ReturnChunk(chunk); });
+}
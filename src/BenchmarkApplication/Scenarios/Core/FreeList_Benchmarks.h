@@ -0,0 +1,6 @@
+#pragma once
+
+void freelist_mt_100000_mutex();
+void freelist_mt_100000_lockfree();
+void freelist_producer_consumer_1000000_mutex();
+void freelist_producer_consumer_1000000_remote();
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "AllocatorLatency_Benchmarks.h"
+#include "Allocator/NonGrowing/BuddyAllocator.h"
+#include "Allocator/NonGrowing/TlsfAllocator.h"
+#include "Allocator/Growing/SizeClassAllocator.h"
+
+static const size_t NUM_OPERATIONS = 200000;
+static const size_t NUM_SLOTS = 1024;
+static const size_t MIN_ALLOCATION_SIZE = 16;
+static const size_t MAX_ALLOCATION_SIZE = 4096;
+static const size_t ALLOCATION_ALIGNMENT = 16;
+static const size_t ARENA_SIZE = 64 * 1024 * 1024;
+
+///
+/// A single step of the workload, either allocates size bytes into the slot or
+/// frees the allocation the slot holds
+///
+struct LatencyOperation
+{
+	size_t slot;
+	size_t size;
+};
+
+///
+/// Random alloc/free mix over a fixed number of slots, so the amount of live
+/// memory stays bounded while the free memory gets fragmented. Generated up front
+/// with a fixed seed, every allocator runs the same sequence.
+///
+static std::vector<LatencyOperation> CreateOperations()
+{
+	std::mt19937 random(1337);
+	std::uniform_int_distribution<size_t> slotDistribution(0, NUM_SLOTS - 1);
+	std::uniform_int_distribution<size_t> sizeDistribution(MIN_ALLOCATION_SIZE, MAX_ALLOCATION_SIZE);
+
+	std::vector<LatencyOperation> operations(NUM_OPERATIONS);
+	for (LatencyOperation& operation : operations)
+	{
+		operation.slot = slotDistribution(random);
+		operation.size = sizeDistribution(random);
+	}
+	return operations;
+}
+
+// Built before the benchmark application starts its clock, so the timed scenario
+// only runs the workload itself
+static const std::vector<LatencyOperation> g_operations = CreateOperations();
+static std::vector<double> g_latencies(NUM_OPERATIONS);
+static const char* g_allocatorName = nullptr;
+
+///
+/// Sorts the recorded latencies once the process exits, after the benchmark
+/// application printed its time. Goes to stderr, stdout only carries that time.
+///
+static void PrintLatencyPercentiles()
+{
+	std::sort(g_latencies.begin(), g_latencies.end());
+	const auto percentile = [](double fraction)
+	{
+		return g_latencies[static_cast<size_t>(fraction * (g_latencies.size() - 1))];
+	};
+
+	std::fprintf(stderr, "%s ns p50=%.0lf p99=%.0lf p999=%.0lf max=%.0lf\n", g_allocatorName,
+		percentile(0.5), percentile(0.99), percentile(0.999), g_latencies.back());
+}
+
+///
+/// Times every single Alloc and Dealloc of the workload, the latency distribution in
+/// nanoseconds is reported at exit. The tail (p99 and above) is what matters for
+/// real-time use, the mean hides it. The timer overhead is included in all values.
+///
+template <typename AllocFunction, typename DeallocFunction>
+static void run_allocator_latency(const char* allocatorName, AllocFunction allocFunction, DeallocFunction deallocFunction)
+{
+	void* slots[NUM_SLOTS] = {};
+
+	for (size_t idx = 0; idx < NUM_OPERATIONS; ++idx)
+	{
+		const LatencyOperation& operation = g_operations[idx];
+		void*& slot = slots[operation.slot];
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if (slot)
+		{
+			deallocFunction(slot);
+			slot = nullptr;
+		}
+		else
+		{
+			slot = allocFunction(operation.size);
+		}
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		g_latencies[idx] = std::chrono::duration<double, std::nano>(end - start).count();
+	}
+
+	for (void* slot : slots)
+	{
+		if (slot)
+		{
+			deallocFunction(slot);
+		}
+	}
+
+	g_allocatorName = allocatorName;
+	std::atexit(&PrintLatencyPercentiles);
+}
+
+void allocator_latency_malloc()
+{
+	run_allocator_latency("malloc",
+		[](size_t size) { return std::malloc(size); },
+		[](void* memory) { std::free(memory); });
+}
+
+void allocator_latency_tlsf()
+{
+	sp::memory::TlsfAllocator tlsfAllocator(ARENA_SIZE);
+	run_allocator_latency("tlsf",
+		[&tlsfAllocator](size_t size) { return tlsfAllocator.Alloc(size, ALLOCATION_ALIGNMENT, 0); },
+		[&tlsfAllocator](void* memory) { tlsfAllocator.Dealloc(memory); });
+}
+
+void allocator_latency_buddy()
+{
+	sp::memory::BuddyAllocator buddyAllocator(ARENA_SIZE);
+	run_allocator_latency("buddy",
+		[&buddyAllocator](size_t size) { return buddyAllocator.Alloc(size, ALLOCATION_ALIGNMENT, 0); },
+		[&buddyAllocator](void* memory) { buddyAllocator.Dealloc(memory); });
+}
+
+void allocator_latency_size_class()
+{
+	sp::memory::SizeClassAllocator sizeClassAllocator(ARENA_SIZE / 4);
+	run_allocator_latency("size_class",
+		[&sizeClassAllocator](size_t size) { return sizeClassAllocator.Alloc(size, ALLOCATION_ALIGNMENT, 0); },
+		[&sizeClassAllocator](void* memory) { sizeClassAllocator.Dealloc(memory); });
+}
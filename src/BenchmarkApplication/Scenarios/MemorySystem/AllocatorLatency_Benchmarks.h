@@ -0,0 +1,6 @@
+#pragma once
+
+void allocator_latency_malloc();
+void allocator_latency_tlsf();
+void allocator_latency_buddy();
+void allocator_latency_size_class();
@@ -0,0 +1,37 @@
+#include <cassert>
+
+#include "BoundsChecker_Benchmarks.h"
+#include "../CommonStruct.h"
+#include "Allocator/NonGrowing/LinearAllocator.h"
+#include "BoundsChecker/SweepingBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+
+static const size_t NUM_LIVE_OBJECTS = 10000;
+static const size_t NUM_SWEEPS = 100;
+
+typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::SweepingBoundsChecker32> SweepingLinearRealm;
+
+///
+/// A ValidateAll() sweep over all live allocations of a realm, as it would run
+/// once per frame. The benchmark application times all sweeps together.
+///
+void bounds_checker_validate_all_10000_objects()
+{
+	SweepingLinearRealm realm(NUM_LIVE_OBJECTS * (sizeof(AllocationData) + 128));
+
+	for (size_t i = 0; i < NUM_LIVE_OBJECTS; ++i)
+	{
+		realm.Alloc(sizeof(AllocationData), alignof(AllocationData));
+	}
+
+	volatile size_t violationCount = 0;
+	for (size_t i = 0; i < NUM_SWEEPS; ++i)
+	{
+		violationCount = violationCount + (realm.ValidateAll().allocation != nullptr ? 1u : 0u);
+	}
+
+	{
+		const bool noViolations = violationCount == 0u;
+		assert(noViolations && "Sweep found a violation although no allocation was touched");
+	}
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void bounds_checker_validate_all_10000_objects();
@@ -0,0 +1,102 @@
+#include <cstring>
+#include <new>
+
+#include "FrameAllocator_Benchmarks.h"
+#include "Allocator/NonGrowing/FrameAllocator.h"
+
+static const size_t NUM_FRAMES = 100;
+static const size_t NUM_MESSAGES_PER_FRAME = 1000;
+static const size_t MAX_PAYLOAD_SIZE = 256;
+static const size_t FRAME_ALLOCATOR_OVERHEAD = 16;
+
+///
+/// A message handed from the producing stage in frame N to the consuming stage in
+/// frame N + 1, followed by a payload of varying size
+///
+struct FrameMessage
+{
+	uint32_t type;
+	uint32_t payloadSize;
+};
+
+static size_t GetPayloadSize(size_t messageIndex)
+{
+	return 32 + (messageIndex * 37) % (MAX_PAYLOAD_SIZE - 32);
+}
+
+static FrameMessage* WriteMessage(void* memory, size_t messageIndex)
+{
+	FrameMessage* message = new (memory) FrameMessage;
+	message->type = static_cast<uint32_t>(messageIndex);
+	message->payloadSize = static_cast<uint32_t>(GetPayloadSize(messageIndex));
+	std::memset(message + 1, static_cast<int>(messageIndex), message->payloadSize);
+	return message;
+}
+
+static size_t ReadMessages(FrameMessage* const* messages)
+{
+	size_t checksum = 0;
+	for (size_t idx = 0; idx < NUM_MESSAGES_PER_FRAME; ++idx)
+	{
+		const unsigned char* payload = reinterpret_cast<const unsigned char*>(messages[idx] + 1);
+		checksum += messages[idx]->type + payload[messages[idx]->payloadSize - 1];
+	}
+	return checksum;
+}
+
+void frame_messages_100_frames_new()
+{
+	static FrameMessage* messages[2][NUM_MESSAGES_PER_FRAME];
+	volatile size_t checksum = 0;
+
+	for (size_t frame = 0; frame < NUM_FRAMES; ++frame)
+	{
+		FrameMessage** produced = messages[frame % 2];
+		FrameMessage** consumed = messages[(frame + 1) % 2];
+
+		if (frame > 0)
+		{
+			checksum = checksum + ReadMessages(consumed);
+			for (size_t idx = 0; idx < NUM_MESSAGES_PER_FRAME; ++idx)
+			{
+				delete[] reinterpret_cast<char*>(consumed[idx]);
+			}
+		}
+
+		for (size_t idx = 0; idx < NUM_MESSAGES_PER_FRAME; ++idx)
+		{
+			produced[idx] = WriteMessage(new char[sizeof(FrameMessage) + GetPayloadSize(idx)], idx);
+		}
+	}
+
+	for (FrameMessage* message : messages[(NUM_FRAMES - 1) % 2])
+	{
+		delete[] reinterpret_cast<char*>(message);
+	}
+}
+
+void frame_messages_100_frames_frame_allocator()
+{
+	static FrameMessage* messages[2][NUM_MESSAGES_PER_FRAME];
+	volatile size_t checksum = 0;
+
+	sp::memory::FrameAllocator frameAllocator(NUM_MESSAGES_PER_FRAME * (sizeof(FrameMessage) + MAX_PAYLOAD_SIZE + FRAME_ALLOCATOR_OVERHEAD));
+
+	for (size_t frame = 0; frame < NUM_FRAMES; ++frame)
+	{
+		FrameMessage** produced = messages[frame % 2];
+		FrameMessage** consumed = messages[(frame + 1) % 2];
+
+		if (frame > 0)
+		{
+			// Messages of the last frame are still valid, they are released in bulk next frame
+			frameAllocator.BeginFrame();
+			checksum = checksum + ReadMessages(consumed);
+		}
+
+		for (size_t idx = 0; idx < NUM_MESSAGES_PER_FRAME; ++idx)
+		{
+			produced[idx] = WriteMessage(frameAllocator.Alloc(sizeof(FrameMessage) + GetPayloadSize(idx), alignof(FrameMessage), 0), idx);
+		}
+	}
+}
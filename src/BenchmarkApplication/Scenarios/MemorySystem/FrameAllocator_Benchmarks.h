@@ -0,0 +1,4 @@
+#pragma once
+
+void frame_messages_100_frames_new();
+void frame_messages_100_frames_frame_allocator();
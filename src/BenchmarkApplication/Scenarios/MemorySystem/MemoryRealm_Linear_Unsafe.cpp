@@ -6,12 +6,16 @@
 #include "MemoryRealm/MemoryRealm.h"
 #include "Allocator/NonGrowing/LinearAllocator.h"
 #include "BoundsChecker/SimpleBoundsChecker.h"
+#include "BoundsChecker/NoBoundsChecker.h"
+#include "MemoryTracker/CountingMemoryTracker.h"
 
 static const size_t NUM_ALLOC_OBJ = 1000;
 static const size_t ALLOCATOR_OVERHEAD = 4;
 static const size_t CANARY_OVERHEAD = 8;
 
 typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::SimpleBoundsChecker> LinearBoundsCheckingRealm;
+typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::NoBoundsChecker> LinearRealm;
+typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::NoBoundsChecker, sp::memory::CountingMemoryTracker> CountingLinearRealm;
 
 void memory_realm_linear_1000_objects_unsafe()
 {
@@ -29,4 +33,40 @@ void memory_realm_linear_1000_objects_unsafe()
 		allocation->~AllocationData();
 		realm.Dealloc(allocation);
 	}
-}
\ No newline at end of file
+}
+
+void memory_realm_linear_1000_objects_no_checks()
+{
+	AllocationData* allocations[NUM_ALLOC_OBJ];
+	LinearRealm realm(NUM_ALLOC_OBJ * (sizeof(AllocationData) + ALLOCATOR_OVERHEAD));
+
+	for (size_t idx = 0; idx < NUM_ALLOC_OBJ; ++idx)
+	{
+		void* raw_mem = realm.Alloc(sizeof(AllocationData), 1);
+		allocations[idx] = new (raw_mem) AllocationData;
+	}
+
+	for (AllocationData* allocation : allocations)
+	{
+		allocation->~AllocationData();
+		realm.Dealloc(allocation);
+	}
+}
+
+void memory_realm_linear_1000_objects_counting()
+{
+	AllocationData* allocations[NUM_ALLOC_OBJ];
+	CountingLinearRealm realm(NUM_ALLOC_OBJ * (sizeof(AllocationData) + ALLOCATOR_OVERHEAD));
+
+	for (size_t idx = 0; idx < NUM_ALLOC_OBJ; ++idx)
+	{
+		void* raw_mem = realm.Alloc(sizeof(AllocationData), 1);
+		allocations[idx] = new (raw_mem) AllocationData;
+	}
+
+	for (AllocationData* allocation : allocations)
+	{
+		allocation->~AllocationData();
+		realm.Dealloc(allocation);
+	}
+}
@@ -1,3 +1,5 @@
 #pragma once
 
 void memory_realm_linear_1000_objects_unsafe();
+void memory_realm_linear_1000_objects_no_checks();
+void memory_realm_linear_1000_objects_counting();
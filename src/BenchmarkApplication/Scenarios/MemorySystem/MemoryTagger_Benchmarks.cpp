@@ -0,0 +1,19 @@
+#include <vector>
+
+#include "MemoryTagger_Benchmarks.h"
+#include "MemoryTagger/MemoryPattern.h"
+
+static const size_t TAGGED_BYTES = 64 * 1024 * 1024;
+
+void memory_tagger_fill_64_mib()
+{
+	std::vector<char> memory(TAGGED_BYTES);
+	sp::memory::FillPattern(memory.data(), memory.size(), sp::memory::FREED_MEMORY_PATTERN);
+}
+
+void memory_tagger_check_64_mib()
+{
+	std::vector<char> memory(TAGGED_BYTES, static_cast<char>(sp::memory::FREED_MEMORY_PATTERN));
+	volatile size_t checksum = 0;
+	checksum = checksum + sp::memory::IsFilledWithPattern(memory.data(), memory.size(), sp::memory::FREED_MEMORY_PATTERN);
+}
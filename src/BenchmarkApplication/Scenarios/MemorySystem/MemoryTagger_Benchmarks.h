@@ -0,0 +1,4 @@
+#pragma once
+
+void memory_tagger_fill_64_mib();
+void memory_tagger_check_64_mib();
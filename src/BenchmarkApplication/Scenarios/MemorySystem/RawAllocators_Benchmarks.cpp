@@ -6,10 +6,12 @@
 #include "Allocator/NonGrowing/StackAllocator.h"
 #include "Allocator/NonGrowing/DoubleEndedStackAllocator.h"
 #include "Allocator/NonGrowing/PoolAllocator.h"
+#include "Allocator/Growing/SizeClassAllocator.h"
 
 static const size_t NUM_ALLOC_OBJ = 1000;
 static const size_t LINEAR_ALLOC_OVERHEAD = 4;
 static const size_t STACK_ALLOC_OVERHEAD = 8;
+static const size_t SIZE_CLASS_BYTES = 1024 * 1024;
 
 void allocate_1000_data_objects_new()
 {
@@ -34,6 +36,7 @@ void allocate_1000_data_objects_linear()
 	for (size_t idx = 0; idx < NUM_ALLOC_OBJ; ++idx)
 	{
 		void* raw_mem = linearAlloc.Alloc(sizeof(AllocationData), 1, 0);
+		allocations[idx] = new (raw_mem) AllocationData;
 	}
 
 	for (AllocationData* allocation : allocations)
@@ -96,3 +99,75 @@ void allocate_1000_data_objects_pool()
 		poolAlloc.Dealloc(allocation);
 	}
 }
+
+void allocate_1000_data_objects_size_class()
+{
+	AllocationData* allocations[NUM_ALLOC_OBJ];
+	sp::memory::SizeClassAllocator sizeClassAlloc(SIZE_CLASS_BYTES);
+
+	for (size_t idx = 0; idx < NUM_ALLOC_OBJ; ++idx)
+	{
+		void* raw_mem = sizeClassAlloc.Alloc(sizeof(AllocationData), 1, 0);
+		allocations[idx] = new (raw_mem) AllocationData;
+	}
+
+	for (AllocationData* allocation : allocations)
+	{
+		allocation->~AllocationData();
+		sizeClassAlloc.Dealloc(allocation);
+	}
+}
+
+void allocate_1000_data_objects_linear_batch()
+{
+	AllocationData* allocations[NUM_ALLOC_OBJ];
+	sp::memory::LinearAllocator linearAlloc(NUM_ALLOC_OBJ * (sizeof(AllocationData) + LINEAR_ALLOC_OVERHEAD));
+
+	linearAlloc.AllocN(NUM_ALLOC_OBJ, sizeof(AllocationData), 1, 0, reinterpret_cast<void**>(allocations));
+	for (AllocationData*& allocation : allocations)
+	{
+		allocation = new (allocation) AllocationData;
+	}
+
+	for (AllocationData* allocation : allocations)
+	{
+		allocation->~AllocationData();
+	}
+	linearAlloc.DeallocN(reinterpret_cast<void**>(allocations), NUM_ALLOC_OBJ);
+}
+
+void allocate_1000_data_objects_stack_batch()
+{
+	AllocationData* allocations[NUM_ALLOC_OBJ];
+	sp::memory::StackAllocator stackAlloc(NUM_ALLOC_OBJ * (sizeof(AllocationData) + STACK_ALLOC_OVERHEAD));
+
+	stackAlloc.AllocN(NUM_ALLOC_OBJ, sizeof(AllocationData), 1, 0, reinterpret_cast<void**>(allocations));
+	for (AllocationData*& allocation : allocations)
+	{
+		allocation = new (allocation) AllocationData;
+	}
+
+	for (AllocationData* allocation : allocations)
+	{
+		allocation->~AllocationData();
+	}
+	stackAlloc.DeallocN(reinterpret_cast<void**>(allocations), NUM_ALLOC_OBJ);
+}
+
+void allocate_1000_data_objects_pool_batch()
+{
+	AllocationData* allocations[NUM_ALLOC_OBJ];
+	sp::memory::PoolAllocator poolAlloc(sizeof(AllocationData), NUM_ALLOC_OBJ, 1, 0);
+
+	poolAlloc.AllocN(NUM_ALLOC_OBJ, sizeof(AllocationData), 1, 0, reinterpret_cast<void**>(allocations));
+	for (AllocationData*& allocation : allocations)
+	{
+		allocation = new (allocation) AllocationData;
+	}
+
+	for (AllocationData* allocation : allocations)
+	{
+		allocation->~AllocationData();
+	}
+	poolAlloc.DeallocN(reinterpret_cast<void**>(allocations), NUM_ALLOC_OBJ);
+}
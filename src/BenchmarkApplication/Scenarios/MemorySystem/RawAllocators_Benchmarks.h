@@ -4,4 +4,8 @@ void allocate_1000_data_objects_new();
 void allocate_1000_data_objects_linear();
 void allocate_1000_data_objects_stack();
 void allocate_1000_data_objects_double_ended_stack();
-void allocate_1000_data_objects_pool();
\ No newline at end of file
+void allocate_1000_data_objects_pool();
+void allocate_1000_data_objects_size_class();
+void allocate_1000_data_objects_linear_batch();
+void allocate_1000_data_objects_stack_batch();
+void allocate_1000_data_objects_pool_batch();
\ No newline at end of file
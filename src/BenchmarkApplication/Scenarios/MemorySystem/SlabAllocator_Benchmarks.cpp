@@ -0,0 +1,69 @@
+#include <vector>
+
+#include "SlabAllocator_Benchmarks.h"
+#include "Allocator/Growing/SlabAllocator.h"
+
+static const size_t NUM_OPERATIONS = 100000;
+static const size_t NUM_LIVE_PAYLOADS = 256;
+static const size_t PAYLOAD_BUFFER_SIZE = 64;
+
+///
+/// An entity payload owning a buffer, constructing it costs a heap allocation
+///
+struct BufferedPayload
+{
+	BufferedPayload() : buffer(PAYLOAD_BUFFER_SIZE, 0.0f) {}
+
+	std::vector<float> buffer;
+};
+
+///
+/// Destroys and recreates payloads in a fixed window, like entities spawning and
+/// despawning every frame. The live set never grows, only construction and
+/// allocation are measured.
+///
+template <typename CreateFunction, typename DestroyFunction>
+static void run_payload_churn(CreateFunction createFunction, DestroyFunction destroyFunction)
+{
+	BufferedPayload* payloads[NUM_LIVE_PAYLOADS];
+	for (BufferedPayload*& payload : payloads)
+	{
+		payload = createFunction();
+	}
+
+	for (size_t op = 0; op < NUM_OPERATIONS; ++op)
+	{
+		BufferedPayload*& payload = payloads[(op * 7) % NUM_LIVE_PAYLOADS];
+		destroyFunction(payload);
+		payload = createFunction();
+		payload->buffer[op % PAYLOAD_BUFFER_SIZE] = static_cast<float>(op);
+	}
+
+	for (BufferedPayload* payload : payloads)
+	{
+		destroyFunction(payload);
+	}
+}
+
+void slab_churn_100000_payloads_new()
+{
+	run_payload_churn(
+		[]() { return new BufferedPayload; },
+		[](BufferedPayload* payload) { delete payload; });
+}
+
+void slab_churn_100000_payloads_slab()
+{
+	sp::memory::SlabAllocator<BufferedPayload> slabAllocator(NUM_LIVE_PAYLOADS);
+	run_payload_churn(
+		[&slabAllocator]() { return slabAllocator.Alloc(); },
+		[&slabAllocator](BufferedPayload* payload) { slabAllocator.Dealloc(payload); });
+}
+
+void slab_churn_100000_payloads_caching_slab()
+{
+	sp::memory::CachingSlabAllocator<BufferedPayload> slabAllocator(NUM_LIVE_PAYLOADS);
+	run_payload_churn(
+		[&slabAllocator]() { return slabAllocator.Alloc(); },
+		[&slabAllocator](BufferedPayload* payload) { slabAllocator.Dealloc(payload); });
+}
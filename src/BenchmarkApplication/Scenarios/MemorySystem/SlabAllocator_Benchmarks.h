@@ -0,0 +1,5 @@
+#pragma once
+
+void slab_churn_100000_payloads_new();
+void slab_churn_100000_payloads_slab();
+void slab_churn_100000_payloads_caching_slab();
@@ -0,0 +1,64 @@
+#include <unordered_map>
+#include <vector>
+
+#include "StlAllocator_Benchmarks.h"
+#include "Allocator/NonGrowing/LinearAllocator.h"
+#include "StlAllocator/StlAllocator.h"
+
+static const size_t NUM_FRAMES = 100;
+static const uint32_t NUM_SCRATCH_ELEMENTS = 1000;
+static const uint32_t NUM_SCRATCH_ENTRIES = 100;
+static const size_t SCRATCH_BYTES = 1024 * 1024;
+
+///
+/// Every frame builds a scratch vector and map, uses them and throws them away again.
+/// With the default allocator this hits malloc for every growth step and node, with
+/// the LinearAllocator everything is a pointer bump and one reset per frame.
+///
+template <typename VectorType, typename MapType>
+static uint32_t build_scratch_containers(VectorType& values, MapType& entries)
+{
+	for (uint32_t idx = 0; idx < NUM_SCRATCH_ELEMENTS; ++idx)
+	{
+		values.push_back(idx);
+	}
+
+	for (uint32_t idx = 0; idx < NUM_SCRATCH_ENTRIES; ++idx)
+	{
+		entries[idx] = values[idx];
+	}
+
+	return entries[NUM_SCRATCH_ENTRIES / 2];
+}
+
+void stl_scratch_100_frames_default()
+{
+	volatile uint32_t result = 0;
+
+	for (size_t frame = 0; frame < NUM_FRAMES; ++frame)
+	{
+		std::vector<uint32_t> values;
+		std::unordered_map<uint32_t, uint32_t> entries;
+		result = result + build_scratch_containers(values, entries);
+	}
+}
+
+void stl_scratch_100_frames_linear()
+{
+	typedef std::pair<const uint32_t, uint32_t> MapEntry;
+	typedef std::unordered_map<uint32_t, uint32_t, std::hash<uint32_t>, std::equal_to<uint32_t>, sp::memory::StlAllocator<MapEntry>> ScratchMap;
+
+	volatile uint32_t result = 0;
+	sp::memory::LinearAllocator frameAlloc(SCRATCH_BYTES);
+
+	for (size_t frame = 0; frame < NUM_FRAMES; ++frame)
+	{
+		{
+			std::vector<uint32_t, sp::memory::StlAllocator<uint32_t>> values{ sp::memory::StlAllocator<uint32_t>(frameAlloc) };
+			ScratchMap entries{ sp::memory::StlAllocator<MapEntry>(frameAlloc) };
+			result = result + build_scratch_containers(values, entries);
+		}
+
+		frameAlloc.Reset();
+	}
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void stl_scratch_100_frames_default();
+void stl_scratch_100_frames_linear();
@@ -0,0 +1,121 @@
+#include <thread>
+#include <vector>
+
+#include "ThreadPolicy_Benchmarks.h"
+#include "../CommonStruct.h"
+#include "Allocator/Growing/SizeClassAllocator.h"
+#include "BoundsChecker/NoBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "MemoryTracker/NoMemoryTracker.h"
+#include "MemoryTagger/NoMemoryTagger.h"
+#include "ThreadPolicy/MutexThreadPolicy.h"
+#include "ThreadPolicy/SpinLockThreadPolicy.h"
+#include "ThreadPolicy/PerThreadInstanceThreadPolicy.h"
+
+static const size_t NUM_OPERATIONS_PER_THREAD = 100000;
+static const size_t NUM_ALLOCATIONS_IN_FLIGHT = 16;
+static const size_t BYTES_PER_SIZE_CLASS = 16 * 1024 * 1024;
+
+template <typename ThreadPolicy>
+using ThreadedRealm = sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::NoBoundsChecker,
+	sp::memory::NoMemoryTracker, sp::memory::NoMemoryTagger, ThreadPolicy>;
+
+///
+/// Runs the same alloc/free workload with THREAD_COUNT threads on a fresh realm. Every
+/// thread performs the same number of operations, so the scenarios of one policy are
+/// compared by how they scale: perfect scaling means constant time. Each thread count
+/// is a scenario of its own, the whole run is timed by the benchmark application.
+///
+template <typename ThreadPolicy, size_t THREAD_COUNT>
+static void run_realm_threads()
+{
+	ThreadedRealm<ThreadPolicy> realm(BYTES_PER_SIZE_CLASS);
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < THREAD_COUNT; ++t)
+	{
+		threads.emplace_back([&realm]()
+		{
+			AllocationData* allocations[NUM_ALLOCATIONS_IN_FLIGHT];
+
+			for (size_t op = 0; op < NUM_OPERATIONS_PER_THREAD; op += NUM_ALLOCATIONS_IN_FLIGHT)
+			{
+				for (AllocationData*& allocation : allocations)
+				{
+					allocation = static_cast<AllocationData*>(realm.Alloc(sizeof(AllocationData), 8));
+					allocation->data_block_1[0] = op;
+				}
+
+				for (AllocationData* allocation : allocations)
+				{
+					realm.Dealloc(allocation);
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+void realm_mt_1_thread_mutex()
+{
+	run_realm_threads<sp::memory::MutexThreadPolicy, 1>();
+}
+
+void realm_mt_1_thread_spinlock()
+{
+	run_realm_threads<sp::memory::SpinLockThreadPolicy, 1>();
+}
+
+void realm_mt_1_thread_per_thread()
+{
+	run_realm_threads<sp::memory::PerThreadInstanceThreadPolicy, 1>();
+}
+
+void realm_mt_2_threads_mutex()
+{
+	run_realm_threads<sp::memory::MutexThreadPolicy, 2>();
+}
+
+void realm_mt_2_threads_spinlock()
+{
+	run_realm_threads<sp::memory::SpinLockThreadPolicy, 2>();
+}
+
+void realm_mt_2_threads_per_thread()
+{
+	run_realm_threads<sp::memory::PerThreadInstanceThreadPolicy, 2>();
+}
+
+void realm_mt_4_threads_mutex()
+{
+	run_realm_threads<sp::memory::MutexThreadPolicy, 4>();
+}
+
+void realm_mt_4_threads_spinlock()
+{
+	run_realm_threads<sp::memory::SpinLockThreadPolicy, 4>();
+}
+
+void realm_mt_4_threads_per_thread()
+{
+	run_realm_threads<sp::memory::PerThreadInstanceThreadPolicy, 4>();
+}
+
+void realm_mt_8_threads_mutex()
+{
+	run_realm_threads<sp::memory::MutexThreadPolicy, 8>();
+}
+
+void realm_mt_8_threads_spinlock()
+{
+	run_realm_threads<sp::memory::SpinLockThreadPolicy, 8>();
+}
+
+void realm_mt_8_threads_per_thread()
+{
+	run_realm_threads<sp::memory::PerThreadInstanceThreadPolicy, 8>();
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+void realm_mt_1_thread_mutex();
+void realm_mt_1_thread_spinlock();
+void realm_mt_1_thread_per_thread();
+void realm_mt_2_threads_mutex();
+void realm_mt_2_threads_spinlock();
+void realm_mt_2_threads_per_thread();
+void realm_mt_4_threads_mutex();
+void realm_mt_4_threads_spinlock();
+void realm_mt_4_threads_per_thread();
+void realm_mt_8_threads_mutex();
+void realm_mt_8_threads_spinlock();
+void realm_mt_8_threads_per_thread();
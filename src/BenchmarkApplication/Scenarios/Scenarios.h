@@ -3,12 +3,21 @@
 // Memory Sys
 #include "MemorySystem/RawAllocators_Benchmarks.h"
 #include "MemorySystem/MemoryRealm_Linear_Unsafe.h"
+#include "MemorySystem/StlAllocator_Benchmarks.h"
+#include "MemorySystem/MemoryTagger_Benchmarks.h"
+#include "MemorySystem/ThreadPolicy_Benchmarks.h"
+#include "MemorySystem/BoundsChecker_Benchmarks.h"
+#include "MemorySystem/FrameAllocator_Benchmarks.h"
+#include "MemorySystem/AllocatorLatency_Benchmarks.h"
+#include "MemorySystem/SlabAllocator_Benchmarks.h"
 // Containers
 #include "Containers/Vector_Benchmarks.h"
 #include "Containers/Handlemap_Benchmarks.h"
 #include "Containers/Ringbuffer_Benchmarks.h"
 // ECS
 #include "ECS/ECS_Benchmarks.h"
+// Core
+#include "Core/FreeList_Benchmarks.h"
 
 typedef void(*BenchmarkScenarioFunction)();
 
@@ -44,4 +53,53 @@ const BenchmarkScenarioFunction scenarios[] =
 	&ecs_iterate_100000_pos,							// ID 21
 	&ecs_remove_5000_pos,								// ID 22
 	&ecs_remove_50000_pos,								// ID 23
+	// Core
+	&freelist_mt_100000_mutex,							// ID 24
+	&freelist_mt_100000_lockfree,						// ID 25
+	// Allocator benchmarks
+	&allocate_1000_data_objects_size_class,				// ID 26
+	// STL adapter benchmarks
+	&stl_scratch_100_frames_default,					// ID 27
+	&stl_scratch_100_frames_linear,						// ID 28
+	// Realm benchmark
+	&memory_realm_linear_1000_objects_no_checks,		// ID 29
+	&memory_realm_linear_1000_objects_counting,			// ID 30
+	// Memory tagging benchmarks
+	&memory_tagger_fill_64_mib,							// ID 31
+	&memory_tagger_check_64_mib,						// ID 32
+	// Realm thread scaling benchmarks
+	&realm_mt_1_thread_mutex,							// ID 33
+	&realm_mt_1_thread_spinlock,						// ID 34
+	&realm_mt_1_thread_per_thread,						// ID 35
+	// Bounds checking benchmarks
+	&bounds_checker_validate_all_10000_objects,			// ID 36
+	// Frame allocator benchmarks
+	&frame_messages_100_frames_new,						// ID 37
+	&frame_messages_100_frames_frame_allocator,			// ID 38
+	// Allocator latency benchmarks
+	&allocator_latency_malloc,							// ID 39
+	&allocator_latency_tlsf,							// ID 40
+	&allocator_latency_buddy,							// ID 41
+	&allocator_latency_size_class,						// ID 42
+	// Slab allocator benchmarks
+	&slab_churn_100000_payloads_new,					// ID 43
+	&slab_churn_100000_payloads_slab,					// ID 44
+	&slab_churn_100000_payloads_caching_slab,			// ID 45
+	// Batch allocation benchmarks
+	&allocate_1000_data_objects_linear_batch,			// ID 46
+	&allocate_1000_data_objects_stack_batch,			// ID 47
+	&allocate_1000_data_objects_pool_batch,				// ID 48
+	// Cross-thread free benchmarks
+	&freelist_producer_consumer_1000000_mutex,			// ID 49
+	&freelist_producer_consumer_1000000_remote,			// ID 50
+	// Realm thread scaling benchmarks, continued from ID 33
+	&realm_mt_2_threads_mutex,							// ID 51
+	&realm_mt_2_threads_spinlock,						// ID 52
+	&realm_mt_2_threads_per_thread,						// ID 53
+	&realm_mt_4_threads_mutex,							// ID 54
+	&realm_mt_4_threads_spinlock,						// ID 55
+	&realm_mt_4_threads_per_thread,						// ID 56
+	&realm_mt_8_threads_mutex,							// ID 57
+	&realm_mt_8_threads_spinlock,						// ID 58
+	&realm_mt_8_threads_per_thread,						// ID 59
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <utility>
 
 #include "FreeList/FreeList.h"
+#include "FreeList/ConcurrentFreeList.h"
 #include "Pointers/PointerUtil.h"
 
 namespace
@@ -47,10 +48,13 @@ namespace sp
 		* In the future process of this projects all containers will receive an API to manage
 		* their storage inside a memory block provided by the more low-level MemorySystem
 		* (Specifying an Allocator that provides all memory for neccessary allocations)
+		*
+		* The free list used for the handle slots can be exchanged, e.g. for the lock-free
+		* core::ConcurrentFreeList. The HandleMap itself is still not thread-safe.
 		*/
 		typedef size_t Handle;
 
-		template <typename Item>
+		template <typename Item, typename FreeListType = core::FreeList>
 		class HandleMap
 		{
 		public:
@@ -87,12 +91,12 @@ namespace sp
 			LookupMeta* m_meta;
 			Item* m_items;
 
-			core::FreeList m_freeList;
+			FreeListType m_freeList;
 		};
 
 #pragma region Implementation
-		template <typename Item>
-		HandleMap<Item>::HandleMap(uint32_t maximumCapacity)
+		template <typename Item, typename FreeListType>
+		HandleMap<Item, FreeListType>::HandleMap(uint32_t maximumCapacity)
 			: m_maxItems(maximumCapacity)
 			, m_itemCount(0u)
 			, m_handles(new HandleData[m_maxItems])
@@ -110,12 +114,12 @@ namespace sp
 				assert(pointerDoesNotOverrideData && "FreeList ptr was bigger than sizeof(size_t)");
 			}
 
-			m_freeList.~FreeList();
-			new (&m_freeList) core::FreeList(m_handles, m_handles + m_maxItems, sizeof(HandleData));
+			m_freeList.~FreeListType();
+			new (&m_freeList) FreeListType(m_handles, m_handles + m_maxItems, sizeof(HandleData));
 		}
 
-		template <typename Item>
-		Item& HandleMap<Item>::At(Handle handle)
+		template <typename Item, typename FreeListType>
+		Item& HandleMap<Item, FreeListType>::At(Handle handle)
 		{
 			const InternalId internalId = pointerUtil::pseudo_cast<InternalId>(handle, 0);
 
@@ -134,26 +138,26 @@ namespace sp
 			return m_items[handleData.denseArrayIndex];
 		}
 
-		template <typename Item>
-		const Item& HandleMap<Item>::At(Handle handle) const
+		template <typename Item, typename FreeListType>
+		const Item& HandleMap<Item, FreeListType>::At(Handle handle) const
 		{
 			return At(handle);
 		}
 
-		template <typename Item>
-		Item& HandleMap<Item>::operator[](Handle handle)
+		template <typename Item, typename FreeListType>
+		Item& HandleMap<Item, FreeListType>::operator[](Handle handle)
 		{
 			return At(handle);
 		}
 
-		template <typename Item>
-		const Item& HandleMap<Item>::operator[](Handle handle) const
+		template <typename Item, typename FreeListType>
+		const Item& HandleMap<Item, FreeListType>::operator[](Handle handle) const
 		{
 			return At(handle);
 		}
 
-		template <typename Item>
-		Handle HandleMap<Item>::Insert(Item&& item)
+		template <typename Item, typename FreeListType>
+		Handle HandleMap<Item, FreeListType>::Insert(Item&& item)
 		{
 			{
 				const bool enoughCapacityForInsert = m_itemCount < m_maxItems;
@@ -180,8 +184,8 @@ namespace sp
 			return SIZE_MAX;
 		}
 
-		template <typename Item>
-		Handle HandleMap<Item>::Insert(const Item& item)
+		template <typename Item, typename FreeListType>
+		Handle HandleMap<Item, FreeListType>::Insert(const Item& item)
 		{
 			{
 				const bool enoughCapacityForInsert = m_itemCount < m_maxItems;
@@ -208,8 +212,8 @@ namespace sp
 			return SIZE_MAX;
 		}
 
-		template <typename Item>
-		void HandleMap<Item>::Erase(Handle handle)
+		template <typename Item, typename FreeListType>
+		void HandleMap<Item, FreeListType>::Erase(Handle handle)
 		{
 			const InternalId internalId = pointerUtil::pseudo_cast<InternalId>(handle, 0);
 
@@ -240,8 +244,8 @@ namespace sp
 			m_itemCount = lastMeshIndex;
 		}
 
-		template <typename Item>
-		void HandleMap<Item>::Clear()
+		template <typename Item, typename FreeListType>
+		void HandleMap<Item, FreeListType>::Clear()
 		{
 			for (size_t idx = 0u; idx < m_itemCount; ++idx)
 			{
@@ -249,14 +253,14 @@ namespace sp
 				m_handles[idx].generation += 1u;
 			}
 
-			m_freeList.~FreeList();
-			new (&m_freeList) core::FreeList(m_handles, m_handles + m_maxItems, sizeof(Item));
+			m_freeList.~FreeListType();
+			new (&m_freeList) FreeListType(m_handles, m_handles + m_maxItems, sizeof(Item));
 
 			m_itemCount = 0u;
 		}
 
-		template <typename Item>
-		bool HandleMap<Item>::IsValid(Handle handle) const
+		template <typename Item, typename FreeListType>
+		bool HandleMap<Item, FreeListType>::IsValid(Handle handle) const
 		{
 			const InternalId internalId = pointerUtil::pseudo_cast<InternalId>(handle, 0);
 
@@ -270,8 +274,8 @@ namespace sp
 			return handleData.denseArrayIndex < m_itemCount && handleData.generation == internalId.generation;
 		}
 
-		template <typename Item>
-		HandleMap<Item>::~HandleMap()
+		template <typename Item, typename FreeListType>
+		HandleMap<Item, FreeListType>::~HandleMap()
 		{
 			// Delete all elements we hold
 			for (size_t idx = 0u; idx < m_itemCount; ++idx)
@@ -127,7 +127,7 @@ namespace sp
 			{
 				internalArray[idx].~T();
 			}
-			memory::FreeAddressSpace(m_virtual_mem_begin);
+			memory::FreeAddressSpace(m_virtual_mem_begin, MAX_VECTOR_CAPACITY);
 		}
 
 		template <typename T>
@@ -0,0 +1,152 @@
+#include "ConcurrentFreeList.h"
+
+#include <cassert>
+#include <new>
+
+#include "../Pointers/PointerUtil.h"
+
+namespace
+{
+#if UINTPTR_MAX == UINT32_MAX
+	const uint32_t POINTER_BITS = 32u;
+#else
+	const uint32_t POINTER_BITS = 48u;
+#endif
+	const uint64_t POINTER_MASK = (uint64_t(1) << POINTER_BITS) - 1u;
+
+	uint64_t Pack(void* pointer, uint64_t generation)
+	{
+		const uint64_t pointerBits = sp::pointerUtil::pseudo_cast<uintptr_t>(pointer, 0);
+
+		{
+			const bool pointerFitsIntoTag = (pointerBits & ~POINTER_MASK) == 0u;
+			assert(pointerFitsIntoTag && "Pointer does not fit into the pointer bits of the tagged head");
+		}
+
+		return pointerBits | (generation << POINTER_BITS);
+	}
+
+	template <typename T>
+	T* UnpackPointer(uint64_t taggedPointer)
+	{
+		return sp::pointerUtil::pseudo_cast<T*>(static_cast<uintptr_t>(taggedPointer & POINTER_MASK), 0);
+	}
+
+	uint64_t UnpackGeneration(uint64_t taggedPointer)
+	{
+		return taggedPointer >> POINTER_BITS;
+	}
+}
+
+sp::core::ConcurrentFreeList::ConcurrentFreeList()
+	: m_head(0u)
+{}
+
+sp::core::ConcurrentFreeList::ConcurrentFreeList(void* memoryBegin, void* memoryEnd, size_t chunkSize)
+	: m_head(0u)
+{
+	const ptrdiff_t memoryBlockLength = pointerUtil::pseudo_cast<char*>(memoryEnd, 0) - pointerUtil::pseudo_cast<char*>(memoryBegin, 0);
+	const size_t elementCount = memoryBlockLength / chunkSize;
+
+	// Link the chunks front to back like the FreeList does, so both hand them out in the same order
+	char* memory = pointerUtil::pseudo_cast<char*>(memoryBegin, 0);
+	Node* first = new (memory) Node;
+	memory += chunkSize;
+
+	Node* current = first;
+	for (size_t i = 0; i < elementCount - 1; ++i)
+	{
+		Node* next = new (memory) Node;
+		current->next.store(next, std::memory_order_relaxed);
+		current = next;
+		memory += chunkSize;
+	}
+	current->next.store(nullptr, std::memory_order_relaxed);
+
+	m_head.store(Pack(first, 0u), std::memory_order_release);
+}
+
+void* sp::core::ConcurrentFreeList::GetChunk(void)
+{
+	uint64_t head = m_head.load(std::memory_order_acquire);
+	for (;;)
+	{
+		Node* chunk = UnpackPointer<Node>(head);
+		if (!chunk)
+		{
+			return nullptr;
+		}
+
+		// The chunk might already be handed out by another thread at this point. Then the
+		// value read is garbage, but the generation changed as well and the swap below fails.
+		Node* next = chunk->next.load(std::memory_order_relaxed);
+		const uint64_t newHead = Pack(next, UnpackGeneration(head) + 1u);
+		if (m_head.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+		{
+			return chunk;
+		}
+	}
+}
+
+void sp::core::ConcurrentFreeList::ReturnChunk(void* chunk)
+{
+	{
+		const bool isNotNullptr = chunk != nullptr;
+		assert(isNotNullptr && "Cannot return a nullptr into the FreeList");
+	}
+
+	Node* newChunk = new (chunk) Node;
+	uint64_t head = m_head.load(std::memory_order_relaxed);
+	uint64_t newHead = 0u;
+	do
+	{
+		newChunk->next.store(UnpackPointer<Node>(head), std::memory_order_relaxed);
+		newHead = Pack(newChunk, UnpackGeneration(head) + 1u);
+	} while (!m_head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+size_t sp::core::ConcurrentFreeList::GetChunks(void** chunks, size_t count)
+{
+	size_t chunkCount = 0u;
+	while (chunkCount < count)
+	{
+		void* chunk = GetChunk();
+		if (!chunk)
+		{
+			break;
+		}
+		chunks[chunkCount++] = chunk;
+	}
+
+	return chunkCount;
+}
+
+void sp::core::ConcurrentFreeList::ReturnChunks(void* const* chunks, size_t count)
+{
+	if (count == 0u)
+	{
+		return;
+	}
+
+	Node* first = new (chunks[0]) Node;
+	Node* last = first;
+	for (size_t idx = 1u; idx < count; ++idx)
+	{
+		Node* next = new (chunks[idx]) Node;
+		last->next.store(next, std::memory_order_relaxed);
+		last = next;
+	}
+
+	uint64_t head = m_head.load(std::memory_order_relaxed);
+	uint64_t newHead = 0u;
+	do
+	{
+		last->next.store(UnpackPointer<Node>(head), std::memory_order_relaxed);
+		newHead = Pack(first, UnpackGeneration(head) + 1u);
+	} while (!m_head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool sp::core::ConcurrentFreeList::IsEmpty(void) const
+{
+	return UnpackPointer<Node>(m_head.load(std::memory_order_acquire)) == nullptr;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace sp
+{
+	namespace core
+	{
+		/**
+		 * The ConcurrentFreeList is a lock-free variant of the intrusive FreeList
+		 * with the same API. Many threads can get and return chunks concurrently.
+		 *
+		 * The head of the list is a tagged pointer: every successful update of the
+		 * head increments a generation counter stored next to the pointer in the
+		 * same atomic word. A thread that was preempted between reading the head
+		 * and swapping it fails its compare-and-swap even if the same chunk made
+		 * it back to the top of the list in the meantime (ABA problem).
+		 * On 64-bit targets the pointer uses the lower 48 bits and the generation
+		 * the upper 16 bits, on 32-bit targets each half of a 64-bit word.
+		 *
+		 * Like the FreeList every chunk has to be at least as big as a pointer.
+		 * Constructing a list over a memory range is not thread-safe.
+		 */
+		class ConcurrentFreeList
+		{
+		public:
+			ConcurrentFreeList();
+			ConcurrentFreeList(void* memoryBegin, void* memoryEnd, size_t chunkSize);
+
+			void* GetChunk(void);
+			void ReturnChunk(void* chunk);
+
+			/// Pops the chunks one by one, following a chain of chunks other threads might pop is not safe
+			size_t GetChunks(void** chunks, size_t count);
+			/// Links the chunks up privately and publishes them with a single swap
+			void ReturnChunks(void* const* chunks, size_t count);
+
+			bool IsEmpty(void) const;
+
+		private:
+			struct Node
+			{
+				std::atomic<Node*> next;
+			};
+
+			std::atomic<uint64_t> m_head;
+		};
+	}
+}
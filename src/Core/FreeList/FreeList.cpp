@@ -47,4 +47,34 @@ void sp::core::FreeList::ReturnChunk(void* chunk)
 	FreeList* newChunk = pointerUtil::pseudo_cast<FreeList*>(chunk, 0);
 	newChunk->m_nextChunk = m_nextChunk;
 	m_nextChunk = newChunk;
-}
\ No newline at end of file
+}
+
+size_t sp::core::FreeList::GetChunks(void** chunks, size_t count)
+{
+	size_t chunkCount = 0u;
+	FreeList* chunk = m_nextChunk;
+	while (chunkCount < count && chunk)
+	{
+		chunks[chunkCount++] = chunk;
+		chunk = chunk->m_nextChunk;
+	}
+
+	m_nextChunk = chunk;
+	return chunkCount;
+}
+
+void sp::core::FreeList::ReturnChunks(void* const* chunks, size_t count)
+{
+	if (count == 0u)
+	{
+		return;
+	}
+
+	for (size_t idx = 0u; idx + 1u < count; ++idx)
+	{
+		pointerUtil::pseudo_cast<FreeList*>(chunks[idx], 0)->m_nextChunk = pointerUtil::pseudo_cast<FreeList*>(chunks[idx + 1u], 0);
+	}
+
+	pointerUtil::pseudo_cast<FreeList*>(chunks[count - 1u], 0)->m_nextChunk = m_nextChunk;
+	m_nextChunk = pointerUtil::pseudo_cast<FreeList*>(chunks[0], 0);
+}
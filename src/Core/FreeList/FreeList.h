@@ -20,6 +20,11 @@ namespace sp
 			void* GetChunk(void);
 			void ReturnChunk(void* chunk);
 
+			/// Unlinks up to count chunks at once and returns how many there were
+			size_t GetChunks(void** chunks, size_t count);
+			/// Links the chunks up and puts them in front of the list in one go
+			void ReturnChunks(void* const* chunks, size_t count);
+
 			bool IsEmpty(void) const { return m_nextChunk == nullptr; }
 		private:
 			FreeList* m_nextChunk;
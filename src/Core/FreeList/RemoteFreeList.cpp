@@ -0,0 +1,146 @@
+#include "RemoteFreeList.h"
+
+#include <cassert>
+
+#include "../Pointers/PointerUtil.h"
+
+sp::core::RemoteFreeList::RemoteFreeList()
+	: m_localChunks(nullptr)
+	, m_ownerThread(std::this_thread::get_id())
+	, m_remoteChunks(nullptr)
+{}
+
+sp::core::RemoteFreeList::RemoteFreeList(void* memoryBegin, void* memoryEnd, size_t chunkSize)
+	: m_localChunks(nullptr)
+	, m_ownerThread(std::this_thread::get_id())
+	, m_remoteChunks(nullptr)
+{
+	const ptrdiff_t memoryBlockLength = pointerUtil::pseudo_cast<char*>(memoryEnd, 0) - pointerUtil::pseudo_cast<char*>(memoryBegin, 0);
+	const size_t elementCount = memoryBlockLength / chunkSize;
+
+	// Link the chunks front to back like the FreeList does, so both hand them out in the same order
+	char* memory = pointerUtil::pseudo_cast<char*>(memoryBegin, 0);
+	m_localChunks = pointerUtil::pseudo_cast<Node*>(memory, 0);
+	memory += chunkSize;
+
+	Node* current = m_localChunks;
+	for (size_t i = 0; i < elementCount - 1; ++i)
+	{
+		current->next = pointerUtil::pseudo_cast<Node*>(memory, 0);
+		current = current->next;
+		memory += chunkSize;
+	}
+	current->next = nullptr;
+}
+
+void* sp::core::RemoteFreeList::GetChunk(void)
+{
+	assert(IsOwnerThread() && "Only the owning thread may take chunks out of a RemoteFreeList");
+
+	if (!m_localChunks && !DrainRemoteChunks())
+	{
+		return nullptr;
+	}
+
+	Node* chunk = m_localChunks;
+	m_localChunks = chunk->next;
+	return chunk;
+}
+
+void sp::core::RemoteFreeList::ReturnChunk(void* chunk)
+{
+	{
+		const bool isNotNullptr = chunk != nullptr;
+		assert(isNotNullptr && "Cannot return a nullptr into the RemoteFreeList");
+	}
+
+	Node* node = pointerUtil::pseudo_cast<Node*>(chunk, 0);
+	if (IsOwnerThread())
+	{
+		node->next = m_localChunks;
+		m_localChunks = node;
+	}
+	else
+	{
+		PushRemote(node, node);
+	}
+}
+
+size_t sp::core::RemoteFreeList::GetChunks(void** chunks, size_t count)
+{
+	assert(IsOwnerThread() && "Only the owning thread may take chunks out of a RemoteFreeList");
+
+	size_t chunkCount = 0u;
+	while (chunkCount < count)
+	{
+		if (!m_localChunks && !DrainRemoteChunks())
+		{
+			break;
+		}
+
+		Node* chunk = m_localChunks;
+		while (chunkCount < count && chunk)
+		{
+			chunks[chunkCount++] = chunk;
+			chunk = chunk->next;
+		}
+		m_localChunks = chunk;
+	}
+
+	return chunkCount;
+}
+
+void sp::core::RemoteFreeList::ReturnChunks(void* const* chunks, size_t count)
+{
+	if (count == 0u)
+	{
+		return;
+	}
+
+	for (size_t idx = 0u; idx + 1u < count; ++idx)
+	{
+		pointerUtil::pseudo_cast<Node*>(chunks[idx], 0)->next = pointerUtil::pseudo_cast<Node*>(chunks[idx + 1u], 0);
+	}
+
+	Node* first = pointerUtil::pseudo_cast<Node*>(chunks[0], 0);
+	Node* last = pointerUtil::pseudo_cast<Node*>(chunks[count - 1u], 0);
+	if (IsOwnerThread())
+	{
+		last->next = m_localChunks;
+		m_localChunks = first;
+	}
+	else
+	{
+		PushRemote(first, last);
+	}
+}
+
+bool sp::core::RemoteFreeList::IsEmpty(void) const
+{
+	return m_localChunks == nullptr && m_remoteChunks.load(std::memory_order_acquire) == nullptr;
+}
+
+///
+/// Pushes an already linked chain of chunks. The owner only ever takes the whole list,
+/// a chunk can therefore not be popped and pushed again while this thread retries.
+///
+void sp::core::RemoteFreeList::PushRemote(Node* first, Node* last)
+{
+	Node* head = m_remoteChunks.load(std::memory_order_relaxed);
+	do
+	{
+		last->next = head;
+	} while (!m_remoteChunks.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool sp::core::RemoteFreeList::DrainRemoteChunks(void)
+{
+	// Cheap check first, the exchange would take the cache line from the remote threads for nothing
+	if (m_remoteChunks.load(std::memory_order_relaxed) == nullptr)
+	{
+		return false;
+	}
+
+	m_localChunks = m_remoteChunks.exchange(nullptr, std::memory_order_acquire);
+	return m_localChunks != nullptr;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace sp
+{
+	namespace core
+	{
+		/**
+		 * The RemoteFreeList is an intrusive free list with a single owning thread, as
+		 * used for the per-page free lists of mimalloc and snmalloc. It has the same API
+		 * as the FreeList and can be plugged into the pool allocators in its place.
+		 *
+		 * Only the owner takes chunks out of the list and it returns chunks without any
+		 * atomic operation, just like with the FreeList. Any other thread may return
+		 * chunks as well, those are pushed onto a separate lock-free remote list with a
+		 * single compare-and-swap. Once the owner's list runs empty, it takes over the
+		 * whole remote list with one atomic exchange instead of popping chunk by chunk.
+		 * There is only one consumer, so unlike the ConcurrentFreeList no ABA protection
+		 * is required.
+		 *
+		 * The thread constructing the list owns it, SetOwnerThread() hands it over to
+		 * the calling thread. Like the FreeList every chunk has to be at least as big
+		 * as a pointer.
+		 */
+		class RemoteFreeList
+		{
+		public:
+			RemoteFreeList();
+			RemoteFreeList(void* memoryBegin, void* memoryEnd, size_t chunkSize);
+
+			/// Owner thread only, drains the remote chunks once the own ones are used up
+			void* GetChunk(void);
+			void ReturnChunk(void* chunk);
+
+			/// Owner thread only, unlinks up to count chunks and returns how many there were
+			size_t GetChunks(void** chunks, size_t count);
+			/// Links the chunks up and puts them in front of the owner's or the remote list in one go
+			void ReturnChunks(void* const* chunks, size_t count);
+
+			bool IsEmpty(void) const;
+
+			void SetOwnerThread(void) { m_ownerThread = std::this_thread::get_id(); }
+			bool IsOwnerThread(void) const { return std::this_thread::get_id() == m_ownerThread; }
+
+		private:
+			struct Node
+			{
+				Node* next;
+			};
+
+			void PushRemote(Node* first, Node* last);
+			bool DrainRemoteChunks(void);
+
+			Node* m_localChunks;
+			std::thread::id m_ownerThread;
+
+			// Written by every remote thread, kept apart from the owner's data to avoid false sharing
+			alignas(64) std::atomic<Node*> m_remoteChunks;
+		};
+	}
+}
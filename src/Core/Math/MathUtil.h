@@ -1,12 +1,76 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace sp
 {
 	namespace math
 	{
 		size_t RoundUp(size_t number, size_t multiple);
 		size_t RoundDown(size_t number, size_t multiple);
+
+		/*
+		 * Index of the highest set bit (floor(log2(number))), number must not be 0.
+		 * Inline, maps to a single bit-scan / count-leading-zeros instruction.
+		 */
+		uint32_t FloorLog2(size_t number);
+
+		/*
+		 * Index of the lowest set bit (number of trailing zeros), number must not be 0.
+		 * Inline, maps to a single bit-scan / count-trailing-zeros instruction.
+		 */
+		uint32_t CountTrailingZeros(uint64_t number);
+
+#pragma region Implementation
+
+		inline uint32_t FloorLog2(size_t number)
+		{
+			assert(number != 0 && "Logarithm of 0 is undefined");
+
+#if defined(_MSC_VER)
+			unsigned long index = 0;
+#if defined(_WIN64)
+			_BitScanReverse64(&index, number);
+#else
+			_BitScanReverse(&index, number);
+#endif
+			return static_cast<uint32_t>(index);
+#else
+			if (sizeof(size_t) == sizeof(unsigned long long))
+			{
+				return static_cast<uint32_t>(63 - __builtin_clzll(static_cast<unsigned long long>(number)));
+			}
+			return static_cast<uint32_t>(31 - __builtin_clz(static_cast<unsigned int>(number)));
+#endif
+		}
+
+		inline uint32_t CountTrailingZeros(uint64_t number)
+		{
+			assert(number != 0 && "Trailing zeros of 0 are undefined");
+
+#if defined(_MSC_VER)
+			unsigned long index = 0;
+#if defined(_WIN64)
+			_BitScanForward64(&index, number);
+#else
+			if (!_BitScanForward(&index, static_cast<unsigned long>(number)))
+			{
+				_BitScanForward(&index, static_cast<unsigned long>(number >> 32));
+				index += 32;
+			}
+#endif
+			return static_cast<uint32_t>(index);
+#else
+			return static_cast<uint32_t>(__builtin_ctzll(static_cast<unsigned long long>(number)));
+#endif
+		}
+
+#pragma endregion
 	}
-}
\ No newline at end of file
+}
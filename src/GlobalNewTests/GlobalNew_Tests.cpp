@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Allocator/Growing/SizeClassAllocator.h"
+#include "BoundsChecker/SimpleBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "GlobalNew/GlobalNewOverride.h"
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	typedef sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::SimpleBoundsChecker> SizeClassRealm;
+
+	///
+	/// Forwards to a size class realm and counts the requests it served
+	///
+	class CountingRealm : public MemoryRealmBase
+	{
+	public:
+		CountingRealm()
+			: m_realm(1024 * 1024)
+			, allocations(0)
+			, deallocations(0)
+		{}
+
+		void* Alloc(size_t bytes, size_t alignment) override
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++allocations;
+			return m_realm.Alloc(bytes, alignment);
+		}
+
+		void Dealloc(void* memory) override
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++deallocations;
+			m_realm.Dealloc(memory);
+		}
+
+		void Reset(void) override
+		{
+			m_realm.Reset();
+		}
+
+	private:
+		std::mutex m_mutex;
+		SizeClassRealm m_realm;
+
+	public:
+		size_t allocations;
+		size_t deallocations;
+	};
+
+	struct alignas(64) OverAlignedObject
+	{
+		uint32_t foo[4];
+	};
+}
+
+TEST(GlobalNew, Falls_Back_To_Malloc_Without_Realm)
+{
+	ASSERT_EQ(sp::memory::GetGlobalRealm(), nullptr) << "No realm should be active by default";
+
+	uint32_t* value = new uint32_t(42);
+	ASSERT_NE(value, nullptr) << "operator new did not return a valid pointer";
+	ASSERT_EQ(*value, 42u);
+	delete value;
+}
+
+TEST(GlobalNew, Scoped_Realm_Serves_New_And_Delete)
+{
+	CountingRealm realm;
+	uint32_t* value = nullptr;
+	{
+		sp::memory::ScopedGlobalRealm scope(realm);
+		value = new uint32_t(42);
+	}
+
+	ASSERT_EQ(realm.allocations, 1u) << "Allocation did not go through the scoped realm";
+
+	// Deleting after the scope ended still returns the memory to its realm
+	delete value;
+	ASSERT_EQ(realm.deallocations, 1u) << "Deallocation did not go back to the owning realm";
+}
+
+TEST(GlobalNew, Scopes_Can_Be_Nested)
+{
+	CountingRealm outerRealm;
+	CountingRealm innerRealm;
+	MemoryRealmBase* activeInInnerScope = nullptr;
+	MemoryRealmBase* activeAfterInnerScope = nullptr;
+	{
+		sp::memory::ScopedGlobalRealm outerScope(outerRealm);
+		{
+			sp::memory::ScopedGlobalRealm innerScope(innerRealm);
+			activeInInnerScope = sp::memory::GetGlobalRealm();
+		}
+		activeAfterInnerScope = sp::memory::GetGlobalRealm();
+	}
+
+	ASSERT_EQ(activeInInnerScope, &innerRealm) << "Inner scope did not override the outer one";
+	ASSERT_EQ(activeAfterInnerScope, &outerRealm) << "Outer realm was not restored";
+	ASSERT_EQ(sp::memory::GetGlobalRealm(), nullptr) << "Realm was not reset after the outermost scope";
+}
+
+TEST(GlobalNew, Aligned_New_Is_Routed_And_Aligned)
+{
+	CountingRealm realm;
+	OverAlignedObject* objects = nullptr;
+	{
+		sp::memory::ScopedGlobalRealm scope(realm);
+		objects = new OverAlignedObject[10];
+	}
+
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(objects, alignof(OverAlignedObject))) << "Pointer was not aligned to a 64";
+	ASSERT_EQ(realm.allocations, 1u) << "Aligned allocation did not go through the scoped realm";
+	delete[] objects;
+	ASSERT_EQ(realm.deallocations, 1u) << "Aligned deallocation did not go back to the owning realm";
+}
+
+TEST(GlobalNew, Std_Containers_Use_The_Realm)
+{
+	CountingRealm realm;
+	{
+		sp::memory::ScopedGlobalRealm scope(realm);
+		std::vector<uint32_t> values;
+		for (uint32_t i = 0; i < 1000; ++i)
+		{
+			values.push_back(i);
+		}
+	}
+
+	ASSERT_GT(realm.allocations, 0u) << "Vector did not allocate from the scoped realm";
+	ASSERT_EQ(realm.allocations, realm.deallocations) << "Vector leaked memory in the realm";
+}
+
+TEST(GlobalNew, Global_Realm_Is_Used_By_All_Threads)
+{
+	CountingRealm realm;
+	uint32_t* value = nullptr;
+
+	sp::memory::SetGlobalRealm(&realm);
+	std::thread worker([&value]()
+	{
+		value = new uint32_t(42);
+	});
+	worker.join();
+	sp::memory::SetGlobalRealm(nullptr);
+
+	ASSERT_GE(realm.allocations, 1u) << "Allocation on another thread did not go through the global realm";
+	delete value;
+}
@@ -0,0 +1,8 @@
+#include "gtest/gtest.h"
+
+// Built as its own executable, GlobalNew_Tests.cpp replaces the global operator new/delete
+// and would otherwise route every other test and gtest itself through the override
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 /*
  * The AllocatorBase interface is used to share an allocator
  * between multiple users and to define the minimal API an
@@ -17,10 +19,39 @@ namespace sp
 		class AllocatorBase
 		{
 		public:
+			/// False for allocators whose GetAllocationSize() may return more than was requested
+			static constexpr bool HAS_EXACT_ALLOCATION_SIZE = true;
+
 			virtual void* Alloc(size_t size, size_t alignment, size_t offset) = 0;
 			virtual void Dealloc(void* memory) = 0;
 			virtual void Reset() = 0;
 			virtual size_t GetAllocationSize(void* memory) = 0;
+
+			/**
+			 * Allocates count blocks of the same size and alignment into memory[] and
+			 * returns how many were allocated, fewer than count only once the allocator
+			 * is exhausted. The default falls back to single Alloc() calls, allocators
+			 * that can serve a whole batch at once override it.
+			 */
+			virtual size_t AllocN(size_t count, size_t size, size_t alignment, size_t offset, void** memory)
+			{
+				size_t allocationCount = 0u;
+				while (allocationCount < count && (memory[allocationCount] = Alloc(size, alignment, offset)) != nullptr)
+				{
+					++allocationCount;
+				}
+				return allocationCount;
+			}
+
+			/// Frees count blocks, the same ordering rules as for Dealloc() apply
+			virtual void DeallocN(void* const* memory, size_t count)
+			{
+				for (size_t idx = 0u; idx < count; ++idx)
+				{
+					Dealloc(memory[idx]);
+				}
+			}
+
 			virtual ~AllocatorBase() = default;
 		};
 	}
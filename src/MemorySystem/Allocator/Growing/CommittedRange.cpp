@@ -0,0 +1,66 @@
+#include "CommittedRange.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Math/MathUtil.h"
+#include "Pointers/PointerUtil.h"
+#include "../../VirtualMemory/VirtualMemory.h"
+
+sp::memory::CommittedRange::CommittedRange(size_t maxSize, size_t growSize, PageOwner owner)
+	: m_virtualMemoryBegin(nullptr)
+	, m_virtualMemoryEnd(nullptr)
+	, m_physicalMemoryEnd(nullptr)
+	, m_growSize(math::RoundUp(growSize, GetPageSize()))
+{
+	{
+		const bool isValidSize = maxSize != 0 && growSize != 0;
+		assert(isValidSize && "Cannot intialize an allocator with size 0");
+	}
+
+	const size_t reservationSize = math::RoundUp(maxSize, GetPageSize());
+	m_virtualMemoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(reservationSize, owner), 0);
+	m_virtualMemoryEnd = m_virtualMemoryBegin + reservationSize;
+
+	const size_t initialCommitSize = std::min(m_growSize, reservationSize);
+	CommitPhysicalMemory(m_virtualMemoryBegin, initialCommitSize);
+	m_physicalMemoryEnd = m_virtualMemoryBegin + initialCommitSize;
+}
+
+///
+/// Fails without committing anything if the reserved range is too small
+///
+bool sp::memory::CommittedRange::Grow(char* requiredEnd)
+{
+	if (requiredEnd > m_virtualMemoryEnd)
+	{
+		return false;
+	}
+
+	const size_t missingSize = requiredEnd - m_physicalMemoryEnd;
+	const size_t growSize = std::min(math::RoundUp(missingSize, m_growSize), static_cast<size_t>(m_virtualMemoryEnd - m_physicalMemoryEnd));
+
+	if (!CommitPhysicalMemory(m_physicalMemoryEnd, growSize))
+	{
+		return false;
+	}
+
+	m_physicalMemoryEnd += growSize;
+	return true;
+}
+
+void sp::memory::CommittedRange::DecommitFrom(char* keptEnd)
+{
+	{
+		const bool isInCommittedRange = keptEnd >= m_virtualMemoryBegin && keptEnd <= m_physicalMemoryEnd;
+		assert(isInCommittedRange && "Can only decommit pages that are committed");
+	}
+
+	DecommitPhysicalMemory(keptEnd, m_physicalMemoryEnd - keptEnd);
+	m_physicalMemoryEnd = keptEnd;
+}
+
+sp::memory::CommittedRange::~CommittedRange()
+{
+	FreeAddressSpace(m_virtualMemoryBegin, m_virtualMemoryEnd - m_virtualMemoryBegin);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../../PageMap/PageMap.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * A reserved range of address space whose front is committed on demand, shared
+		 * by the growing allocators that hand out memory from the bottom up. It reserves
+		 * maxSize bytes, commits the first growSize bytes and then grows in whole steps
+		 * of growSize bytes, both rounded up to pages. The range is released on
+		 * destruction.
+		 */
+		class CommittedRange
+		{
+		public:
+			CommittedRange(size_t maxSize, size_t growSize, PageOwner owner);
+
+			CommittedRange(const CommittedRange& other) = delete;
+			CommittedRange(const CommittedRange&& other) = delete;
+			CommittedRange operator=(const CommittedRange& other) = delete;
+			CommittedRange operator=(const CommittedRange&& other) = delete;
+
+			/// Commits whole grow steps until requiredEnd is backed by physical memory
+			bool Grow(char* requiredEnd);
+			/// Hands all committed pages from keptEnd on back to the OS
+			void DecommitFrom(char* keptEnd);
+
+			char* GetBegin(void) const { return m_virtualMemoryBegin; }
+			/// End of the part backed by physical memory
+			char* GetCommittedEnd(void) const { return m_physicalMemoryEnd; }
+			size_t GetCommittedSize(void) const { return m_physicalMemoryEnd - m_virtualMemoryBegin; }
+			size_t GetGrowSize(void) const { return m_growSize; }
+
+			~CommittedRange();
+
+		private:
+			char* m_virtualMemoryBegin;
+			char* m_virtualMemoryEnd;
+			char* m_physicalMemoryEnd;
+
+			const size_t m_growSize;
+		};
+	}
+}
@@ -0,0 +1,62 @@
+#include "GrowingLinearAllocator.h"
+
+#include <algorithm>
+
+#include "Math/MathUtil.h"
+
+const size_t sp::memory::GrowingLinearAllocator::DEFAULT_GROW_SIZE;
+
+///
+/// Reserves maxSize bytes of address space and commits the first growSize
+/// bytes, both rounded up to whole pages
+///
+sp::memory::GrowingLinearAllocator::GrowingLinearAllocator(size_t maxSize, size_t growSize, size_t resetHistoryLength)
+	: m_memory(maxSize, growSize, this)
+	, m_currentPtr(m_memory.GetBegin())
+	, m_resetHistory(resetHistoryLength, 0u)
+	, m_resetHistoryIndex(0u)
+{
+}
+
+void sp::memory::GrowingLinearAllocator::Reset()
+{
+	const size_t usedSize = GetUsedSize();
+	m_currentPtr = m_memory.GetBegin();
+
+	if (!m_resetHistory.empty())
+	{
+		DecommitAboveHighWaterMark(usedSize);
+	}
+}
+
+size_t sp::memory::GrowingLinearAllocator::GetCommittedSize(void) const
+{
+	return m_memory.GetCommittedSize();
+}
+
+size_t sp::memory::GrowingLinearAllocator::GetUsedSize(void) const
+{
+	return m_currentPtr - m_memory.GetBegin();
+}
+
+sp::memory::GrowingLinearAllocator::~GrowingLinearAllocator()
+{
+}
+
+///
+/// Keeps enough pages for the largest usage of the last cycles (but at least
+/// one grow step), everything above it is handed back to the OS
+///
+void sp::memory::GrowingLinearAllocator::DecommitAboveHighWaterMark(size_t usedSize)
+{
+	m_resetHistory[m_resetHistoryIndex] = usedSize;
+	m_resetHistoryIndex = (m_resetHistoryIndex + 1u) % m_resetHistory.size();
+
+	const size_t highWaterMark = *std::max_element(m_resetHistory.begin(), m_resetHistory.end());
+	const size_t keptSize = math::RoundUp(std::max(highWaterMark, size_t(1)), m_memory.GetGrowSize());
+
+	if (keptSize < GetCommittedSize())
+	{
+		m_memory.DecommitFrom(m_memory.GetBegin() + keptSize);
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "CommittedRange.h"
+#include "../AllocatorBase.h"
+#include "Pointers/PointerUtil.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * A growing linear allocator. Like the LinearAllocator it only performs a
+		 * pointer bump per allocation and can only be reset as a whole, but instead
+		 * of committing its whole range up front it reserves maxSize bytes of address
+		 * space and commits physical memory on demand in steps of growSize bytes.
+		 *
+		 * With a resetHistoryLength of N, Reset() decommits all pages above the
+		 * high-water mark of the last N reset cycles (e.g. frames), so the resident
+		 * memory follows the real load instead of staying at the worst case ever
+		 * seen. A history length of 0 keeps all committed pages.
+		 */
+		class GrowingLinearAllocator final : public AllocatorBase
+		{
+		public:
+			static const size_t DEFAULT_GROW_SIZE = 64 * 1024;
+
+			explicit GrowingLinearAllocator(size_t maxSize, size_t growSize = DEFAULT_GROW_SIZE, size_t resetHistoryLength = 0);
+
+			GrowingLinearAllocator(const GrowingLinearAllocator& other) = delete;
+			GrowingLinearAllocator(const GrowingLinearAllocator&& other) = delete;
+			GrowingLinearAllocator operator=(const GrowingLinearAllocator& other) = delete;
+			GrowingLinearAllocator operator=(const GrowingLinearAllocator&& other) = delete;
+
+			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
+			virtual void  Dealloc(void* memory) override;
+			virtual void  Reset() override;
+			virtual size_t GetAllocationSize(void* memory) override;
+
+			/// Bytes currently backed by physical memory
+			size_t GetCommittedSize(void) const;
+			/// Bytes handed out (including headers and padding) since the last Reset()
+			size_t GetUsedSize(void) const;
+
+			virtual ~GrowingLinearAllocator() override;
+
+		private:
+			struct AllocationHeader
+			{
+				uint32_t allocationSize;
+			};
+
+			static const uint32_t ALLOCATION_META_SIZE = sizeof(AllocationHeader);
+
+			void DecommitAboveHighWaterMark(size_t usedSize);
+
+			CommittedRange m_memory;
+			char* m_currentPtr;
+
+			std::vector<size_t> m_resetHistory;
+			size_t m_resetHistoryIndex;
+		};
+
+#pragma region Implementation
+
+		///
+		/// Same pointer bump as the LinearAllocator, only the rare case of running out
+		/// of committed memory leaves the inline path to commit the next pages
+		///
+		inline void* GrowingLinearAllocator::Alloc(size_t size, size_t alignment, size_t offset)
+		{
+			assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+			char* allocation = m_currentPtr + offset + ALLOCATION_META_SIZE;
+			allocation = static_cast<char*>(pointerUtil::AlignTop(allocation, alignment));
+			allocation -= offset + ALLOCATION_META_SIZE;
+
+			char* allocationEnd = allocation + ALLOCATION_META_SIZE + size;
+			if (allocationEnd > m_memory.GetCommittedEnd() && !m_memory.Grow(allocationEnd))
+			{
+				return nullptr;
+			}
+
+			union
+			{
+				void* as_void;
+				char* as_char;
+				AllocationHeader* as_header;
+			};
+
+			as_char = allocation;
+			as_header->allocationSize = static_cast<uint32_t>(size);
+			as_char += ALLOCATION_META_SIZE;
+
+			m_currentPtr = allocationEnd;
+
+			return as_void;
+		}
+
+		///
+		/// The allocator does not support freeing single allocations
+		///
+		inline void GrowingLinearAllocator::Dealloc(void* memory) {}
+
+		inline size_t GrowingLinearAllocator::GetAllocationSize(void* memory)
+		{
+			{
+				const bool isNotNull = memory != nullptr;
+				assert(isNotNull && "Cannot return allocation size of a nullptr");
+			}
+
+			char* userPointer = static_cast<char*>(memory);
+			return pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationSize;
+		}
+
+#pragma endregion
+	}
+}
@@ -32,10 +32,11 @@ namespace
 		uint32_t allocationSize;
 	};
 
-	static const uint32_t ALLOCATION_META_SIZE = sizeof(AllocationHeader);
+	static_assert(sizeof(AllocationHeader) == sizeof(uint32_t), "The pool declares its meta size without seeing the header");
 }
 
-sp::memory::GrowingPoolAllocator::GrowingPoolAllocator(size_t elementMaxSize, size_t elementCount,
+template <typename FreeListType, bool HEADER_FREE>
+sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::BasicGrowingPoolAllocator(size_t elementMaxSize, size_t elementCount,
 	size_t elementCountMax, size_t elementMaxAlignment, size_t offset)
 	: m_virtualMemoryBegin(nullptr)
 	, m_virtualMemoryEnd(nullptr)
@@ -46,6 +47,12 @@ sp::memory::GrowingPoolAllocator::GrowingPoolAllocator(size_t elementMaxSize, si
 	, m_maxElementAlignment(elementMaxAlignment)
 	, m_minimalChunkSize(CalculateMinimalChunkSize(m_maxElementSize + ALLOCATION_META_SIZE, m_maxElementAlignment))
 	, m_growSize(sp::math::RoundUp((m_minimalChunkSize * elementCount) + m_maxElementAlignment, sp::memory::GetPageSize()))
+	, m_untouchedChunk(nullptr)
+	, m_untouchedEnd(nullptr)
+	, m_nextBlockIndex(1u)
+	, m_committedSize(0u)
+	, m_autoTrimThreshold(0u)
+	, m_emptiedBlockCount(0u)
 {
 	{
 		const bool elementGreaterOrEqualPointerSize = elementMaxSize >= sizeof(uintptr_t);
@@ -57,20 +64,35 @@ sp::memory::GrowingPoolAllocator::GrowingPoolAllocator(size_t elementMaxSize, si
 	const size_t maximumMemorySize = (elementCountMax * m_minimalChunkSize) + m_maxElementAlignment;
 	const size_t maximumMemorySizeRounded = sp::math::RoundUp(maximumMemorySize, sp::memory::GetPageSize());
 
-	m_virtualMemoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(maximumMemorySizeRounded), 0);
+	m_virtualMemoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(maximumMemorySizeRounded, this), 0);
 	m_virtualMemoryEnd = m_virtualMemoryBegin + maximumMemorySizeRounded;
 
 	m_physicalMemoryBegin = pointerUtil::pseudo_cast<char*>(CommitPhysicalMemory(m_virtualMemoryBegin, m_growSize), 0);
 	m_physicalMemoryEnd = m_physicalMemoryBegin + m_growSize;
+	m_committedSize = m_growSize;
+
+	// One occupancy counter per block that fits into the reservation, all start out empty
+	const size_t blockCount = (maximumMemorySizeRounded + m_growSize - 1u) / m_growSize;
+	std::vector<OccupancyCounter>(blockCount).swap(m_blockOccupancy);
+	m_decommittedBlocks.reserve(blockCount);
 
 	const size_t offsetBeforeAlignment = offset + ALLOCATION_META_SIZE;
 	// Offset the first chunk and align it to ensure all following slots are also aligned
 	m_firstChunkPtr = pointerUtil::AlignTop(m_physicalMemoryBegin + offsetBeforeAlignment, m_maxElementAlignment) - offsetBeforeAlignment;
-	m_freeList.~FreeList();
-	new (&m_freeList) core::FreeList(m_firstChunkPtr, m_physicalMemoryEnd, m_minimalChunkSize);
+	if constexpr (LAZY_INITIALIZATION)
+	{
+		m_untouchedChunk = m_firstChunkPtr;
+		m_untouchedEnd = m_physicalMemoryEnd;
+	}
+	else
+	{
+		m_freeList.~FreeListType();
+		new (&m_freeList) FreeListType(m_firstChunkPtr, m_physicalMemoryEnd, m_minimalChunkSize);
+	}
 }
 
-void* sp::memory::GrowingPoolAllocator::Alloc(size_t size, size_t alignment, size_t offset)
+template <typename FreeListType, bool HEADER_FREE>
+void* sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::Alloc(size_t size, size_t alignment, size_t offset)
 {
 	{
 		const bool sizeLesserOrEqualMaxElementSize = size <= m_maxElementSize;
@@ -79,22 +101,6 @@ void* sp::memory::GrowingPoolAllocator::Alloc(size_t size, size_t alignment, siz
 		assert(alignmentLesserOrEqualMaxElementAlignment && "Allocation alignment has to be lesser or equal to the maximum element alignment provided at construction");
 	}
 
-	if (m_freeList.IsEmpty())
-	{
-		{
-			const bool canGrowFurther = m_physicalMemoryEnd + m_growSize <= m_virtualMemoryEnd;
-			assert(canGrowFurther && "Growing pool allocator cannot grow further because virtual address space is exhausted");
-		}
-
-		char* newPhysicalMem = pointerUtil::pseudo_cast<char*>(Grow(m_physicalMemoryEnd, m_growSize), 0);
-		const size_t offsetBeforeAlignment = offset + ALLOCATION_META_SIZE;
-		void* newFirstChunkPtr = sp::pointerUtil::AlignTop(newPhysicalMem + offsetBeforeAlignment, m_maxElementAlignment) - offsetBeforeAlignment;
-		m_physicalMemoryEnd = newPhysicalMem + m_growSize;
-
-		m_freeList.~FreeList();
-		new (&m_freeList) core::FreeList(newFirstChunkPtr, m_physicalMemoryEnd, m_minimalChunkSize);
-	}
-
 	union
 	{
 		char* as_char;
@@ -103,13 +109,23 @@ void* sp::memory::GrowingPoolAllocator::Alloc(size_t size, size_t alignment, siz
 	};
 
 	as_void = m_freeList.GetChunk();
-	as_allocationHeader->allocationSize = static_cast<uint32_t>(size);
-	as_char += ALLOCATION_META_SIZE;
+	if (!as_void)
+	{
+		as_void = TakeUntouchedChunk();
+	}
+
+	++m_blockOccupancy[GetBlockIndex(as_void)];
+	if constexpr (!HEADER_FREE)
+	{
+		as_allocationHeader->allocationSize = static_cast<uint32_t>(size);
+		as_char += ALLOCATION_META_SIZE;
+	}
 
 	return as_void;
 }
 
-void sp::memory::GrowingPoolAllocator::Dealloc(void* memory)
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::Dealloc(void* memory)
 {
 	{
 		const bool isNotNull = memory != nullptr;
@@ -120,26 +136,334 @@ void sp::memory::GrowingPoolAllocator::Dealloc(void* memory)
 
 	char* originalMemory = pointerUtil::pseudo_cast<char*>(memory, 0) - ALLOCATION_META_SIZE;
 	m_freeList.ReturnChunk(originalMemory);
+	OnChunkReturned(originalMemory);
 }
 
-void sp::memory::GrowingPoolAllocator::Reset()
+///
+/// With lazy initialization the free list is emptied and the blocks are bump allocated
+/// from the first one again, committed blocks are reused and trimmed ones recommitted
+/// on the way. Otherwise the free list is rebuilt block by block, chunks never cross
+/// a block boundary and trimmed blocks stay decommitted.
+///
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::Reset()
 {
-	m_freeList.~FreeList();
-	new (&m_freeList) core::FreeList(m_firstChunkPtr, m_physicalMemoryEnd, m_minimalChunkSize);
+	m_freeList.~FreeListType();
+	new (&m_freeList) FreeListType();
+	m_emptiedBlockCount = 0u;
+
+	if constexpr (LAZY_INITIALIZATION)
+	{
+		for (size_t blockIndex = 0u; m_physicalMemoryBegin + blockIndex * m_growSize < m_physicalMemoryEnd; ++blockIndex)
+		{
+			if (m_blockOccupancy[blockIndex] != DECOMMITTED_BLOCK)
+			{
+				m_blockOccupancy[blockIndex] = 0u;
+			}
+		}
+
+		m_decommittedBlocks.clear();
+		m_untouchedChunk = nullptr;
+		m_untouchedEnd = nullptr;
+		m_nextBlockIndex = 0u;
+		return;
+	}
+
+	// Last block first, so the chunks of the first block are handed out first again
+	for (size_t blockIndex = GetBlockIndex(m_physicalMemoryEnd - 1); blockIndex != size_t(-1); --blockIndex)
+	{
+		if (m_blockOccupancy[blockIndex] != DECOMMITTED_BLOCK)
+		{
+			m_blockOccupancy[blockIndex] = 0u;
+			ReturnBlockChunks(m_physicalMemoryBegin + blockIndex * m_growSize);
+		}
+	}
 }
 
-size_t sp::memory::GrowingPoolAllocator::GetAllocationSize(void* memory)
+template <typename FreeListType, bool HEADER_FREE>
+size_t sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::GetAllocationSize(void* memory)
 {
 	{
 		const bool isNotNull = memory != nullptr;
 		assert(isNotNull && "Cannot return allocation size of a nullptr");
 	}
 
+	if constexpr (HEADER_FREE)
+	{
+		return m_maxElementSize;
+	}
+
 	char* userPointer = static_cast<char*>(memory);
 	return pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationSize;
 }
 
-sp::memory::GrowingPoolAllocator::~GrowingPoolAllocator()
+template <typename FreeListType, bool HEADER_FREE>
+size_t sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::AllocChunks(void** chunks, size_t count)
+{
+	size_t chunkCount = 0u;
+	while (chunkCount < count)
+	{
+		void* chunk = m_freeList.GetChunk();
+		if (!chunk)
+		{
+			// Batches may ask for more than is left, hand out what there is instead of asserting
+			if (!HasUntouchedChunk() && !CanGrow())
+			{
+				break;
+			}
+
+			chunk = TakeUntouchedChunk();
+		}
+
+		++m_blockOccupancy[GetBlockIndex(chunk)];
+		chunks[chunkCount++] = chunk;
+	}
+
+	return chunkCount;
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::DeallocChunks(void* const* chunks, size_t count)
+{
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		m_freeList.ReturnChunk(chunks[idx]);
+		OnChunkReturned(chunks[idx]);
+	}
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+void* sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::InitializeChunk(void* chunk, size_t size) const
+{
+	{
+		const bool sizeLesserOrEqualMaxElementSize = size <= m_maxElementSize;
+		assert(sizeLesserOrEqualMaxElementSize && "Allocation size has to be lesser or equal to the maximum element size provided at construction");
+	}
+
+	union
+	{
+		char* as_char;
+		void* as_void;
+		AllocationHeader* as_allocationHeader;
+	};
+
+	as_void = chunk;
+	if constexpr (!HEADER_FREE)
+	{
+		as_allocationHeader->allocationSize = static_cast<uint32_t>(size);
+		as_char += ALLOCATION_META_SIZE;
+	}
+
+	return as_void;
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+void* sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::GetChunk(void* memory) const
+{
+	{
+		// Checked against the reserved range, which unlike the committed one never changes after construction
+		const bool isAllocatedFromAllocatorRange = memory >= m_virtualMemoryBegin && memory < m_virtualMemoryEnd;
+		assert(isAllocatedFromAllocatorRange && "Pointer was not allocated in the range of this allocator");
+	}
+
+	return pointerUtil::pseudo_cast<char*>(memory, 0) - ALLOCATION_META_SIZE;
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+size_t sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::Trim()
+{
+	// Unlink all free chunks, the ones of blocks that stay committed are chained up temporarily
+	void* keptChunks = nullptr;
+	while (!m_freeList.IsEmpty())
+	{
+		void* chunk = m_freeList.GetChunk();
+		if (m_blockOccupancy[GetBlockIndex(chunk)] != 0u)
+		{
+			*pointerUtil::pseudo_cast<void**>(chunk, 0) = keptChunks;
+			keptChunks = chunk;
+		}
+	}
+
+	size_t releasedSize = 0u;
+	for (size_t blockIndex = 0u; m_physicalMemoryBegin + blockIndex * m_growSize < m_physicalMemoryEnd; ++blockIndex)
+	{
+		if (m_blockOccupancy[blockIndex] != 0u)
+		{
+			continue;
+		}
+
+		char* block = m_physicalMemoryBegin + blockIndex * m_growSize;
+		DecommitPhysicalMemory(block, m_growSize);
+		m_blockOccupancy[blockIndex] = DECOMMITTED_BLOCK;
+		releasedSize += m_growSize;
+
+		// Blocks the bump pointer did not reach since the last Reset() are recommitted once it gets there
+		if (blockIndex < m_nextBlockIndex)
+		{
+			m_decommittedBlocks.push_back(block);
+		}
+
+		if (m_untouchedEnd == block + m_growSize)
+		{
+			m_untouchedChunk = nullptr;
+			m_untouchedEnd = nullptr;
+		}
+	}
+
+	// Chaining reversed the order once, returning them reverses it back
+	while (keptChunks)
+	{
+		void* chunk = keptChunks;
+		keptChunks = *pointerUtil::pseudo_cast<void**>(chunk, 0);
+		m_freeList.ReturnChunk(chunk);
+	}
+
+	m_committedSize -= releasedSize;
+	m_emptiedBlockCount = 0u;
+	return releasedSize;
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::SetAutoTrimThreshold(size_t threshold)
+{
+	{
+		const bool isSingleThreadedFreeList = !std::is_same<FreeListType, core::ConcurrentFreeList>::value;
+		assert((threshold == 0u || isSingleThreadedFreeList) && "Automatic trimming is not supported with the ConcurrentFreeList");
+	}
+
+	m_autoTrimThreshold = threshold;
+}
+
+///
+/// Moves on to the next block, trimmed blocks behind the bump pointer are reused first.
+/// Blocks ahead of it may still be committed after a Reset(), all others get committed.
+/// With lazy initialization the block becomes the new bump range, otherwise its
+/// chunks are linked into the free list. Every block starts on a page boundary, so the
+/// first chunk of the new block has the same offset into it as the very first
+/// chunk of the pool and therefore the same alignment.
+///
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::GrowFreeList()
+{
+	{
+		const bool canGrowFurther = CanGrow();
+		assert(canGrowFurther && "Growing pool allocator cannot grow further because virtual address space is exhausted");
+	}
+
+	char* newPhysicalMem = nullptr;
+	if (!m_decommittedBlocks.empty())
+	{
+		newPhysicalMem = m_decommittedBlocks.back();
+		m_decommittedBlocks.pop_back();
+	}
+	else
+	{
+		newPhysicalMem = m_physicalMemoryBegin + m_nextBlockIndex * m_growSize;
+		++m_nextBlockIndex;
+	}
+
+	const size_t blockIndex = GetBlockIndex(newPhysicalMem);
+	if (newPhysicalMem >= m_physicalMemoryEnd || m_blockOccupancy[blockIndex] == DECOMMITTED_BLOCK)
+	{
+		newPhysicalMem = pointerUtil::pseudo_cast<char*>(Grow(newPhysicalMem, m_growSize), 0);
+		m_committedSize += m_growSize;
+		m_physicalMemoryEnd = newPhysicalMem + m_growSize > m_physicalMemoryEnd ? newPhysicalMem + m_growSize : m_physicalMemoryEnd;
+	}
+
+	m_blockOccupancy[blockIndex] = 0u;
+
+	char* newFirstChunkPtr = newPhysicalMem + (m_firstChunkPtr - m_physicalMemoryBegin);
+	if constexpr (LAZY_INITIALIZATION)
+	{
+		m_untouchedChunk = newFirstChunkPtr;
+		m_untouchedEnd = newPhysicalMem + m_growSize;
+	}
+	else
+	{
+		// Chunks returned by other threads in the meantime have to stay in the list
+		ReturnBlockChunks(newPhysicalMem);
+	}
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+bool sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::CanGrow() const
 {
-	FreeAddressSpace(m_virtualMemoryBegin);
+	return !m_decommittedBlocks.empty() || m_physicalMemoryBegin + (m_nextBlockIndex + 1u) * m_growSize <= m_virtualMemoryEnd;
 }
+
+///
+/// Only called once the free list is empty. Without lazy initialization the bump
+/// range stays empty and the chunk comes from the free list rebuilt by growing.
+///
+template <typename FreeListType, bool HEADER_FREE>
+void* sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::TakeUntouchedChunk()
+{
+	if (!HasUntouchedChunk())
+	{
+		GrowFreeList();
+
+		if constexpr (!LAZY_INITIALIZATION)
+		{
+			return m_freeList.GetChunk();
+		}
+	}
+
+	char* chunk = m_untouchedChunk;
+	m_untouchedChunk += m_minimalChunkSize;
+	return chunk;
+}
+
+///
+/// Returns all chunks of a committed block to the free list, the lowest one ends up on top.
+/// They are linked in batches from the back of the block, so a concurrent free list only
+/// needs one exchange per batch.
+///
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::ReturnBlockChunks(char* block)
+{
+	char* firstChunk = block + (m_firstChunkPtr - m_physicalMemoryBegin);
+	size_t remainingCount = static_cast<size_t>(block + m_growSize - firstChunk) / m_minimalChunkSize;
+
+	void* batch[RETURN_BATCH_SIZE];
+	while (remainingCount > 0u)
+	{
+		const size_t batchCount = remainingCount < RETURN_BATCH_SIZE ? remainingCount : RETURN_BATCH_SIZE;
+		remainingCount -= batchCount;
+
+		for (size_t idx = 0u; idx < batchCount; ++idx)
+		{
+			batch[idx] = firstChunk + (remainingCount + idx) * m_minimalChunkSize;
+		}
+		m_freeList.ReturnChunks(batch, batchCount);
+	}
+}
+
+///
+/// Books a chunk that went back to the free list and trims once enough blocks became empty
+///
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::OnChunkReturned(void* chunk)
+{
+	if (--m_blockOccupancy[GetBlockIndex(chunk)] == 0u && m_autoTrimThreshold != 0u && ++m_emptiedBlockCount > m_autoTrimThreshold)
+	{
+		Trim();
+	}
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::~BasicGrowingPoolAllocator()
+{
+	FreeAddressSpace(m_virtualMemoryBegin, m_virtualMemoryEnd - m_virtualMemoryBegin);
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+const uint32_t sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::DECOMMITTED_BLOCK;
+template <typename FreeListType, bool HEADER_FREE>
+const uint32_t sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::ALLOCATION_META_SIZE;
+template <typename FreeListType, bool HEADER_FREE>
+const bool sp::memory::BasicGrowingPoolAllocator<FreeListType, HEADER_FREE>::LAZY_INITIALIZATION;
+
+template class sp::memory::BasicGrowingPoolAllocator<sp::core::FreeList, false>;
+template class sp::memory::BasicGrowingPoolAllocator<sp::core::ConcurrentFreeList, false>;
+template class sp::memory::BasicGrowingPoolAllocator<sp::core::FreeList, true>;
+template class sp::memory::BasicGrowingPoolAllocator<sp::core::ConcurrentFreeList, true>;
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
 #include "../AllocatorBase.h"
 #include "FreeList/FreeList.h"
+#include "FreeList/ConcurrentFreeList.h"
 
 namespace sp
 {
@@ -13,16 +19,38 @@ namespace sp
 		 * If the limit is exceeded the allocator can commit additional physical
 		 * memory till a maximum allowed limit. It has the same mechanism as the 
 		 * non-growing pool allocator.
+		 *
+		 * With the ConcurrentFreeList only the free list operations are lock-free,
+		 * growing the pool is not. Concurrent use therefore needs enough chunks
+		 * committed up front or an external lock around Alloc().
+		 *
+		 * Memory is committed in blocks of growSize bytes. Every block counts its
+		 * allocated chunks, Trim() decommits the blocks without any and removes their
+		 * chunks from the free list. Later growth recommits trimmed blocks first.
+		 *
+		 * With the single-threaded FreeList the chunks of a block are not linked up
+		 * front. A bump pointer hands out the untouched chunks of the newest block,
+		 * the free list only holds chunks that were returned. Growing and Reset()
+		 * therefore do not walk the chunks and pages are only touched once they are
+		 * handed out. The ConcurrentFreeList links every block when it is committed,
+		 * so concurrent Alloc() calls never race on the bump pointer.
+		 *
+		 * HEADER_FREE drops the size header of every chunk like in the BasicPoolAllocator,
+		 * GetAllocationSize() then returns the maximum element size and HAS_EXACT_ALLOCATION_SIZE
+		 * is false.
 		 */
-		class GrowingPoolAllocator : public AllocatorBase
+		template <typename FreeListType, bool HEADER_FREE = false>
+		class BasicGrowingPoolAllocator : public AllocatorBase
 		{
 		public:
-			GrowingPoolAllocator(size_t elementMaxSize, size_t elementCount, size_t elementCountMax, size_t elementMaxAlignment, size_t offset);
+			static constexpr bool HAS_EXACT_ALLOCATION_SIZE = !HEADER_FREE;
+
+			BasicGrowingPoolAllocator(size_t elementMaxSize, size_t elementCount, size_t elementCountMax, size_t elementMaxAlignment, size_t offset);
 
-			GrowingPoolAllocator(const GrowingPoolAllocator& other) = delete;
-			GrowingPoolAllocator(const GrowingPoolAllocator&& other) = delete;
-			GrowingPoolAllocator operator=(const GrowingPoolAllocator& other) = delete;
-			GrowingPoolAllocator operator=(const GrowingPoolAllocator&& other) = delete;
+			BasicGrowingPoolAllocator(const BasicGrowingPoolAllocator& other) = delete;
+			BasicGrowingPoolAllocator(const BasicGrowingPoolAllocator&& other) = delete;
+			BasicGrowingPoolAllocator operator=(const BasicGrowingPoolAllocator& other) = delete;
+			BasicGrowingPoolAllocator operator=(const BasicGrowingPoolAllocator&& other) = delete;
 
 			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
 			virtual void Dealloc(void* memory) override;
@@ -30,9 +58,61 @@ namespace sp
 
 			virtual size_t GetAllocationSize(void* memory) override;
 
-			inline ~GrowingPoolAllocator() override;
+			/**
+			 * Chunk-level access for front-ends that cache chunks themselves (e.g. the
+			 * ThreadCachingPoolAllocator). AllocChunks() grows the pool if necessary
+			 * and returns fewer chunks only once the reserved range is exhausted.
+			 * Like the rest of the allocator these calls are not synchronized.
+			 */
+			size_t AllocChunks(void** chunks, size_t count);
+			void DeallocChunks(void* const* chunks, size_t count);
+			void* InitializeChunk(void* chunk, size_t size) const;
+			size_t GetMaxElementAlignment(void) const { return m_maxElementAlignment; }
+			void* GetChunk(void* memory) const;
+
+			/// True if the pointer lies inside the address range reserved by this pool
+			bool Owns(const void* memory) const { return memory >= m_virtualMemoryBegin && memory < m_virtualMemoryEnd; }
+
+			/**
+			 * Decommits all blocks whose chunks are all free and returns the number of
+			 * bytes released. The free list is rebuilt, so this is O(free chunks) and
+			 * not thread-safe, not even with the ConcurrentFreeList.
+			 */
+			size_t Trim(void);
+			/**
+			 * Runs Trim() from Dealloc() once blocks became empty more than threshold times
+			 * since the last trim, 0 (the default) disables it. A higher threshold keeps a
+			 * few empty blocks around to absorb load spikes without commit/decommit churn.
+			 * Not supported with the ConcurrentFreeList.
+			 */
+			void SetAutoTrimThreshold(size_t threshold);
+
+			/// Bytes of physical memory currently committed
+			size_t GetCommittedSize(void) const { return m_committedSize; }
+
+			~BasicGrowingPoolAllocator() override;
 
 		private:
+			// Counters are updated by concurrent Dealloc() calls when the free list is lock-free
+			typedef typename std::conditional<std::is_same<FreeListType, core::ConcurrentFreeList>::value,
+				std::atomic<uint32_t>, uint32_t>::type OccupancyCounter;
+
+			static const uint32_t DECOMMITTED_BLOCK = 0xFFFFFFFF;
+			// Size of the AllocationHeader in front of every user pointer
+			static const uint32_t ALLOCATION_META_SIZE = HEADER_FREE ? 0u : sizeof(uint32_t);
+			static const bool LAZY_INITIALIZATION = !std::is_same<FreeListType, core::ConcurrentFreeList>::value;
+			// Chunks linked into the free list per ReturnChunks() call when a whole block is returned
+			static const size_t RETURN_BATCH_SIZE = 64u;
+
+			void GrowFreeList(void);
+			bool CanGrow(void) const;
+			bool HasUntouchedChunk(void) const { return static_cast<size_t>(m_untouchedEnd - m_untouchedChunk) >= m_minimalChunkSize; }
+			void* TakeUntouchedChunk(void);
+			void ReturnBlockChunks(char* block);
+			void OnChunkReturned(void* chunk);
+
+			size_t GetBlockIndex(const void* chunk) const { return static_cast<size_t>(static_cast<const char*>(chunk) - m_physicalMemoryBegin) / m_growSize; }
+
 			char* m_virtualMemoryBegin;
 			char* m_virtualMemoryEnd;
 			char* m_physicalMemoryBegin;
@@ -44,7 +124,21 @@ namespace sp
 			const size_t m_minimalChunkSize;
 			const size_t m_growSize;
 
-			core::FreeList m_freeList;
+			FreeListType m_freeList;
+			char* m_untouchedChunk;
+			char* m_untouchedEnd;
+			size_t m_nextBlockIndex;
+
+			std::vector<OccupancyCounter> m_blockOccupancy;
+			std::vector<char*> m_decommittedBlocks;
+			size_t m_committedSize;
+			size_t m_autoTrimThreshold;
+			size_t m_emptiedBlockCount;
 		};
+
+		typedef BasicGrowingPoolAllocator<core::FreeList> GrowingPoolAllocator;
+		typedef BasicGrowingPoolAllocator<core::ConcurrentFreeList> ConcurrentGrowingPoolAllocator;
+		typedef BasicGrowingPoolAllocator<core::FreeList, true> HeaderFreeGrowingPoolAllocator;
+		typedef BasicGrowingPoolAllocator<core::ConcurrentFreeList, true> ConcurrentHeaderFreeGrowingPoolAllocator;
 	}
 }
@@ -0,0 +1,121 @@
+#include "GrowingStackAllocator.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	struct AllocationHeader
+	{
+		uint32_t allocationOffset;
+		uint32_t allocationSize;
+	};
+
+	const uint32_t ALLOCATION_META_SIZE = sizeof(AllocationHeader);
+}
+
+const size_t sp::memory::GrowingStackAllocator::DEFAULT_GROW_SIZE;
+
+sp::memory::GrowingStackAllocator::GrowingStackAllocator(size_t maxSize, size_t growSize)
+	: m_memory(maxSize, growSize, this)
+	, m_currentPtr(m_memory.GetBegin())
+{
+	{
+		const bool offsetsFitIntoHeader = maxSize <= UINT32_MAX;
+		assert(offsetsFitIntoHeader && "The stack cannot be larger than 4 GiB, allocation offsets are stored in 32 bit");
+	}
+}
+
+void* sp::memory::GrowingStackAllocator::Alloc(size_t size, size_t alignment, size_t offset)
+{
+	assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+	const ptrdiff_t allocationOffset = m_currentPtr - m_memory.GetBegin();
+	// Align the currentPtr offsetted by offset + AllocationMetaSize to not
+	// mess up alignment when adding canaries later
+	char* allocation = m_currentPtr + offset + ALLOCATION_META_SIZE;
+	allocation = static_cast<char*>(pointerUtil::AlignTop(allocation, alignment));
+	allocation -= offset + ALLOCATION_META_SIZE;
+
+	char* allocationEnd = allocation + ALLOCATION_META_SIZE + size;
+	if (allocationEnd > m_memory.GetCommittedEnd() && !m_memory.Grow(allocationEnd))
+	{
+		return nullptr;
+	}
+
+	union
+	{
+		void* as_void;
+		char* as_char;
+		AllocationHeader* as_header;
+	};
+
+	// Write the allocationOffset in the slot before the userPointer
+	as_char = allocation;
+	as_header->allocationOffset = static_cast<uint32_t>(allocationOffset);
+	as_header->allocationSize = static_cast<uint32_t>(size);
+	as_char += ALLOCATION_META_SIZE;
+	m_currentPtr = allocationEnd;
+
+	return as_void;
+}
+
+void sp::memory::GrowingStackAllocator::Dealloc(void* memory)
+{
+	{
+		const bool isNotNull = memory != nullptr;
+		assert(isNotNull && "Memory shall not be a nullptr");
+		const bool userPointerInAllocatorRange = memory >= m_memory.GetBegin() && memory <= m_currentPtr;
+		assert(userPointerInAllocatorRange && "UserPointer was not allocared by this allocator. Not in memory range.");
+	}
+
+	char* userPointer = static_cast<char*>(memory);
+	const uint32_t allocationOffset = pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationOffset;
+	m_currentPtr = m_memory.GetBegin() + allocationOffset;
+}
+
+void sp::memory::GrowingStackAllocator::Reset()
+{
+	m_currentPtr = m_memory.GetBegin();
+}
+
+size_t sp::memory::GrowingStackAllocator::GetAllocationSize(void* memory)
+{
+	{
+		const bool isNotNull = memory != nullptr;
+		assert(isNotNull && "Cannot return allocation size of a nullptr");
+	}
+
+	char* userPointer = static_cast<char*>(memory);
+	return pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationSize;
+}
+
+sp::memory::GrowingStackAllocator::Marker sp::memory::GrowingStackAllocator::GetMarker(void) const
+{
+	return m_currentPtr - m_memory.GetBegin();
+}
+
+///
+/// Rewinds the stack to a previously taken marker, which frees all allocations
+/// made after it. Markers have to be released in LIFO order as well.
+///
+void sp::memory::GrowingStackAllocator::FreeToMarker(Marker marker)
+{
+	{
+		const bool markerBelowTop = marker <= GetMarker();
+		assert(markerBelowTop && "Marker lies above the top of the stack, it was already freed");
+	}
+
+	m_currentPtr = m_memory.GetBegin() + marker;
+}
+
+size_t sp::memory::GrowingStackAllocator::GetCommittedSize(void) const
+{
+	return m_memory.GetCommittedSize();
+}
+
+sp::memory::GrowingStackAllocator::~GrowingStackAllocator()
+{
+}
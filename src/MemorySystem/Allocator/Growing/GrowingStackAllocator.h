@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CommittedRange.h"
+#include "../AllocatorBase.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/*
+		 * A growing stack-based allocator
+		 *
+		 * Frees single allocations in last-in-first-out order like the StackAllocator, but
+		 * reserves maxSize bytes of address space and commits physical memory on demand in
+		 * steps of growSize bytes.
+		 *
+		 * GetMarker() remembers the current top of the stack, FreeToMarker() releases every
+		 * allocation made after it at once in O(1). A scope of temporaries therefore does not
+		 * need to keep its pointers or free them one by one.
+		 */
+		class GrowingStackAllocator : public AllocatorBase
+		{
+		public:
+			/// Top of the stack, as returned by GetMarker()
+			typedef size_t Marker;
+
+			static const size_t DEFAULT_GROW_SIZE = 64 * 1024;
+
+			explicit GrowingStackAllocator(size_t maxSize, size_t growSize = DEFAULT_GROW_SIZE);
+
+			GrowingStackAllocator(const GrowingStackAllocator& other) = delete;
+			GrowingStackAllocator(const GrowingStackAllocator&& other) = delete;
+			GrowingStackAllocator operator=(const GrowingStackAllocator& other) = delete;
+			GrowingStackAllocator operator=(const GrowingStackAllocator&& other) = delete;
+
+			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
+			virtual void Dealloc(void* memory) override;
+			virtual void Reset() override;
+			virtual size_t GetAllocationSize(void* memory) override;
+
+			Marker GetMarker(void) const;
+			void FreeToMarker(Marker marker);
+
+			/// Bytes currently backed by physical memory
+			size_t GetCommittedSize(void) const;
+
+			virtual ~GrowingStackAllocator() override;
+
+		private:
+			CommittedRange m_memory;
+			char* m_currentPtr;
+		};
+	}
+}
@@ -0,0 +1,272 @@
+#include "SizeClassAllocator.h"
+
+#include <cassert>
+#include <new>
+
+#include "Math/MathUtil.h"
+#include "Pointers/PointerUtil.h"
+#include "../../VirtualMemory/VirtualMemory.h"
+
+namespace
+{
+	// Committing roughly this much per grow keeps the number of commits low for tiny classes
+	static const size_t POOL_GROW_BYTES = 64 * 1024;
+	static const size_t POOL_OFFSET_UNSET = ~size_t(0);
+
+	// Stored directly in front of every large allocation, pointing back to its header
+	struct LargeAllocationOffset
+	{
+		uint32_t headerOffset;
+	};
+
+	static const uint32_t LARGE_OFFSET_META_SIZE = sizeof(LargeAllocationOffset);
+}
+
+///
+/// Every large allocation owns its own reservation which starts with this header.
+/// All of them are linked together so Reset() and the destructor can release them.
+///
+const size_t sp::memory::SizeClassAllocator::SIZE_CLASS_COUNT;
+const size_t sp::memory::SizeClassAllocator::MIN_SMALL_SIZE;
+const size_t sp::memory::SizeClassAllocator::MAX_SMALL_SIZE;
+const size_t sp::memory::SizeClassAllocator::MAX_SMALL_ALIGNMENT;
+
+struct sp::memory::SizeClassAllocator::LargeAllocationHeader
+{
+	LargeAllocationHeader* previous;
+	LargeAllocationHeader* next;
+	size_t reservationSize;
+	size_t allocationSize;
+};
+
+sp::memory::SizeClassAllocator::SizeClassAllocator(size_t bytesPerSizeClass)
+	: m_bytesPerSizeClass(bytesPerSizeClass)
+	, m_poolOffset(POOL_OFFSET_UNSET)
+	, m_pageOwner(ResolvePageOwner(this))
+	, m_largeAllocations(nullptr)
+{
+	{
+		const bool canHoldLargestClass = bytesPerSizeClass >= MAX_SMALL_SIZE;
+		assert(canHoldLargestClass && "Every size class has to be able to hold at least one block of the largest class");
+	}
+
+	for (GrowingPoolAllocator*& pool : m_pools)
+	{
+		pool = nullptr;
+	}
+}
+
+void* sp::memory::SizeClassAllocator::Alloc(size_t size, size_t alignment, size_t offset)
+{
+	assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+	if (size <= MAX_SMALL_SIZE && alignment <= MAX_SMALL_ALIGNMENT)
+	{
+		GrowingPoolAllocator* pool = GetOrCreatePool(GetSizeClass(size), offset);
+
+		void* chunk = nullptr;
+		if (pool->AllocChunks(&chunk, 1) == 1)
+		{
+			return pool->InitializeChunk(chunk, size);
+		}
+
+		// The size class exhausted its address space, spill over into a dedicated allocation
+	}
+
+	return AllocLarge(size, alignment, offset);
+}
+
+void sp::memory::SizeClassAllocator::Dealloc(void* memory)
+{
+	{
+		const bool isNotNull = memory != nullptr;
+		assert(isNotNull && "Freeing a nullptr is not allowed");
+	}
+
+	GrowingPoolAllocator* pool = FindOwningPool(memory);
+	if (pool)
+	{
+		pool->Dealloc(memory);
+	}
+	else
+	{
+		DeallocLarge(memory);
+	}
+}
+
+void sp::memory::SizeClassAllocator::Reset()
+{
+	for (GrowingPoolAllocator* pool : m_pools)
+	{
+		if (pool)
+		{
+			pool->Reset();
+		}
+	}
+
+	while (m_largeAllocations)
+	{
+		LargeAllocationHeader* next = m_largeAllocations->next;
+		FreeAddressSpace(m_largeAllocations, m_largeAllocations->reservationSize);
+		m_largeAllocations = next;
+	}
+}
+
+size_t sp::memory::SizeClassAllocator::GetAllocationSize(void* memory)
+{
+	{
+		const bool isNotNull = memory != nullptr;
+		assert(isNotNull && "Cannot return allocation size of a nullptr");
+	}
+
+	GrowingPoolAllocator* pool = FindOwningPool(memory);
+	if (pool)
+	{
+		return pool->GetAllocationSize(memory);
+	}
+
+	char* userPointer = static_cast<char*>(memory);
+	const uint32_t headerOffset = pointerUtil::pseudo_cast<LargeAllocationOffset*>(userPointer - LARGE_OFFSET_META_SIZE, 0)->headerOffset;
+	return pointerUtil::pseudo_cast<LargeAllocationHeader*>(userPointer - headerOffset, 0)->allocationSize;
+}
+
+///
+/// Class sizes are 16 * 2^n (even classes) and 24 * 2^n (odd classes). For a size
+/// in (2^p, 2^(p+1)] the candidates are 1.5 * 2^p and 2^(p+1), one bit-scan is
+/// enough to pick the right one.
+///
+size_t sp::memory::SizeClassAllocator::GetSizeClass(size_t size)
+{
+	if (size <= MIN_SMALL_SIZE)
+	{
+		return 0u;
+	}
+
+	const size_t sizeMinusOne = size - 1u;
+	const uint32_t log2 = math::FloorLog2(sizeMinusOne);
+	const size_t powerOfTwo = size_t(1) << log2;
+
+	if (sizeMinusOne < powerOfTwo + (powerOfTwo >> 1))
+	{
+		return 2u * (log2 - 4u) + 1u;
+	}
+
+	return 2u * (log2 - 3u);
+}
+
+size_t sp::memory::SizeClassAllocator::GetSizeClassSize(size_t sizeClass)
+{
+	const size_t baseSize = (sizeClass & 1u) ? 24u : MIN_SMALL_SIZE;
+	return baseSize << (sizeClass >> 1);
+}
+
+sp::memory::SizeClassAllocator::~SizeClassAllocator()
+{
+	Reset();
+
+	for (GrowingPoolAllocator* pool : m_pools)
+	{
+		if (pool)
+		{
+			pool->~GrowingPoolAllocator();
+		}
+	}
+}
+
+sp::memory::GrowingPoolAllocator* sp::memory::SizeClassAllocator::GetOrCreatePool(size_t sizeClass, size_t offset)
+{
+	if (m_poolOffset == POOL_OFFSET_UNSET)
+	{
+		m_poolOffset = offset;
+	}
+
+	{
+		const bool offsetMatchesPools = offset == m_poolOffset;
+		assert(offsetMatchesPools && "All small allocations have to use the same offset");
+	}
+
+	if (!m_pools[sizeClass])
+	{
+		const size_t classSize = GetSizeClassSize(sizeClass);
+		const size_t growCount = classSize < POOL_GROW_BYTES ? POOL_GROW_BYTES / classSize : 1u;
+		const size_t maxCount = m_bytesPerSizeClass / classSize;
+
+		ScopedPageOwner pageOwnerScope(m_pageOwner);
+		m_pools[sizeClass] = new (m_poolStorage[sizeClass]) GrowingPoolAllocator(classSize, growCount,
+			maxCount > growCount ? maxCount : growCount, MAX_SMALL_ALIGNMENT, offset);
+	}
+
+	return m_pools[sizeClass];
+}
+
+sp::memory::GrowingPoolAllocator* sp::memory::SizeClassAllocator::FindOwningPool(const void* memory) const
+{
+	for (GrowingPoolAllocator* pool : m_pools)
+	{
+		if (pool && pool->Owns(memory))
+		{
+			return pool;
+		}
+	}
+
+	return nullptr;
+}
+
+void* sp::memory::SizeClassAllocator::AllocLarge(size_t size, size_t alignment, size_t offset)
+{
+	const size_t worstCaseSize = sizeof(LargeAllocationHeader) + LARGE_OFFSET_META_SIZE + offset + alignment + size;
+	const size_t reservationSize = math::RoundUp(worstCaseSize, GetPageSize());
+
+	char* reservation = static_cast<char*>(ReserveAddressSpace(reservationSize, m_pageOwner));
+	if (!reservation)
+	{
+		return nullptr;
+	}
+
+	if (!CommitPhysicalMemory(reservation, reservationSize))
+	{
+		FreeAddressSpace(reservation, reservationSize);
+		return nullptr;
+	}
+
+	const size_t offsetBeforeAlignment = offset + LARGE_OFFSET_META_SIZE;
+	char* allocation = pointerUtil::AlignTop(reservation + sizeof(LargeAllocationHeader) + offsetBeforeAlignment, alignment) - offset;
+
+	LargeAllocationHeader* header = pointerUtil::pseudo_cast<LargeAllocationHeader*>(reservation, 0);
+	header->previous = nullptr;
+	header->next = m_largeAllocations;
+	header->reservationSize = reservationSize;
+	header->allocationSize = size;
+
+	if (m_largeAllocations)
+	{
+		m_largeAllocations->previous = header;
+	}
+	m_largeAllocations = header;
+
+	pointerUtil::pseudo_cast<LargeAllocationOffset*>(allocation - LARGE_OFFSET_META_SIZE, 0)->headerOffset = static_cast<uint32_t>(allocation - reservation);
+	return allocation;
+}
+
+void sp::memory::SizeClassAllocator::DeallocLarge(void* memory)
+{
+	char* userPointer = static_cast<char*>(memory);
+	const uint32_t headerOffset = pointerUtil::pseudo_cast<LargeAllocationOffset*>(userPointer - LARGE_OFFSET_META_SIZE, 0)->headerOffset;
+	LargeAllocationHeader* header = pointerUtil::pseudo_cast<LargeAllocationHeader*>(userPointer - headerOffset, 0);
+
+	if (header->previous)
+	{
+		header->previous->next = header->next;
+	}
+	else
+	{
+		m_largeAllocations = header->next;
+	}
+
+	if (header->next)
+	{
+		header->next->previous = header->previous;
+	}
+
+	FreeAddressSpace(header, header->reservationSize);
+}
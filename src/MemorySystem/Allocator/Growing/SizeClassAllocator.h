@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../AllocatorBase.h"
+#include "GrowingPoolAllocator.h"
+#include "../../PageMap/PageMap.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * A general-purpose allocator that segregates allocations by size.
+		 *
+		 * Small requests (up to MAX_SMALL_SIZE bytes, alignment up to MAX_SMALL_ALIGNMENT)
+		 * are rounded up to the next of SIZE_CLASS_COUNT size classes and served by a
+		 * growing pool of that class in O(1). The classes grow geometrically with two
+		 * steps per power-of-two (16, 24, 32, 48, 64, ...), so the memory wasted by
+		 * rounding up is bounded by a third of the block. Every pool reserves
+		 * bytesPerSizeClass of address space, but only commits memory on demand and
+		 * is only created once its size class is used for the first time.
+		 *
+		 * Larger or more strictly aligned requests get their own pages committed
+		 * directly from the virtual memory system and are released on Dealloc.
+		 *
+		 * Blocks can be freed in any order. Like the pool allocators, all allocations
+		 * are expected to use the same offset (e.g. the canary size of a realm).
+		 *
+		 * Pools and large allocations are created on demand. Their pages are registered
+		 * for whoever owned the allocator's construction (e.g. its realm), otherwise for
+		 * the SizeClassAllocator itself, so sp::memory::Free() never skips a layer.
+		 */
+		class SizeClassAllocator : public AllocatorBase
+		{
+		public:
+			static const size_t SIZE_CLASS_COUNT = 23;
+			static const size_t MIN_SMALL_SIZE = 16;
+			static const size_t MAX_SMALL_SIZE = 32 * 1024;
+			static const size_t MAX_SMALL_ALIGNMENT = 16;
+
+			explicit SizeClassAllocator(size_t bytesPerSizeClass);
+
+			SizeClassAllocator(const SizeClassAllocator& other) = delete;
+			SizeClassAllocator(const SizeClassAllocator&& other) = delete;
+			SizeClassAllocator operator=(const SizeClassAllocator& other) = delete;
+			SizeClassAllocator operator=(const SizeClassAllocator&& other) = delete;
+
+			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
+			virtual void Dealloc(void* memory) override;
+			virtual void Reset() override;
+
+			virtual size_t GetAllocationSize(void* memory) override;
+
+			/// Index of the size class serving a request of size bytes
+			static size_t GetSizeClass(size_t size);
+			/// Block size of the given size class
+			static size_t GetSizeClassSize(size_t sizeClass);
+
+			~SizeClassAllocator() override;
+
+		private:
+			struct LargeAllocationHeader;
+
+			GrowingPoolAllocator* GetOrCreatePool(size_t sizeClass, size_t offset);
+			GrowingPoolAllocator* FindOwningPool(const void* memory) const;
+
+			void* AllocLarge(size_t size, size_t alignment, size_t offset);
+			void DeallocLarge(void* memory);
+
+			const size_t m_bytesPerSizeClass;
+			size_t m_poolOffset;
+			const PageOwner m_pageOwner;
+
+			GrowingPoolAllocator* m_pools[SIZE_CLASS_COUNT];
+			alignas(GrowingPoolAllocator) char m_poolStorage[SIZE_CLASS_COUNT][sizeof(GrowingPoolAllocator)];
+
+			LargeAllocationHeader* m_largeAllocations;
+		};
+	}
+}
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Math/MathUtil.h"
+#include "Pointers/PointerUtil.h"
+#include "../../VirtualMemory/VirtualMemory.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Snapshot of the slabs of a SlabAllocator. Decommitted slabs are not counted,
+		 * their address space stays reserved for reuse.
+		 */
+		struct SlabAllocatorStatistics
+		{
+			size_t slabSize;
+			size_t objectsPerSlab;
+			size_t partialSlabs;
+			size_t fullSlabs;
+			size_t emptySlabs;
+			size_t liveObjects;
+			size_t committedBytes;
+		};
+
+		/**
+		 * A typed allocator for objects of type T, carving slabs of one or more pages
+		 * from a reserved address range.
+		 *
+		 * Every slab starts with a small header and a table of free slot indices, the
+		 * objects follow. Slabs are kept in three lists: partial slabs serve Alloc()
+		 * first, so the live objects stay packed into as few slabs as possible, full
+		 * slabs are not looked at and empty slabs are kept as a cache. Once more than
+		 * maxEmptySlabs slabs are empty, the additional ones are handed back to the OS
+		 * with DecommitPhysicalMemory and recommitted when they are needed again.
+		 *
+		 * With KEEP_CONSTRUCTED the objects of a slab are default constructed once when
+		 * it is committed and only destroyed when it is decommitted. Dealloc() keeps the
+		 * object alive and Alloc() returns it in the state it was freed in, which saves
+		 * the construction cost of objects that own buffers or are expensive to set up.
+		 * The free slot table lives outside of the objects, so no byte of a cached
+		 * object is overwritten while it is free.
+		 *
+		 * Unlike the untyped allocators it cannot be plugged into a MemoryRealm. It is
+		 * not thread-safe.
+		 */
+		template <typename T, bool KEEP_CONSTRUCTED = false>
+		class SlabAllocator final
+		{
+		public:
+			/// Objects of a slab that is smaller than this span multiple pages
+			static const size_t MIN_OBJECTS_PER_SLAB = 8;
+
+			SlabAllocator(size_t maxObjectCount, size_t maxEmptySlabs = 1);
+
+			SlabAllocator(const SlabAllocator& other) = delete;
+			SlabAllocator(const SlabAllocator&& other) = delete;
+			SlabAllocator operator=(const SlabAllocator& other) = delete;
+			SlabAllocator operator=(const SlabAllocator&& other) = delete;
+
+			/// Returns nullptr once all slabs of the reserved range are full
+			template <typename... Arguments>
+			T* Alloc(Arguments&&... arguments);
+			void Dealloc(T* object);
+
+			/// Decommits all empty slabs, including the ones kept as a cache
+			void ReleaseEmptySlabs(void);
+
+			/// True if the pointer lies inside the address range reserved by this allocator
+			bool Owns(const void* memory) const { return memory >= m_memoryBegin && memory < m_memoryEnd; }
+
+			SlabAllocatorStatistics GetStatistics(void) const;
+
+			~SlabAllocator();
+
+		private:
+			struct Slab
+			{
+				Slab* previous;
+				Slab* next;
+				uint32_t liveCount;
+				uint16_t firstFreeSlot;
+			};
+
+			struct SlabList
+			{
+				Slab* head;
+				size_t count;
+			};
+
+			static const uint16_t END_OF_SLOTS = 0xFFFE;
+			static const uint16_t ALLOCATED_SLOT = 0xFFFF;
+
+			static void PushSlab(SlabList& list, Slab* slab);
+			static void RemoveSlab(SlabList& list, Slab* slab);
+
+			Slab* CommitSlab(void);
+			void DecommitSlab(Slab* slab);
+			void DestroyObjects(Slab* slab);
+
+			Slab* GetSlab(const T* object) const;
+			uint16_t* GetSlots(Slab* slab) const;
+			T* GetObjects(Slab* slab) const;
+
+			char* m_memoryBegin;
+			char* m_memoryEnd;
+			char* m_uncommittedBegin;
+
+			size_t m_slabSize;
+			size_t m_objectsPerSlab;
+			size_t m_objectsOffset;
+			const size_t m_maxEmptySlabs;
+
+			SlabList m_partialSlabs;
+			SlabList m_fullSlabs;
+			SlabList m_emptySlabs;
+			std::vector<char*> m_decommittedSlabs;
+		};
+
+		/// Keeps freed objects constructed, Alloc() hands out default constructed or previously freed objects
+		template <typename T>
+		using CachingSlabAllocator = SlabAllocator<T, true>;
+
+#pragma region Implementation
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		const size_t SlabAllocator<T, KEEP_CONSTRUCTED>::MIN_OBJECTS_PER_SLAB;
+
+		///
+		/// Picks the smallest multiple of the page size holding MIN_OBJECTS_PER_SLAB objects
+		/// and reserves enough slabs for maxObjectCount objects. Nothing is committed yet.
+		///
+		template <typename T, bool KEEP_CONSTRUCTED>
+		SlabAllocator<T, KEEP_CONSTRUCTED>::SlabAllocator(size_t maxObjectCount, size_t maxEmptySlabs)
+			: m_slabSize(0u)
+			, m_objectsPerSlab(0u)
+			, m_objectsOffset(0u)
+			, m_maxEmptySlabs(maxEmptySlabs)
+			, m_partialSlabs{ nullptr, 0u }
+			, m_fullSlabs{ nullptr, 0u }
+			, m_emptySlabs{ nullptr, 0u }
+		{
+			{
+				const bool isValidObjectCount = maxObjectCount != 0u;
+				assert(isValidObjectCount && "Cannot intialize an allocator for 0 objects");
+				const bool isValidAlignment = alignof(T) <= GetPageSize();
+				assert(isValidAlignment && "Objects cannot be aligned to more than the page size");
+			}
+
+			const size_t pageSize = GetPageSize();
+			while (m_objectsPerSlab < MIN_OBJECTS_PER_SLAB)
+			{
+				m_slabSize += pageSize;
+
+				// Shrink the count until header, slot table and objects fit
+				m_objectsPerSlab = m_slabSize / sizeof(T);
+				m_objectsPerSlab = m_objectsPerSlab < END_OF_SLOTS ? m_objectsPerSlab : END_OF_SLOTS;
+				while (m_objectsPerSlab > 0u)
+				{
+					m_objectsOffset = math::RoundUp(sizeof(Slab) + m_objectsPerSlab * sizeof(uint16_t), alignof(T));
+					if (m_objectsOffset + m_objectsPerSlab * sizeof(T) <= m_slabSize)
+					{
+						break;
+					}
+					--m_objectsPerSlab;
+				}
+			}
+
+			const size_t slabCount = (maxObjectCount + m_objectsPerSlab - 1u) / m_objectsPerSlab;
+			m_memoryBegin = static_cast<char*>(ReserveAddressSpace(slabCount * m_slabSize));
+			m_memoryEnd = m_memoryBegin + slabCount * m_slabSize;
+			m_uncommittedBegin = m_memoryBegin;
+
+			m_decommittedSlabs.reserve(slabCount);
+		}
+
+		///
+		/// Serves the first partial slab, an empty slab is only touched once no partial one is left
+		///
+		template <typename T, bool KEEP_CONSTRUCTED>
+		template <typename... Arguments>
+		T* SlabAllocator<T, KEEP_CONSTRUCTED>::Alloc(Arguments&&... arguments)
+		{
+			static_assert(!KEEP_CONSTRUCTED || sizeof...(Arguments) == 0, "Cached objects are constructed once per slab, they cannot take constructor arguments");
+
+			Slab* slab = m_partialSlabs.head;
+			if (!slab)
+			{
+				slab = m_emptySlabs.head ? m_emptySlabs.head : CommitSlab();
+				if (!slab)
+				{
+					return nullptr;
+				}
+
+				RemoveSlab(m_emptySlabs, slab);
+				PushSlab(m_partialSlabs, slab);
+			}
+
+			uint16_t* slots = GetSlots(slab);
+			const uint16_t slot = slab->firstFreeSlot;
+			slab->firstFreeSlot = slots[slot];
+			slots[slot] = ALLOCATED_SLOT;
+
+			if (++slab->liveCount == m_objectsPerSlab)
+			{
+				RemoveSlab(m_partialSlabs, slab);
+				PushSlab(m_fullSlabs, slab);
+			}
+
+			T* object = GetObjects(slab) + slot;
+			if constexpr (!KEEP_CONSTRUCTED)
+			{
+				new (object) T(std::forward<Arguments>(arguments)...);
+			}
+			return object;
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		void SlabAllocator<T, KEEP_CONSTRUCTED>::Dealloc(T* object)
+		{
+			{
+				const bool isNotNull = object != nullptr;
+				assert(isNotNull && "Freeing a nullptr is not allowed");
+				const bool isAllocatedFromAllocatorRange = Owns(object);
+				assert(isAllocatedFromAllocatorRange && "Pointer was not allocated in the range of this allocator");
+			}
+
+			Slab* slab = GetSlab(object);
+			uint16_t* slots = GetSlots(slab);
+			const uint16_t slot = static_cast<uint16_t>(object - GetObjects(slab));
+
+			{
+				const bool isAllocatedSlot = slots[slot] == ALLOCATED_SLOT;
+				assert(isAllocatedSlot && "Object was already freed");
+			}
+
+			if constexpr (!KEEP_CONSTRUCTED)
+			{
+				object->~T();
+			}
+
+			slots[slot] = slab->firstFreeSlot;
+			slab->firstFreeSlot = slot;
+
+			if (slab->liveCount-- == m_objectsPerSlab)
+			{
+				RemoveSlab(m_fullSlabs, slab);
+				PushSlab(m_partialSlabs, slab);
+			}
+
+			if (slab->liveCount == 0u)
+			{
+				RemoveSlab(m_partialSlabs, slab);
+				if (m_emptySlabs.count < m_maxEmptySlabs)
+				{
+					PushSlab(m_emptySlabs, slab);
+				}
+				else
+				{
+					DecommitSlab(slab);
+				}
+			}
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		void SlabAllocator<T, KEEP_CONSTRUCTED>::ReleaseEmptySlabs(void)
+		{
+			while (Slab* slab = m_emptySlabs.head)
+			{
+				RemoveSlab(m_emptySlabs, slab);
+				DecommitSlab(slab);
+			}
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		SlabAllocatorStatistics SlabAllocator<T, KEEP_CONSTRUCTED>::GetStatistics(void) const
+		{
+			SlabAllocatorStatistics statistics = {};
+			statistics.slabSize = m_slabSize;
+			statistics.objectsPerSlab = m_objectsPerSlab;
+			statistics.partialSlabs = m_partialSlabs.count;
+			statistics.fullSlabs = m_fullSlabs.count;
+			statistics.emptySlabs = m_emptySlabs.count;
+			statistics.committedBytes = (m_partialSlabs.count + m_fullSlabs.count + m_emptySlabs.count) * m_slabSize;
+			statistics.liveObjects = m_fullSlabs.count * m_objectsPerSlab;
+
+			for (const Slab* slab = m_partialSlabs.head; slab; slab = slab->next)
+			{
+				statistics.liveObjects += slab->liveCount;
+			}
+
+			return statistics;
+		}
+
+		///
+		/// Destroys the objects still alive, cached objects included
+		///
+		template <typename T, bool KEEP_CONSTRUCTED>
+		SlabAllocator<T, KEEP_CONSTRUCTED>::~SlabAllocator()
+		{
+			SlabList* lists[] = { &m_partialSlabs, &m_fullSlabs, &m_emptySlabs };
+			for (SlabList* list : lists)
+			{
+				for (Slab* slab = list->head; slab; slab = slab->next)
+				{
+					DestroyObjects(slab);
+				}
+			}
+
+			FreeAddressSpace(m_memoryBegin, m_memoryEnd - m_memoryBegin);
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		void SlabAllocator<T, KEEP_CONSTRUCTED>::PushSlab(SlabList& list, Slab* slab)
+		{
+			slab->previous = nullptr;
+			slab->next = list.head;
+			if (list.head)
+			{
+				list.head->previous = slab;
+			}
+			list.head = slab;
+			++list.count;
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		void SlabAllocator<T, KEEP_CONSTRUCTED>::RemoveSlab(SlabList& list, Slab* slab)
+		{
+			if (slab->previous)
+			{
+				slab->previous->next = slab->next;
+			}
+			else
+			{
+				list.head = slab->next;
+			}
+
+			if (slab->next)
+			{
+				slab->next->previous = slab->previous;
+			}
+			--list.count;
+		}
+
+		///
+		/// Recommits a decommitted slab before touching fresh address space, the new slab
+		/// is put into the empty list. Returns nullptr once the reserved range is used up.
+		///
+		template <typename T, bool KEEP_CONSTRUCTED>
+		typename SlabAllocator<T, KEEP_CONSTRUCTED>::Slab* SlabAllocator<T, KEEP_CONSTRUCTED>::CommitSlab(void)
+		{
+			char* slabMemory = nullptr;
+			if (!m_decommittedSlabs.empty())
+			{
+				slabMemory = m_decommittedSlabs.back();
+				m_decommittedSlabs.pop_back();
+			}
+			else if (m_uncommittedBegin < m_memoryEnd)
+			{
+				slabMemory = m_uncommittedBegin;
+				m_uncommittedBegin += m_slabSize;
+			}
+			else
+			{
+				return nullptr;
+			}
+
+			Slab* slab = static_cast<Slab*>(CommitPhysicalMemory(slabMemory, m_slabSize));
+			slab->liveCount = 0u;
+			slab->firstFreeSlot = 0u;
+
+			uint16_t* slots = GetSlots(slab);
+			for (size_t slot = 0; slot + 1u < m_objectsPerSlab; ++slot)
+			{
+				slots[slot] = static_cast<uint16_t>(slot + 1u);
+			}
+			slots[m_objectsPerSlab - 1u] = END_OF_SLOTS;
+
+			if constexpr (KEEP_CONSTRUCTED)
+			{
+				T* objects = GetObjects(slab);
+				for (size_t slot = 0; slot < m_objectsPerSlab; ++slot)
+				{
+					new (objects + slot) T();
+				}
+			}
+
+			PushSlab(m_emptySlabs, slab);
+			return slab;
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		void SlabAllocator<T, KEEP_CONSTRUCTED>::DecommitSlab(Slab* slab)
+		{
+			DestroyObjects(slab);
+
+			char* slabMemory = pointerUtil::pseudo_cast<char*>(slab, 0);
+			DecommitPhysicalMemory(slabMemory, m_slabSize);
+			m_decommittedSlabs.push_back(slabMemory);
+		}
+
+		///
+		/// Cached objects are always constructed, otherwise only the allocated slots are
+		///
+		template <typename T, bool KEEP_CONSTRUCTED>
+		void SlabAllocator<T, KEEP_CONSTRUCTED>::DestroyObjects(Slab* slab)
+		{
+			const uint16_t* slots = GetSlots(slab);
+			T* objects = GetObjects(slab);
+
+			for (size_t slot = 0; slot < m_objectsPerSlab; ++slot)
+			{
+				if (KEEP_CONSTRUCTED || slots[slot] == ALLOCATED_SLOT)
+				{
+					objects[slot].~T();
+				}
+			}
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		typename SlabAllocator<T, KEEP_CONSTRUCTED>::Slab* SlabAllocator<T, KEEP_CONSTRUCTED>::GetSlab(const T* object) const
+		{
+			const size_t slabIndex = static_cast<size_t>(reinterpret_cast<const char*>(object) - m_memoryBegin) / m_slabSize;
+			return pointerUtil::pseudo_cast<Slab*>(m_memoryBegin + slabIndex * m_slabSize, 0);
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		uint16_t* SlabAllocator<T, KEEP_CONSTRUCTED>::GetSlots(Slab* slab) const
+		{
+			return pointerUtil::pseudo_cast<uint16_t*>(slab, sizeof(Slab));
+		}
+
+		template <typename T, bool KEEP_CONSTRUCTED>
+		T* SlabAllocator<T, KEEP_CONSTRUCTED>::GetObjects(Slab* slab) const
+		{
+			return pointerUtil::pseudo_cast<T*>(slab, m_objectsOffset);
+		}
+
+#pragma endregion
+	}
+}
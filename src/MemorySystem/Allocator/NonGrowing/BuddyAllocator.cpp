@@ -0,0 +1,305 @@
+#include "BuddyAllocator.h"
+
+#include <cassert>
+
+#include "Math/MathUtil.h"
+#include "Pointers/PointerUtil.h"
+#include "../../VirtualMemory/VirtualMemory.h"
+
+namespace
+{
+	struct AllocationHeader
+	{
+		uint32_t allocationSize;
+		uint32_t blockOffset;
+	};
+
+	const uint32_t ALLOCATION_META_SIZE = sizeof(AllocationHeader);
+
+	// Layout of a block state byte, only valid for the first MIN_BLOCK_SIZE bytes of a block
+	const uint8_t BLOCK_FREE_FLAG = 0x80;
+	const uint8_t BLOCK_ORDER_MASK = 0x3F;
+
+	const uint32_t MIN_BLOCK_SIZE_LOG2 = 5;
+
+	///
+	/// Largest order whose region plus block state table (one byte per minimal block)
+	/// fits into the given number of bytes, including the slack to align the region
+	///
+	uint32_t GetLargestFittingOrder(size_t availableBytes)
+	{
+		uint32_t order = 0;
+		while (order + 1 < sp::memory::BuddyAllocatorStatistics::MAX_ORDER_COUNT)
+		{
+			const size_t blockCount = size_t(1) << (order + 1);
+			const size_t requiredBytes = blockCount * sp::memory::BuddyAllocator::MIN_BLOCK_SIZE + blockCount + sp::memory::BuddyAllocator::MIN_BLOCK_SIZE;
+			if (requiredBytes > availableBytes)
+			{
+				break;
+			}
+			++order;
+		}
+		return order;
+	}
+}
+
+const size_t sp::memory::BuddyAllocator::MIN_BLOCK_SIZE;
+const size_t sp::memory::BuddyAllocatorStatistics::MAX_ORDER_COUNT;
+
+double sp::memory::BuddyAllocatorStatistics::GetExternalFragmentation(void) const
+{
+	return freeBytes == 0 ? 0.0 : 1.0 - static_cast<double>(largestFreeBlock) / static_cast<double>(freeBytes);
+}
+
+double sp::memory::BuddyAllocatorStatistics::GetInternalFragmentation(void) const
+{
+	return allocatedBlockBytes == 0 ? 0.0 : 1.0 - static_cast<double>(requestedBytes) / static_cast<double>(allocatedBlockBytes);
+}
+
+///
+/// Reserves a region of size bytes rounded up to the next power-of-two
+/// plus the block state table and commits all of it
+///
+sp::memory::BuddyAllocator::BuddyAllocator(size_t size)
+	: m_useInternalMemory(true)
+{
+	assert(size != 0 && "Cannot intialize an allocator with size 0");
+
+	const size_t regionSize = size <= MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : size_t(2) << math::FloorLog2(size - 1);
+	const size_t reservationSize = math::RoundUp(regionSize + regionSize / MIN_BLOCK_SIZE + MIN_BLOCK_SIZE, GetPageSize());
+
+	char* memory = static_cast<char*>(ReserveAddressSpace(reservationSize, this));
+	memory = static_cast<char*>(CommitPhysicalMemory(memory, reservationSize));
+
+	Initialize(memory, memory + reservationSize);
+}
+
+///
+/// Constructor using a user provided area of memory. The allocator manages the
+/// largest power-of-two region (plus its block state table) fitting into it.
+///
+sp::memory::BuddyAllocator::BuddyAllocator(void* memoryStart, void* memoryEnd)
+	: m_useInternalMemory(false)
+{
+	{
+		const bool isValidMemoryRange = memoryStart < memoryEnd;
+		assert(isValidMemoryRange && "Memory end is not allowed to be lesser or equal than memory start");
+		const bool fitsMinimalBlock = static_cast<size_t>(static_cast<char*>(memoryEnd) - static_cast<char*>(memoryStart)) >= 2 * MIN_BLOCK_SIZE + 1;
+		assert(fitsMinimalBlock && "Memory range is too small to hold a single block");
+	}
+
+	Initialize(static_cast<char*>(memoryStart), static_cast<char*>(memoryEnd));
+}
+
+void* sp::memory::BuddyAllocator::Alloc(size_t size, size_t alignment, size_t offset)
+{
+	assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+	// Blocks start at multiples of MIN_BLOCK_SIZE, the padding for smaller alignments is known up front
+	const size_t offsetBeforeAlignment = offset + ALLOCATION_META_SIZE;
+	const size_t alignmentPadding = alignment <= MIN_BLOCK_SIZE ? math::RoundUp(offsetBeforeAlignment, alignment) - offsetBeforeAlignment : alignment - 1u;
+	const size_t requiredSize = offsetBeforeAlignment + alignmentPadding + size;
+	const uint32_t order = requiredSize <= MIN_BLOCK_SIZE ? 0u : math::FloorLog2(requiredSize - 1) + 1 - MIN_BLOCK_SIZE_LOG2;
+
+	if (order > m_maxOrder)
+	{
+		return nullptr;
+	}
+
+	const uint64_t candidateLists = m_nonEmptyFreeLists & ~((uint64_t(1) << order) - 1u);
+	if (!candidateLists)
+	{
+		return nullptr;
+	}
+
+	// Split the smallest fitting block down to the requested order, the upper halves stay free
+	uint32_t blockOrder = math::CountTrailingZeros(candidateLists);
+	char* block = PopFreeBlock(blockOrder);
+	while (blockOrder > order)
+	{
+		--blockOrder;
+		PushFreeBlock(block + (MIN_BLOCK_SIZE << blockOrder), blockOrder);
+	}
+
+	m_blockStates[GetBlockIndex(block)] = static_cast<uint8_t>(order);
+	m_allocatedBlockBytes += MIN_BLOCK_SIZE << order;
+	m_requestedBytes += size;
+
+	char* allocation = pointerUtil::AlignTop(block + offsetBeforeAlignment, alignment) - offset;
+
+	AllocationHeader* header = pointerUtil::pseudo_cast<AllocationHeader*>(allocation - ALLOCATION_META_SIZE, 0);
+	header->allocationSize = static_cast<uint32_t>(size);
+	header->blockOffset = static_cast<uint32_t>(allocation - ALLOCATION_META_SIZE - block);
+
+	return allocation;
+}
+
+void sp::memory::BuddyAllocator::Dealloc(void* memory)
+{
+	{
+		const bool isNotNull = memory != nullptr;
+		assert(isNotNull && "Freeing a nullptr is not allowed");
+		const bool isAllocatedFromAllocatorRange = memory > m_regionBegin && memory < m_memoryEnd;
+		assert(isAllocatedFromAllocatorRange && "Pointer was not allocated in the range of this allocator");
+	}
+
+	char* headerLocation = static_cast<char*>(memory) - ALLOCATION_META_SIZE;
+	const AllocationHeader* header = pointerUtil::pseudo_cast<AllocationHeader*>(headerLocation, 0);
+
+	size_t blockIndex = GetBlockIndex(headerLocation - header->blockOffset);
+	uint32_t order = m_blockStates[blockIndex] & BLOCK_ORDER_MASK;
+
+	{
+		const bool isAllocatedBlock = (m_blockStates[blockIndex] & BLOCK_FREE_FLAG) == 0;
+		assert(isAllocatedBlock && "Block was already freed");
+	}
+
+	m_allocatedBlockBytes -= MIN_BLOCK_SIZE << order;
+	m_requestedBytes -= header->allocationSize;
+
+	// Merge with the buddy as long as it is a free block of the same order
+	while (order < m_maxOrder)
+	{
+		const size_t buddyIndex = blockIndex ^ (size_t(1) << order);
+		if (m_blockStates[buddyIndex] != (BLOCK_FREE_FLAG | order))
+		{
+			break;
+		}
+
+		RemoveFreeBlock(m_regionBegin + buddyIndex * MIN_BLOCK_SIZE, order);
+		blockIndex &= ~(size_t(1) << order);
+		++order;
+	}
+
+	PushFreeBlock(m_regionBegin + blockIndex * MIN_BLOCK_SIZE, order);
+}
+
+void sp::memory::BuddyAllocator::Reset()
+{
+	for (uint32_t order = 0; order < BuddyAllocatorStatistics::MAX_ORDER_COUNT; ++order)
+	{
+		m_freeLists[order] = nullptr;
+		m_freeBlockCounts[order] = 0u;
+	}
+
+	m_nonEmptyFreeLists = 0u;
+	m_allocatedBlockBytes = 0u;
+	m_requestedBytes = 0u;
+
+	PushFreeBlock(m_regionBegin, m_maxOrder);
+}
+
+size_t sp::memory::BuddyAllocator::GetAllocationSize(void* memory)
+{
+	{
+		const bool isNotNull = memory != nullptr;
+		assert(isNotNull && "Cannot return allocation size of a nullptr");
+	}
+
+	char* userPointer = static_cast<char*>(memory);
+	return pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationSize;
+}
+
+sp::memory::BuddyAllocatorStatistics sp::memory::BuddyAllocator::GetStatistics(void) const
+{
+	BuddyAllocatorStatistics statistics = {};
+	statistics.totalBytes = MIN_BLOCK_SIZE << m_maxOrder;
+	statistics.allocatedBlockBytes = m_allocatedBlockBytes;
+	statistics.requestedBytes = m_requestedBytes;
+	statistics.orderCount = m_maxOrder + 1;
+
+	for (uint32_t order = 0; order <= m_maxOrder; ++order)
+	{
+		statistics.freeBlockCounts[order] = m_freeBlockCounts[order];
+		statistics.freeBytes += m_freeBlockCounts[order] * (MIN_BLOCK_SIZE << order);
+	}
+
+	if (m_nonEmptyFreeLists)
+	{
+		statistics.largestFreeBlock = MIN_BLOCK_SIZE << math::FloorLog2(static_cast<size_t>(m_nonEmptyFreeLists));
+	}
+
+	return statistics;
+}
+
+sp::memory::BuddyAllocator::~BuddyAllocator()
+{
+	if (m_useInternalMemory)
+	{
+		FreeAddressSpace(m_memoryBegin, m_memoryEnd - m_memoryBegin);
+	}
+}
+
+///
+/// The block state table is placed at the front of the range, the region
+/// follows aligned to MIN_BLOCK_SIZE
+///
+void sp::memory::BuddyAllocator::Initialize(char* memoryBegin, char* memoryEnd)
+{
+	m_memoryBegin = memoryBegin;
+	m_memoryEnd = memoryEnd;
+
+	m_maxOrder = GetLargestFittingOrder(memoryEnd - memoryBegin);
+	m_blockStates = pointerUtil::pseudo_cast<uint8_t*>(memoryBegin, 0);
+	m_regionBegin = pointerUtil::AlignTop(memoryBegin + (size_t(1) << m_maxOrder), MIN_BLOCK_SIZE);
+
+	for (size_t blockIndex = 0; blockIndex < (size_t(1) << m_maxOrder); ++blockIndex)
+	{
+		m_blockStates[blockIndex] = 0u;
+	}
+
+	Reset();
+}
+
+void sp::memory::BuddyAllocator::PushFreeBlock(char* block, uint32_t order)
+{
+	FreeBlock* freeBlock = pointerUtil::pseudo_cast<FreeBlock*>(block, 0);
+	freeBlock->previous = nullptr;
+	freeBlock->next = m_freeLists[order];
+
+	if (m_freeLists[order])
+	{
+		m_freeLists[order]->previous = freeBlock;
+	}
+
+	m_freeLists[order] = freeBlock;
+	++m_freeBlockCounts[order];
+	m_nonEmptyFreeLists |= uint64_t(1) << order;
+	m_blockStates[GetBlockIndex(block)] = static_cast<uint8_t>(BLOCK_FREE_FLAG | order);
+}
+
+void sp::memory::BuddyAllocator::RemoveFreeBlock(char* block, uint32_t order)
+{
+	FreeBlock* freeBlock = pointerUtil::pseudo_cast<FreeBlock*>(block, 0);
+
+	if (freeBlock->previous)
+	{
+		freeBlock->previous->next = freeBlock->next;
+	}
+	else
+	{
+		m_freeLists[order] = freeBlock->next;
+	}
+
+	if (freeBlock->next)
+	{
+		freeBlock->next->previous = freeBlock->previous;
+	}
+
+	if (--m_freeBlockCounts[order] == 0u)
+	{
+		m_nonEmptyFreeLists &= ~(uint64_t(1) << order);
+	}
+}
+
+char* sp::memory::BuddyAllocator::PopFreeBlock(uint32_t order)
+{
+	char* block = pointerUtil::pseudo_cast<char*>(m_freeLists[order], 0);
+	RemoveFreeBlock(block, order);
+	return block;
+}
+
+size_t sp::memory::BuddyAllocator::GetBlockIndex(const char* block) const
+{
+	return static_cast<size_t>(block - m_regionBegin) / MIN_BLOCK_SIZE;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../AllocatorBase.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Snapshot of the free blocks of a BuddyAllocator.
+		 *
+		 * External fragmentation is 1 - largestFreeBlock / freeBytes, it is 0 while
+		 * all free memory is one block and approaches 1 when it is scattered into
+		 * many small ones. Internal fragmentation is the share of the handed out
+		 * blocks that is lost to rounding up to a power-of-two.
+		 */
+		struct BuddyAllocatorStatistics
+		{
+			static const size_t MAX_ORDER_COUNT = 40;
+
+			size_t totalBytes;
+			size_t freeBytes;
+			size_t largestFreeBlock;
+			size_t allocatedBlockBytes;
+			size_t requestedBytes;
+			size_t freeBlockCounts[MAX_ORDER_COUNT];
+			uint32_t orderCount;
+
+			double GetExternalFragmentation(void) const;
+			double GetInternalFragmentation(void) const;
+		};
+
+		/**
+		 * A buddy allocator serving variable-sized blocks that can be freed in any order.
+		 *
+		 * The managed region is a power-of-two multiple of MIN_BLOCK_SIZE. Every block has
+		 * an order, a block of order n is MIN_BLOCK_SIZE << n bytes large. Requests are
+		 * rounded up to the next order, larger free blocks are split in halves (buddies)
+		 * on the way down and freed blocks are merged with their buddy again as long as it
+		 * is free as well. Free blocks of every order are kept in an intrusive list and a
+		 * bitmap of non-empty lists, so Alloc() and Dealloc() are O(log n) in the worst case.
+		 *
+		 * The block states are kept in a side table of one byte per MIN_BLOCK_SIZE bytes,
+		 * carved from the front of the memory range.
+		 */
+		class BuddyAllocator : public AllocatorBase
+		{
+		public:
+			static const size_t MIN_BLOCK_SIZE = 32;
+
+			explicit BuddyAllocator(size_t size);
+			BuddyAllocator(void* memoryStart, void* memoryEnd);
+
+			BuddyAllocator(const BuddyAllocator& other) = delete;
+			BuddyAllocator(const BuddyAllocator&& other) = delete;
+			BuddyAllocator operator=(const BuddyAllocator& other) = delete;
+			BuddyAllocator operator=(const BuddyAllocator&& other) = delete;
+
+			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
+			virtual void Dealloc(void* memory) override;
+			virtual void Reset() override;
+
+			virtual size_t GetAllocationSize(void* memory) override;
+
+			/// Free memory per order and fragmentation of the allocator
+			BuddyAllocatorStatistics GetStatistics(void) const;
+
+			virtual ~BuddyAllocator() override;
+
+		private:
+			struct FreeBlock
+			{
+				FreeBlock* previous;
+				FreeBlock* next;
+			};
+
+			void Initialize(char* memoryBegin, char* memoryEnd);
+
+			void PushFreeBlock(char* block, uint32_t order);
+			void RemoveFreeBlock(char* block, uint32_t order);
+			char* PopFreeBlock(uint32_t order);
+
+			size_t GetBlockIndex(const char* block) const;
+
+			bool m_useInternalMemory;
+			char* m_memoryBegin;
+			char* m_memoryEnd;
+
+			char* m_regionBegin;
+			uint32_t m_maxOrder;
+			uint8_t* m_blockStates;
+
+			FreeBlock* m_freeLists[BuddyAllocatorStatistics::MAX_ORDER_COUNT];
+			size_t m_freeBlockCounts[BuddyAllocatorStatistics::MAX_ORDER_COUNT];
+			uint64_t m_nonEmptyFreeLists;
+
+			size_t m_allocatedBlockBytes;
+			size_t m_requestedBytes;
+		};
+	}
+}
@@ -36,7 +36,7 @@ sp::memory::DoubleEndedStackAllocator::DoubleEndedStackAllocator(size_t size)
 {
 	assert(size != 0 && "Cannot intialize an allocator with size 0");
 
-	m_memoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(size), 0);
+	m_memoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(size, this), 0);
 	m_memoryBegin = pointerUtil::pseudo_cast<char*>(CommitPhysicalMemory(m_memoryBegin, size), 0);
 	m_memoryEnd = m_memoryBegin + size;
 	
@@ -225,6 +225,6 @@ sp::memory::DoubleEndedStackAllocator::~DoubleEndedStackAllocator()
 {
 	if (m_usingInternalMemory)
 	{
-		FreeAddressSpace(m_memoryBegin);
+		FreeAddressSpace(m_memoryBegin, m_memoryEnd - m_memoryBegin);
 	}
 }
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+#include "../AllocatorBase.h"
+#include "LinearAllocator.h"
+#include "Pointers/PointerUtil.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/*
+		 * A multi-buffered frame allocator
+		 *
+		 * Keeps FRAME_COUNT linear allocators and allocates from the one of the current
+		 * frame. BeginFrame() moves on to the next one and resets it, so everything
+		 * allocated during a frame stays valid for the following FRAME_COUNT - 1 frames
+		 * and is then released in bulk. With the default of two buffers, data produced
+		 * in frame N (e.g. messages from the simulation to render/IO) can be consumed
+		 * during frame N + 1 without copying and without any per-object Dealloc().
+		 *
+		 * Like the LinearAllocator single allocations cannot be freed.
+		 */
+		template <size_t FRAME_COUNT>
+		class BasicFrameAllocator final : public AllocatorBase
+		{
+			static_assert(FRAME_COUNT >= 2, "A frame allocator needs at least two buffers");
+
+		public:
+			/// Reserves and commits bytesPerFrame for each of the FRAME_COUNT buffers
+			explicit BasicFrameAllocator(size_t bytesPerFrame);
+			/// Splits the user provided range evenly between the buffers
+			BasicFrameAllocator(void* memoryStart, void* memoryEnd);
+
+			BasicFrameAllocator(const BasicFrameAllocator& other) = delete;
+			BasicFrameAllocator(const BasicFrameAllocator&& other) = delete;
+			BasicFrameAllocator operator=(const BasicFrameAllocator& other) = delete;
+			BasicFrameAllocator operator=(const BasicFrameAllocator&& other) = delete;
+
+			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
+			virtual void  Dealloc(void* memory) override;
+			virtual void  Reset() override;
+			virtual size_t GetAllocationSize(void* memory) override;
+
+			/// Switches to the next buffer and releases everything allocated in it FRAME_COUNT frames ago
+			void BeginFrame(void);
+			/// Index of the buffer allocations currently go to
+			size_t GetCurrentBufferIndex(void) const;
+
+			virtual ~BasicFrameAllocator() override;
+
+		private:
+			LinearAllocator& GetBuffer(size_t index);
+
+			alignas(LinearAllocator) char m_bufferStorage[FRAME_COUNT][sizeof(LinearAllocator)];
+			LinearAllocator* m_currentBuffer;
+			size_t m_currentBufferIndex;
+		};
+
+		typedef BasicFrameAllocator<2> FrameAllocator;
+		typedef BasicFrameAllocator<3> TripleBufferedFrameAllocator;
+
+#pragma region Implementation
+
+		template <size_t FRAME_COUNT>
+		BasicFrameAllocator<FRAME_COUNT>::BasicFrameAllocator(size_t bytesPerFrame)
+			: m_currentBuffer(nullptr)
+			, m_currentBufferIndex(0u)
+		{
+			for (size_t idx = 0; idx < FRAME_COUNT; ++idx)
+			{
+				new (m_bufferStorage[idx]) LinearAllocator(bytesPerFrame);
+			}
+
+			m_currentBuffer = &GetBuffer(0u);
+		}
+
+		template <size_t FRAME_COUNT>
+		BasicFrameAllocator<FRAME_COUNT>::BasicFrameAllocator(void* memoryStart, void* memoryEnd)
+			: m_currentBuffer(nullptr)
+			, m_currentBufferIndex(0u)
+		{
+			char* memory = static_cast<char*>(memoryStart);
+			const size_t bytesPerFrame = (static_cast<char*>(memoryEnd) - memory) / FRAME_COUNT;
+
+			{
+				const bool isValidMemoryRange = bytesPerFrame > 0u;
+				assert(isValidMemoryRange && "Memory range is too small to be split between the frame buffers");
+			}
+
+			for (size_t idx = 0; idx < FRAME_COUNT; ++idx)
+			{
+				new (m_bufferStorage[idx]) LinearAllocator(memory, memory + bytesPerFrame);
+				memory += bytesPerFrame;
+			}
+
+			m_currentBuffer = &GetBuffer(0u);
+		}
+
+		template <size_t FRAME_COUNT>
+		inline void* BasicFrameAllocator<FRAME_COUNT>::Alloc(size_t size, size_t alignment, size_t offset)
+		{
+			return m_currentBuffer->Alloc(size, alignment, offset);
+		}
+
+		///
+		/// The allocator does not support freeing single allocations
+		///
+		template <size_t FRAME_COUNT>
+		inline void BasicFrameAllocator<FRAME_COUNT>::Dealloc(void* memory) {}
+
+		///
+		/// Releases all buffers, including the ones of the previous frames
+		///
+		template <size_t FRAME_COUNT>
+		void BasicFrameAllocator<FRAME_COUNT>::Reset()
+		{
+			for (size_t idx = 0; idx < FRAME_COUNT; ++idx)
+			{
+				GetBuffer(idx).Reset();
+			}
+		}
+
+		template <size_t FRAME_COUNT>
+		inline size_t BasicFrameAllocator<FRAME_COUNT>::GetAllocationSize(void* memory)
+		{
+			// The size is stored in front of the allocation, every buffer can read it
+			return m_currentBuffer->GetAllocationSize(memory);
+		}
+
+		template <size_t FRAME_COUNT>
+		void BasicFrameAllocator<FRAME_COUNT>::BeginFrame(void)
+		{
+			m_currentBufferIndex = (m_currentBufferIndex + 1u) % FRAME_COUNT;
+			m_currentBuffer = &GetBuffer(m_currentBufferIndex);
+			m_currentBuffer->Reset();
+		}
+
+		template <size_t FRAME_COUNT>
+		size_t BasicFrameAllocator<FRAME_COUNT>::GetCurrentBufferIndex(void) const
+		{
+			return m_currentBufferIndex;
+		}
+
+		template <size_t FRAME_COUNT>
+		BasicFrameAllocator<FRAME_COUNT>::~BasicFrameAllocator()
+		{
+			for (size_t idx = 0; idx < FRAME_COUNT; ++idx)
+			{
+				GetBuffer(idx).~LinearAllocator();
+			}
+		}
+
+		template <size_t FRAME_COUNT>
+		LinearAllocator& BasicFrameAllocator<FRAME_COUNT>::GetBuffer(size_t index)
+		{
+			return *pointerUtil::pseudo_cast<LinearAllocator*>(m_bufferStorage[index], 0);
+		}
+
+#pragma endregion
+	}
+}
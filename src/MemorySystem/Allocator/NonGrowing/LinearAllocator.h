@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cassert>
+#include <cstdint>
+
 #include "../AllocatorBase.h"
+#include "Pointers/PointerUtil.h"
 
 namespace sp
 {
@@ -12,8 +16,12 @@ namespace sp
 		* to allocator for the user. There is no possibility to
 		* free a single allocation. Only the whole allocator can
 		* be reset.
+		*
+		* Alloc(), Dealloc() and GetAllocationSize() are defined inline, so realms
+		* using the allocator by its concrete type reduce an allocation to the
+		* pointer bump. AllocN() bumps once for a whole batch.
 		*/
-		class LinearAllocator : public AllocatorBase
+		class LinearAllocator final : public AllocatorBase
 		{
 		public:
 			explicit LinearAllocator(size_t size);
@@ -29,13 +37,112 @@ namespace sp
 			virtual void  Reset() override;
 			virtual size_t GetAllocationSize(void* memory) override;
 
+			virtual size_t AllocN(size_t count, size_t size, size_t alignment, size_t offset, void** memory) override;
+			virtual void DeallocN(void* const* memory, size_t count) override;
+
 			virtual ~LinearAllocator() override;
 
 		private:
+			struct AllocationHeader
+			{
+				uint32_t allocationSize;
+			};
+
+			static const uint32_t ALLOCATION_META_SIZE = sizeof(AllocationHeader);
+
 			bool m_useInternalMemory;
 			char* m_memoryBegin;
 			char* m_memoryEnd;
 			char* m_currentPtr;
 		};
+
+#pragma region Implementation
+
+		///
+		/// The Alloc() method of this allocator simply performans a pointer bump to advance
+		/// an internal pointer though the memory region. 
+		/// Alignment is mandatory to be a power-of-two and the offset can be used to 
+		/// properly align blocks with canaries or similar (combined usage with realms)
+		///
+		inline void* LinearAllocator::Alloc(size_t size, size_t alignment, size_t offset)
+		{
+			assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+			m_currentPtr += offset + ALLOCATION_META_SIZE;
+			m_currentPtr = static_cast<char*>(pointerUtil::AlignTop(m_currentPtr, alignment));
+			m_currentPtr -= offset + ALLOCATION_META_SIZE;
+
+			const bool allocationOverflowsRange = m_currentPtr + size + ALLOCATION_META_SIZE > m_memoryEnd;
+			if (allocationOverflowsRange)
+			{
+				return nullptr;
+			}
+
+			union
+			{
+				void* as_void;
+				char* as_char;
+				AllocationHeader* as_header;
+			};
+
+			as_void = m_currentPtr;
+			as_header->allocationSize = static_cast<uint32_t>(size);
+			as_char += ALLOCATION_META_SIZE;
+
+			m_currentPtr += ALLOCATION_META_SIZE + size;
+
+			return as_void;
+		}
+
+		///
+		/// The allocator does not support freeing single allocations
+		///
+		inline void LinearAllocator::Dealloc(void* memory) {}
+
+		///
+		/// Reserves the range for the whole batch with a single bump and hands it out in
+		/// strides. The stride equals the distance consecutive Alloc() calls would have,
+		/// so the layout is the same. Only as many blocks as fit are allocated.
+		///
+		inline size_t LinearAllocator::AllocN(size_t count, size_t size, size_t alignment, size_t offset, void** memory)
+		{
+			assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+			char* firstAllocation = static_cast<char*>(pointerUtil::AlignTop(m_currentPtr + offset + ALLOCATION_META_SIZE, alignment)) - offset;
+			if (count == 0u || firstAllocation + size > m_memoryEnd)
+			{
+				return 0u;
+			}
+
+			const size_t stride = (size + ALLOCATION_META_SIZE + alignment - 1u) & ~(alignment - 1u);
+			const size_t fittingCount = static_cast<size_t>(m_memoryEnd - firstAllocation - size) / stride + 1u;
+			const size_t allocationCount = count < fittingCount ? count : fittingCount;
+
+			char* allocation = firstAllocation;
+			for (size_t idx = 0u; idx < allocationCount; ++idx)
+			{
+				pointerUtil::pseudo_cast<AllocationHeader*>(allocation - ALLOCATION_META_SIZE, 0)->allocationSize = static_cast<uint32_t>(size);
+				memory[idx] = allocation;
+				allocation += stride;
+			}
+
+			m_currentPtr = allocation - stride + size;
+			return allocationCount;
+		}
+
+		inline void LinearAllocator::DeallocN(void* const* memory, size_t count) {}
+
+		inline size_t LinearAllocator::GetAllocationSize(void* memory)
+		{
+			{
+				const bool isNotNull = memory != nullptr;
+				assert(isNotNull && "Cannot return allocation size of a nullptr");
+			}
+
+			char* userPointer = static_cast<char*>(memory);
+			return pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationSize;
+		}
+
+#pragma endregion
 	}
 }
\ No newline at end of file
@@ -25,11 +25,12 @@ namespace
 		uint32_t allocationSize;
 	};
 
-	static const uint32_t ALLOCATION_META_SIZE = sizeof(AllocationHeader);
+	static_assert(sizeof(AllocationHeader) == sizeof(uint32_t), "The pool declares its meta size without seeing the header");
 }
 
 
-sp::memory::PoolAllocator::PoolAllocator(size_t elementMaxSize, size_t elementCount, size_t elementMaxAlignment, size_t offset)
+template <typename FreeListType, bool HEADER_FREE>
+sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::BasicPoolAllocator(size_t elementMaxSize, size_t elementCount, size_t elementMaxAlignment, size_t offset)
 	: m_useInternalMemory(true)
 	, m_memoryBegin(nullptr)
 	, m_memoryEnd(nullptr)
@@ -47,18 +48,19 @@ sp::memory::PoolAllocator::PoolAllocator(size_t elementMaxSize, size_t elementCo
 	// To do se we need to allocate X bytes more to be able to align top at least one time and fulfill the request however
 	const size_t requiredMemorySize = (elementCount * m_minimalChunkSize) + m_maxElementAlignment;
 
-	m_memoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(requiredMemorySize), 0);
+	m_memoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(requiredMemorySize, this), 0);
 	m_memoryBegin = pointerUtil::pseudo_cast<char*>(CommitPhysicalMemory(m_memoryBegin, requiredMemorySize), 0);
 	m_memoryEnd = m_memoryBegin + requiredMemorySize;
 
 	const size_t offsetBeforeAlignment = offset + ALLOCATION_META_SIZE;
 	// Offset the first chunk and align it to ensure all following slots are also aligned
 	m_firstChunkPtr = pointerUtil::AlignTop(m_memoryBegin + offsetBeforeAlignment, m_maxElementAlignment) - offsetBeforeAlignment;
-	m_freeList.~FreeList();
-	new (&m_freeList) core::FreeList(m_firstChunkPtr, m_memoryEnd, m_minimalChunkSize);
+	m_freeList.~FreeListType();
+	new (&m_freeList) FreeListType(m_firstChunkPtr, m_memoryEnd, m_minimalChunkSize);
 }
 
-sp::memory::PoolAllocator::PoolAllocator(void* memoryBegin, void* memoryEnd, size_t elementMaxSize, size_t elementMaxAlignment, size_t offset)
+template <typename FreeListType, bool HEADER_FREE>
+sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::BasicPoolAllocator(void* memoryBegin, void* memoryEnd, size_t elementMaxSize, size_t elementMaxAlignment, size_t offset)
 	: m_useInternalMemory(false)
 	, m_memoryBegin(pointerUtil::pseudo_cast<char*>(memoryBegin, 0))
 	, m_memoryEnd(pointerUtil::pseudo_cast<char*>(memoryEnd, 0))
@@ -75,11 +77,12 @@ sp::memory::PoolAllocator::PoolAllocator(void* memoryBegin, void* memoryEnd, siz
 	const size_t offsetBeforeAlignment = offset + ALLOCATION_META_SIZE;
 	// Offset the first chunk and align it to ensure all following slots are also aligned
 	m_firstChunkPtr = pointerUtil::AlignTop(m_memoryBegin + offsetBeforeAlignment, m_maxElementAlignment) - offsetBeforeAlignment;
-	m_freeList.~FreeList();
-	new (&m_freeList) core::FreeList(m_firstChunkPtr, m_memoryEnd, m_minimalChunkSize);
+	m_freeList.~FreeListType();
+	new (&m_freeList) FreeListType(m_firstChunkPtr, m_memoryEnd, m_minimalChunkSize);
 }
 
-void* sp::memory::PoolAllocator::Alloc(size_t size, size_t alignment, size_t offset)
+template <typename FreeListType, bool HEADER_FREE>
+void* sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::Alloc(size_t size, size_t alignment, size_t offset)
 {
 	{
 		const bool sizeLesserOrEqualMaxElementSize = size <= m_maxElementSize;
@@ -96,13 +99,17 @@ void* sp::memory::PoolAllocator::Alloc(size_t size, size_t alignment, size_t off
 	};
 
 	as_void = m_freeList.GetChunk();
-	as_allocationHeader->allocationSize = static_cast<uint32_t>(size);
-	as_char += ALLOCATION_META_SIZE;
+	if constexpr (!HEADER_FREE)
+	{
+		as_allocationHeader->allocationSize = static_cast<uint32_t>(size);
+		as_char += ALLOCATION_META_SIZE;
+	}
 
 	return as_void;
 }
 
-void sp::memory::PoolAllocator::Dealloc(void* memory)
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::Dealloc(void* memory)
 {
 	{
 		const bool isNotNull = memory != nullptr;
@@ -116,27 +123,134 @@ void sp::memory::PoolAllocator::Dealloc(void* memory)
 	m_freeList.ReturnChunk(originalMemory);
 }
 
-void sp::memory::PoolAllocator::Reset()
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::Reset()
 {
-	m_freeList.~FreeList();
-	new (&m_freeList) core::FreeList(m_firstChunkPtr, m_memoryEnd, m_minimalChunkSize);
+	m_freeList.~FreeListType();
+	new (&m_freeList) FreeListType(m_firstChunkPtr, m_memoryEnd, m_minimalChunkSize);
 }
 
-size_t sp::memory::PoolAllocator::GetAllocationSize(void* memory)
+template <typename FreeListType, bool HEADER_FREE>
+size_t sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::GetAllocationSize(void* memory)
 {
 	{
 		const bool isNotNull = memory != nullptr;
 		assert(isNotNull && "Cannot return allocation size of a nullptr");
 	}
 
+	if constexpr (HEADER_FREE)
+	{
+		return m_maxElementSize;
+	}
+
 	char* userPointer = static_cast<char*>(memory);
 	return pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationSize;
 }
 
-sp::memory::PoolAllocator::~PoolAllocator()
+template <typename FreeListType, bool HEADER_FREE>
+size_t sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::AllocN(size_t count, size_t size, size_t alignment, size_t offset, void** memory)
+{
+	{
+		const bool sizeLesserOrEqualMaxElementSize = size <= m_maxElementSize;
+		assert(sizeLesserOrEqualMaxElementSize && "Allocation size has to be lesser or equal to the maximum element size provided at construction");
+		const bool alignmentLesserOrEqualMaxElementAlignment = alignment <= m_maxElementAlignment;
+		assert(alignmentLesserOrEqualMaxElementAlignment && "Allocation alignment has to be lesser or equal to the maximum element alignment provided at construction");
+	}
+
+	const size_t allocationCount = m_freeList.GetChunks(memory, count);
+	if constexpr (HEADER_FREE)
+	{
+		return allocationCount;
+	}
+
+	for (size_t idx = 0u; idx < allocationCount; ++idx)
+	{
+		char* chunk = pointerUtil::pseudo_cast<char*>(memory[idx], 0);
+		pointerUtil::pseudo_cast<AllocationHeader*>(chunk, 0)->allocationSize = static_cast<uint32_t>(size);
+		memory[idx] = chunk + ALLOCATION_META_SIZE;
+	}
+
+	return allocationCount;
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::DeallocN(void* const* memory, size_t count)
+{
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		{
+			const bool isNotNull = memory[idx] != nullptr;
+			assert(isNotNull && "Freeing a nullptr is not allowed");
+			const bool isAllocatedFromAllocatorRange = memory[idx] >= m_memoryBegin && memory[idx] < m_memoryEnd;
+			assert(isAllocatedFromAllocatorRange && "Pointer was not allocated in the range of this allocator");
+		}
+
+		m_freeList.ReturnChunk(pointerUtil::pseudo_cast<char*>(memory[idx], 0) - ALLOCATION_META_SIZE);
+	}
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+size_t sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::AllocChunks(void** chunks, size_t count)
+{
+	return m_freeList.GetChunks(chunks, count);
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+void sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::DeallocChunks(void* const* chunks, size_t count)
+{
+	m_freeList.ReturnChunks(chunks, count);
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+void* sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::InitializeChunk(void* chunk, size_t size) const
+{
+	{
+		const bool sizeLesserOrEqualMaxElementSize = size <= m_maxElementSize;
+		assert(sizeLesserOrEqualMaxElementSize && "Allocation size has to be lesser or equal to the maximum element size provided at construction");
+	}
+
+	union
+	{
+		char* as_char;
+		void* as_void;
+		AllocationHeader* as_allocationHeader;
+	};
+
+	as_void = chunk;
+	if constexpr (!HEADER_FREE)
+	{
+		as_allocationHeader->allocationSize = static_cast<uint32_t>(size);
+		as_char += ALLOCATION_META_SIZE;
+	}
+
+	return as_void;
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+void* sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::GetChunk(void* memory) const
+{
+	{
+		const bool isAllocatedFromAllocatorRange = memory >= m_memoryBegin && memory < m_memoryEnd;
+		assert(isAllocatedFromAllocatorRange && "Pointer was not allocated in the range of this allocator");
+	}
+
+	return pointerUtil::pseudo_cast<char*>(memory, 0) - ALLOCATION_META_SIZE;
+}
+
+template <typename FreeListType, bool HEADER_FREE>
+sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::~BasicPoolAllocator()
 {
 	if (m_useInternalMemory)
 	{
-		FreeAddressSpace(m_memoryBegin);
+		FreeAddressSpace(m_memoryBegin, m_memoryEnd - m_memoryBegin);
 	}
 }
+
+template <typename FreeListType, bool HEADER_FREE>
+const uint32_t sp::memory::BasicPoolAllocator<FreeListType, HEADER_FREE>::ALLOCATION_META_SIZE;
+
+template class sp::memory::BasicPoolAllocator<sp::core::FreeList, false>;
+template class sp::memory::BasicPoolAllocator<sp::core::ConcurrentFreeList, false>;
+template class sp::memory::BasicPoolAllocator<sp::core::RemoteFreeList, false>;
+template class sp::memory::BasicPoolAllocator<sp::core::FreeList, true>;
+template class sp::memory::BasicPoolAllocator<sp::core::ConcurrentFreeList, true>;
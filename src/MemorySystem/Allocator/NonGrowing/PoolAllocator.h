@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+
 #include "../AllocatorBase.h"
 #include "FreeList/FreeList.h"
+#include "FreeList/ConcurrentFreeList.h"
+#include "FreeList/RemoteFreeList.h"
 
 namespace sp
 {
@@ -11,27 +15,69 @@ namespace sp
 		 * This pool allocator is able to fulfill memory allocations and deallocations of
 		 * equally-sized objects in O(1). It uses a freelist to manage the free slots in
 		 * the internal memory block. Freeing is allowed in any order. 
+		 *
+		 * The free list implementation is a template parameter. With the lock-free
+		 * ConcurrentFreeList, Alloc() and Dealloc() may be called from many threads
+		 * at once, Reset() still requires exclusive access. With the RemoteFreeList
+		 * only the thread that constructed or last reset the pool may call Alloc(),
+		 * but any thread may Dealloc(). Frees from other threads are pushed onto a
+		 * remote list with a single atomic operation and the owner takes them over
+		 * once its own chunks run out, so producer/consumer pipelines need no lock.
+		 * All variants are explicitly instantiated in the .cpp.
+		 *
+		 * By default every chunk starts with a small header holding the requested
+		 * size. With HEADER_FREE the header is dropped and chunks are only as large
+		 * as the maximum element size rounded up to the alignment, e.g. 16 instead of
+		 * 32 bytes for 16-byte objects. The size of a block is then implied by the pool,
+		 * GetAllocationSize() returns the maximum element size and HAS_EXACT_ALLOCATION_SIZE
+		 * is false. Realms reject such pools together with canaries, trackers or taggers.
+		 * The owner of a pointer can be found with Owns().
 		 */
-		class PoolAllocator : public AllocatorBase
+		template <typename FreeListType, bool HEADER_FREE = false>
+		class BasicPoolAllocator : public AllocatorBase
 		{
 		public:
-			PoolAllocator(size_t elementMaxSize, size_t elementCount, size_t elementMaxAlignment, size_t offset);
-			PoolAllocator(void* memoryBegin, void* memoryEnd, size_t elementMaxSize, size_t elementMaxAlignment, size_t offset);
+			static constexpr bool HAS_EXACT_ALLOCATION_SIZE = !HEADER_FREE;
+
+			BasicPoolAllocator(size_t elementMaxSize, size_t elementCount, size_t elementMaxAlignment, size_t offset);
+			BasicPoolAllocator(void* memoryBegin, void* memoryEnd, size_t elementMaxSize, size_t elementMaxAlignment, size_t offset);
 
-			PoolAllocator(const PoolAllocator& other) = delete;
-			PoolAllocator(const PoolAllocator&& other) = delete;
-			PoolAllocator operator=(const PoolAllocator& other) = delete;
-			PoolAllocator operator=(const PoolAllocator&& other) = delete;
+			BasicPoolAllocator(const BasicPoolAllocator& other) = delete;
+			BasicPoolAllocator(const BasicPoolAllocator&& other) = delete;
+			BasicPoolAllocator operator=(const BasicPoolAllocator& other) = delete;
+			BasicPoolAllocator operator=(const BasicPoolAllocator&& other) = delete;
 
 			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
 			virtual void Dealloc(void* memory) override;
 			virtual void Reset() override;
 
 			virtual size_t GetAllocationSize(void* memory) override;
-			
-			virtual inline ~PoolAllocator() override;
+
+			/// Unlinks the chunks of a whole batch from the free list at once
+			virtual size_t AllocN(size_t count, size_t size, size_t alignment, size_t offset, void** memory) override;
+			virtual void DeallocN(void* const* memory, size_t count) override;
+
+			/**
+			 * Chunk-level access for front-ends that cache chunks themselves (e.g. the
+			 * ThreadCachingPoolAllocator). A chunk is the raw slot including its header,
+			 * InitializeChunk() turns it into a user pointer and GetChunk() reverses this.
+			 * Like the rest of the allocator these calls are not synchronized.
+			 */
+			size_t AllocChunks(void** chunks, size_t count);
+			void DeallocChunks(void* const* chunks, size_t count);
+			void* InitializeChunk(void* chunk, size_t size) const;
+			size_t GetMaxElementAlignment(void) const { return m_maxElementAlignment; }
+			void* GetChunk(void* memory) const;
+
+			/// True if the pointer lies inside the memory range of this pool
+			bool Owns(const void* memory) const { return memory >= m_memoryBegin && memory < m_memoryEnd; }
+
+			virtual ~BasicPoolAllocator() override;
 
 		private:
+			// Size of the AllocationHeader in front of every user pointer
+			static const uint32_t ALLOCATION_META_SIZE = HEADER_FREE ? 0u : sizeof(uint32_t);
+
 			bool m_useInternalMemory;
 
 			char* m_memoryBegin;
@@ -42,7 +88,13 @@ namespace sp
 			const size_t m_maxElementAlignment;
 			const size_t m_minimalChunkSize;
 
-			core::FreeList m_freeList;
+			FreeListType m_freeList;
 		};
+
+		typedef BasicPoolAllocator<core::FreeList> PoolAllocator;
+		typedef BasicPoolAllocator<core::ConcurrentFreeList> ConcurrentPoolAllocator;
+		typedef BasicPoolAllocator<core::RemoteFreeList> RemoteFreePoolAllocator;
+		typedef BasicPoolAllocator<core::FreeList, true> HeaderFreePoolAllocator;
+		typedef BasicPoolAllocator<core::ConcurrentFreeList, true> ConcurrentHeaderFreePoolAllocator;
 	}
 }
@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#include "Math/MathUtil.h"
 #include "Pointers/PointerUtil.h"
 #include "../../VirtualMemory/VirtualMemory.h"
 
@@ -37,7 +38,7 @@ sp::memory::StackAllocator::StackAllocator(size_t size)
 {
 	assert(size != 0 && "Cannot intialize an allocator with size 0");
 
-	m_memoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(size), 0);
+	m_memoryBegin = pointerUtil::pseudo_cast<char*>(ReserveAddressSpace(size, this), 0);
 	m_memoryBegin = pointerUtil::pseudo_cast<char*>(CommitPhysicalMemory(m_memoryBegin, size), 0);
 	m_memoryEnd = m_memoryBegin + size;
 	m_currentPtr = m_memoryBegin;
@@ -143,10 +144,91 @@ size_t sp::memory::StackAllocator::GetAllocationSize(void* memory)
 	return pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationSize;
 }
 
+size_t sp::memory::StackAllocator::AllocN(size_t count, size_t size, size_t alignment, size_t offset, void** memory)
+{
+	assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+	char* firstAllocation = static_cast<char*>(pointerUtil::AlignTop(m_currentPtr + offset + ALLOCATION_META_SIZE, alignment)) - offset;
+	if (count == 0u || firstAllocation + size > m_memoryEnd)
+	{
+		return 0u;
+	}
+
+	const size_t stride = math::RoundUp(size + ALLOCATION_META_SIZE, alignment);
+	const size_t fittingCount = static_cast<size_t>(m_memoryEnd - firstAllocation - size) / stride + 1u;
+	const size_t allocationCount = count < fittingCount ? count : fittingCount;
+
+	// Every block remembers the top of the stack before it, like a single Alloc() would
+	char* previousTop = m_currentPtr;
+	char* allocation = firstAllocation;
+	for (size_t idx = 0u; idx < allocationCount; ++idx)
+	{
+		AllocationHeader* header = pointerUtil::pseudo_cast<AllocationHeader*>(allocation - ALLOCATION_META_SIZE, 0);
+		header->allocationOffset = static_cast<uint32_t>(previousTop - m_memoryBegin);
+		header->allocationSize = static_cast<uint32_t>(size);
+#ifdef STACK_ALLOC_LIFO_CHECKS
+		header->allocationId = ++m_allocationID;
+#endif
+		memory[idx] = allocation;
+		previousTop = allocation + size;
+		allocation += stride;
+	}
+
+	m_currentPtr = previousTop;
+	return allocationCount;
+}
+
+void sp::memory::StackAllocator::DeallocN(void* const* memory, size_t count)
+{
+	if (count == 0u)
+	{
+		return;
+	}
+
+	char* lowestAllocation = m_memoryEnd;
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		{
+			const bool isNotNull = memory[idx] != nullptr;
+			assert(isNotNull && "Memory shall not be a nullptr");
+			const bool userPointerInAllocatorRange = memory[idx] >= m_memoryBegin && memory[idx] <= m_memoryEnd;
+			assert(userPointerInAllocatorRange && "UserPointer was not allocared by this allocator. Not in memory range.");
+		}
+
+		char* allocation = pointerUtil::pseudo_cast<char*>(memory[idx], 0);
+		lowestAllocation = allocation < lowestAllocation ? allocation : lowestAllocation;
+	}
+
+	const AllocationHeader* header = pointerUtil::pseudo_cast<AllocationHeader*>(lowestAllocation - ALLOCATION_META_SIZE, 0);
+#ifdef STACK_ALLOC_LIFO_CHECKS
+	{
+		const bool wasFreedInLIFOFashion = header->allocationId + count - 1u == m_allocationID;
+		assert(wasFreedInLIFOFashion && "Freed other than the last allocations. Stack allocator does only support freeing in LIFO order.");
+		m_allocationID -= static_cast<uint32_t>(count);
+	}
+#endif
+	m_currentPtr = m_memoryBegin + header->allocationOffset;
+}
+
+sp::memory::StackAllocator::Marker sp::memory::StackAllocator::GetMarker(void) const
+{
+	return m_currentPtr - m_memoryBegin;
+}
+
+void sp::memory::StackAllocator::FreeToMarker(Marker marker)
+{
+	{
+		const bool markerBelowTop = marker <= GetMarker();
+		assert(markerBelowTop && "Marker lies above the top of the stack, it was already freed");
+	}
+
+	m_currentPtr = m_memoryBegin + marker;
+}
+
 sp::memory::StackAllocator::~StackAllocator()
 {
 	if (m_usingInternalMemory)
 	{
-		FreeAddressSpace(m_memoryBegin);
+		FreeAddressSpace(m_memoryBegin, m_memoryEnd - m_memoryBegin);
 	}
 }
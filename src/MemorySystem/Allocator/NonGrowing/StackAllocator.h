@@ -12,10 +12,16 @@ namespace sp
 		 * The stack base allocator allows freeing single allocations in a last-in-first-out
 		 * order. A LIFO check can be enabled via #define that checks the validity of that
 		 * order on every deallocation by introducing a small overhead.
+		 *
+		 * GetMarker()/FreeToMarker() release all allocations made after the marker
+		 * was taken in O(1), see the GrowingStackAllocator for a variant that grows.
 		 */
 		class StackAllocator : public AllocatorBase
 		{
 		public:
+			/// Top of the stack, as returned by GetMarker()
+			typedef size_t Marker;
+
 			explicit StackAllocator(size_t size);
 			StackAllocator(void* memoryStart, void* memoryEnd);
 
@@ -29,6 +35,14 @@ namespace sp
 			virtual void Reset() override;
 			virtual size_t GetAllocationSize(void* memory) override;
 
+			/// Bumps once for the whole batch, the blocks lie in strides like consecutive Alloc() calls
+			virtual size_t AllocN(size_t count, size_t size, size_t alignment, size_t offset, void** memory) override;
+			/// Frees a batch on top of the stack in any order, it is released down to its lowest block
+			virtual void DeallocN(void* const* memory, size_t count) override;
+
+			Marker GetMarker(void) const;
+			void FreeToMarker(Marker marker);
+
 			virtual ~StackAllocator() override;
 		private:
 			bool m_usingInternalMemory;
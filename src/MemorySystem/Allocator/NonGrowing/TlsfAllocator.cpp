@@ -0,0 +1,388 @@
+#include "TlsfAllocator.h"
+
+#include <cassert>
+
+#include "Math/MathUtil.h"
+#include "Pointers/PointerUtil.h"
+#include "../../VirtualMemory/VirtualMemory.h"
+
+///
+/// Every block starts with this header, the payload follows directly. The free list
+/// links are only valid while the block is free and overlay the first payload bytes.
+/// Physical neighbours are reached by the size (next) and the back pointer (previous).
+/// The region ends with a used sentinel block of size 0, so merging never runs past it.
+///
+struct sp::memory::TlsfAllocator::BlockHeader
+{
+	BlockHeader* previousPhysical;
+	size_t sizeAndFlags;
+
+	BlockHeader* previousFree;
+	BlockHeader* nextFree;
+};
+
+namespace
+{
+	struct AllocationHeader
+	{
+		uint32_t allocationSize;
+		uint32_t payloadOffset;
+	};
+
+	const uint32_t ALLOCATION_META_SIZE = sizeof(AllocationHeader);
+
+	const size_t BLOCK_FREE_FLAG = 1u;
+	const size_t BLOCK_SIZE_MASK = ~size_t(7);
+
+	const size_t ALIGN_SIZE = 8;
+	const size_t BLOCK_OVERHEAD = 2 * sizeof(void*);
+	const size_t MIN_PAYLOAD_SIZE = 2 * sizeof(void*);
+	const size_t MAX_BLOCK_SIZE = (size_t(1) << 32) - ALIGN_SIZE;
+
+	typedef sp::memory::TlsfAllocator Tlsf;
+
+	const size_t SMALL_BLOCK_SIZE = size_t(1) << (Tlsf::SECOND_LEVEL_COUNT_LOG2 + 3);
+
+	///
+	/// Index of the list a block of the given size is stored in
+	///
+	void MapInsert(size_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+	{
+		if (size < SMALL_BLOCK_SIZE)
+		{
+			firstLevel = 0u;
+			secondLevel = static_cast<uint32_t>(size / (SMALL_BLOCK_SIZE / Tlsf::SECOND_LEVEL_COUNT));
+		}
+		else
+		{
+			const uint32_t log2 = sp::math::FloorLog2(size);
+			secondLevel = static_cast<uint32_t>(size >> (log2 - Tlsf::SECOND_LEVEL_COUNT_LOG2)) ^ Tlsf::SECOND_LEVEL_COUNT;
+			firstLevel = log2 - (Tlsf::SECOND_LEVEL_COUNT_LOG2 + 3 - 1);
+		}
+	}
+
+	///
+	/// Rounds the size up to the next list boundary first, so every block in the
+	/// list found is large enough and no list has to be searched
+	///
+	void MapSearch(size_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+	{
+		if (size >= SMALL_BLOCK_SIZE)
+		{
+			size += (size_t(1) << (sp::math::FloorLog2(size) - Tlsf::SECOND_LEVEL_COUNT_LOG2)) - 1u;
+		}
+
+		MapInsert(size, firstLevel, secondLevel);
+	}
+
+	size_t GetSize(size_t sizeAndFlags)
+	{
+		return sizeAndFlags & BLOCK_SIZE_MASK;
+	}
+}
+
+const uint32_t sp::memory::TlsfAllocator::SECOND_LEVEL_COUNT_LOG2;
+const uint32_t sp::memory::TlsfAllocator::SECOND_LEVEL_COUNT;
+
+sp::memory::TlsfAllocator::TlsfAllocator(size_t size)
+	: m_useInternalMemory(true)
+{
+	assert(size != 0 && "Cannot intialize an allocator with size 0");
+
+	const size_t reservationSize = math::RoundUp(size + 3 * BLOCK_OVERHEAD, GetPageSize());
+	char* memory = static_cast<char*>(ReserveAddressSpace(reservationSize, this));
+	memory = static_cast<char*>(CommitPhysicalMemory(memory, reservationSize));
+
+	Initialize(memory, memory + reservationSize);
+}
+
+sp::memory::TlsfAllocator::TlsfAllocator(void* memoryStart, void* memoryEnd)
+	: m_useInternalMemory(false)
+{
+	{
+		const bool isValidMemoryRange = memoryStart < memoryEnd;
+		assert(isValidMemoryRange && "Memory end is not allowed to be lesser or equal than memory start");
+		const bool fitsMinimalBlock = static_cast<size_t>(static_cast<char*>(memoryEnd) - static_cast<char*>(memoryStart)) >= 2 * BLOCK_OVERHEAD + MIN_PAYLOAD_SIZE + ALIGN_SIZE;
+		assert(fitsMinimalBlock && "Memory range is too small to hold a single block");
+	}
+
+	Initialize(static_cast<char*>(memoryStart), static_cast<char*>(memoryEnd));
+}
+
+void* sp::memory::TlsfAllocator::Alloc(size_t size, size_t alignment, size_t offset)
+{
+	assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+	// Payloads start at multiples of ALIGN_SIZE, the padding for smaller alignments is known up front
+	const size_t offsetBeforeAlignment = offset + ALLOCATION_META_SIZE;
+	const size_t alignmentPadding = alignment <= ALIGN_SIZE ? math::RoundUp(offsetBeforeAlignment, alignment) - offsetBeforeAlignment : alignment - 1u;
+	const size_t requiredSize = offsetBeforeAlignment + alignmentPadding + size;
+
+	if (requiredSize > MAX_BLOCK_SIZE)
+	{
+		return nullptr;
+	}
+
+	const size_t payloadSize = requiredSize < MIN_PAYLOAD_SIZE ? MIN_PAYLOAD_SIZE : math::RoundUp(requiredSize, ALIGN_SIZE);
+
+	BlockHeader* block = FindFreeBlock(payloadSize);
+	if (!block)
+	{
+		return nullptr;
+	}
+
+	RemoveFreeBlock(block);
+
+	// Split off the tail if it is large enough to form a block on its own
+	const size_t blockSize = GetSize(block->sizeAndFlags);
+	if (blockSize >= payloadSize + BLOCK_OVERHEAD + MIN_PAYLOAD_SIZE)
+	{
+		BlockHeader* remainder = pointerUtil::pseudo_cast<BlockHeader*>(block, BLOCK_OVERHEAD + payloadSize);
+		remainder->previousPhysical = block;
+		remainder->sizeAndFlags = (blockSize - payloadSize - BLOCK_OVERHEAD) | BLOCK_FREE_FLAG;
+
+		BlockHeader* next = pointerUtil::pseudo_cast<BlockHeader*>(remainder, BLOCK_OVERHEAD + GetSize(remainder->sizeAndFlags));
+		next->previousPhysical = remainder;
+
+		block->sizeAndFlags = payloadSize;
+		InsertFreeBlock(remainder);
+	}
+	else
+	{
+		block->sizeAndFlags = blockSize;
+	}
+
+	char* payload = pointerUtil::pseudo_cast<char*>(block, BLOCK_OVERHEAD);
+	char* allocation = pointerUtil::AlignTop(payload + offsetBeforeAlignment, alignment) - offset;
+
+	AllocationHeader* header = pointerUtil::pseudo_cast<AllocationHeader*>(allocation - ALLOCATION_META_SIZE, 0);
+	header->allocationSize = static_cast<uint32_t>(size);
+	header->payloadOffset = static_cast<uint32_t>(allocation - ALLOCATION_META_SIZE - payload);
+
+	return allocation;
+}
+
+void sp::memory::TlsfAllocator::Dealloc(void* memory)
+{
+	{
+		const bool isNotNull = memory != nullptr;
+		assert(isNotNull && "Freeing a nullptr is not allowed");
+		const bool isAllocatedFromAllocatorRange = memory > m_memoryBegin && memory < m_memoryEnd;
+		assert(isAllocatedFromAllocatorRange && "Pointer was not allocated in the range of this allocator");
+	}
+
+	char* headerLocation = static_cast<char*>(memory) - ALLOCATION_META_SIZE;
+	const AllocationHeader* header = pointerUtil::pseudo_cast<AllocationHeader*>(headerLocation, 0);
+	BlockHeader* block = pointerUtil::pseudo_cast<BlockHeader*>(headerLocation - header->payloadOffset - BLOCK_OVERHEAD, 0);
+
+	{
+		const bool isAllocatedBlock = (block->sizeAndFlags & BLOCK_FREE_FLAG) == 0;
+		assert(isAllocatedBlock && "Block was already freed");
+	}
+
+	block->sizeAndFlags |= BLOCK_FREE_FLAG;
+	block = MergeWithPrevious(block);
+	MergeWithNext(block);
+	InsertFreeBlock(block);
+}
+
+void sp::memory::TlsfAllocator::Reset()
+{
+	m_firstLevelBitmap = 0u;
+	for (uint32_t firstLevel = 0; firstLevel < FIRST_LEVEL_COUNT; ++firstLevel)
+	{
+		m_secondLevelBitmaps[firstLevel] = 0u;
+		for (uint32_t secondLevel = 0; secondLevel < SECOND_LEVEL_COUNT; ++secondLevel)
+		{
+			m_freeLists[firstLevel][secondLevel] = nullptr;
+		}
+	}
+
+	// One free block spanning the whole range, followed by the sentinel
+	char* alignedEnd = pointerUtil::pseudo_cast<char*>(pointerUtil::AlignBottom(m_memoryEnd, ALIGN_SIZE), 0);
+	char* firstBlockBegin = pointerUtil::pseudo_cast<char*>(m_firstBlock, 0);
+	size_t firstBlockSize = (alignedEnd - firstBlockBegin) - 2 * BLOCK_OVERHEAD;
+	if (firstBlockSize > MAX_BLOCK_SIZE)
+	{
+		firstBlockSize = MAX_BLOCK_SIZE;
+	}
+
+	m_firstBlock->previousPhysical = nullptr;
+	m_firstBlock->sizeAndFlags = firstBlockSize | BLOCK_FREE_FLAG;
+
+	BlockHeader* sentinel = pointerUtil::pseudo_cast<BlockHeader*>(m_firstBlock, BLOCK_OVERHEAD + firstBlockSize);
+	sentinel->previousPhysical = m_firstBlock;
+	sentinel->sizeAndFlags = 0u;
+
+	InsertFreeBlock(m_firstBlock);
+}
+
+size_t sp::memory::TlsfAllocator::GetAllocationSize(void* memory)
+{
+	{
+		const bool isNotNull = memory != nullptr;
+		assert(isNotNull && "Cannot return allocation size of a nullptr");
+	}
+
+	char* userPointer = static_cast<char*>(memory);
+	return pointerUtil::pseudo_cast<AllocationHeader*>(userPointer - ALLOCATION_META_SIZE, 0)->allocationSize;
+}
+
+size_t sp::memory::TlsfAllocator::GetFreeSize(void) const
+{
+	size_t freeSize = 0u;
+	for (const BlockHeader* block = m_firstBlock; GetSize(block->sizeAndFlags) != 0u;
+		block = pointerUtil::pseudo_cast<const BlockHeader*>(block, BLOCK_OVERHEAD + GetSize(block->sizeAndFlags)))
+	{
+		if (block->sizeAndFlags & BLOCK_FREE_FLAG)
+		{
+			freeSize += GetSize(block->sizeAndFlags);
+		}
+	}
+	return freeSize;
+}
+
+size_t sp::memory::TlsfAllocator::GetLargestFreeBlockSize(void) const
+{
+	if (!m_firstLevelBitmap)
+	{
+		return 0u;
+	}
+
+	// Only the blocks of the highest non-empty list have to be compared
+	const uint32_t firstLevel = math::FloorLog2(m_firstLevelBitmap);
+	const uint32_t secondLevel = math::FloorLog2(m_secondLevelBitmaps[firstLevel]);
+
+	size_t largestSize = 0u;
+	for (const BlockHeader* block = m_freeLists[firstLevel][secondLevel]; block; block = block->nextFree)
+	{
+		const size_t blockSize = GetSize(block->sizeAndFlags);
+		largestSize = blockSize > largestSize ? blockSize : largestSize;
+	}
+	return largestSize;
+}
+
+sp::memory::TlsfAllocator::~TlsfAllocator()
+{
+	if (m_useInternalMemory)
+	{
+		FreeAddressSpace(m_memoryBegin, m_memoryEnd - m_memoryBegin);
+	}
+}
+
+void sp::memory::TlsfAllocator::Initialize(char* memoryBegin, char* memoryEnd)
+{
+	m_memoryBegin = memoryBegin;
+	m_memoryEnd = memoryEnd;
+	m_firstBlock = pointerUtil::pseudo_cast<BlockHeader*>(pointerUtil::AlignTop(memoryBegin, ALIGN_SIZE), 0);
+
+	Reset();
+}
+
+void sp::memory::TlsfAllocator::InsertFreeBlock(BlockHeader* block)
+{
+	uint32_t firstLevel = 0u;
+	uint32_t secondLevel = 0u;
+	MapInsert(GetSize(block->sizeAndFlags), firstLevel, secondLevel);
+
+	BlockHeader*& head = m_freeLists[firstLevel][secondLevel];
+	block->previousFree = nullptr;
+	block->nextFree = head;
+	if (head)
+	{
+		head->previousFree = block;
+	}
+	head = block;
+
+	m_firstLevelBitmap |= 1u << firstLevel;
+	m_secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+}
+
+void sp::memory::TlsfAllocator::RemoveFreeBlock(BlockHeader* block)
+{
+	uint32_t firstLevel = 0u;
+	uint32_t secondLevel = 0u;
+	MapInsert(GetSize(block->sizeAndFlags), firstLevel, secondLevel);
+
+	if (block->nextFree)
+	{
+		block->nextFree->previousFree = block->previousFree;
+	}
+
+	if (block->previousFree)
+	{
+		block->previousFree->nextFree = block->nextFree;
+	}
+	else
+	{
+		m_freeLists[firstLevel][secondLevel] = block->nextFree;
+		if (!block->nextFree)
+		{
+			m_secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+			if (!m_secondLevelBitmaps[firstLevel])
+			{
+				m_firstLevelBitmap &= ~(1u << firstLevel);
+			}
+		}
+	}
+}
+
+sp::memory::TlsfAllocator::BlockHeader* sp::memory::TlsfAllocator::FindFreeBlock(size_t size)
+{
+	uint32_t firstLevel = 0u;
+	uint32_t secondLevel = 0u;
+	MapSearch(size, firstLevel, secondLevel);
+
+	if (firstLevel >= FIRST_LEVEL_COUNT)
+	{
+		return nullptr;
+	}
+
+	// First a list of the same range with larger blocks, then the smallest larger range
+	uint32_t secondLevelMap = m_secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+	if (!secondLevelMap)
+	{
+		const uint32_t firstLevelMap = firstLevel + 1 < 32 ? m_firstLevelBitmap & (~0u << (firstLevel + 1)) : 0u;
+		if (!firstLevelMap)
+		{
+			return nullptr;
+		}
+
+		firstLevel = math::CountTrailingZeros(firstLevelMap);
+		secondLevelMap = m_secondLevelBitmaps[firstLevel];
+	}
+
+	secondLevel = math::CountTrailingZeros(secondLevelMap);
+	return m_freeLists[firstLevel][secondLevel];
+}
+
+sp::memory::TlsfAllocator::BlockHeader* sp::memory::TlsfAllocator::MergeWithPrevious(BlockHeader* block)
+{
+	BlockHeader* previous = block->previousPhysical;
+	if (!previous || !(previous->sizeAndFlags & BLOCK_FREE_FLAG))
+	{
+		return block;
+	}
+
+	RemoveFreeBlock(previous);
+	previous->sizeAndFlags += GetSize(block->sizeAndFlags) + BLOCK_OVERHEAD;
+
+	BlockHeader* next = pointerUtil::pseudo_cast<BlockHeader*>(previous, BLOCK_OVERHEAD + GetSize(previous->sizeAndFlags));
+	next->previousPhysical = previous;
+	return previous;
+}
+
+void sp::memory::TlsfAllocator::MergeWithNext(BlockHeader* block)
+{
+	BlockHeader* next = pointerUtil::pseudo_cast<BlockHeader*>(block, BLOCK_OVERHEAD + GetSize(block->sizeAndFlags));
+	if (!(next->sizeAndFlags & BLOCK_FREE_FLAG))
+	{
+		return;
+	}
+
+	RemoveFreeBlock(next);
+	block->sizeAndFlags += GetSize(next->sizeAndFlags) + BLOCK_OVERHEAD;
+
+	BlockHeader* afterNext = pointerUtil::pseudo_cast<BlockHeader*>(block, BLOCK_OVERHEAD + GetSize(block->sizeAndFlags));
+	afterNext->previousPhysical = block;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../AllocatorBase.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * A two-level segregated fit (TLSF) allocator for variable-sized blocks with
+		 * bounded latency. Alloc() and Dealloc() are O(1): free blocks are kept in lists
+		 * segregated by a first level (power-of-two range) and a second level (linear
+		 * subdivision of that range into SECOND_LEVEL_COUNT lists). Two levels of bitmaps
+		 * mark the non-empty lists, finding a fitting one takes two bit-scans. Freed blocks
+		 * are immediately merged with their free physical neighbours.
+		 *
+		 * Requests are rounded up to the next list size, which bounds the memory wasted
+		 * to 1 / SECOND_LEVEL_COUNT of the block (about 3 %).
+		 *
+		 * The allocator works inside a caller-provided memory range as well as in its
+		 * own reservation. Blocks are limited to 4 GiB like in the other allocators.
+		 */
+		class TlsfAllocator : public AllocatorBase
+		{
+		public:
+			static const uint32_t SECOND_LEVEL_COUNT_LOG2 = 5;
+			static const uint32_t SECOND_LEVEL_COUNT = 1u << SECOND_LEVEL_COUNT_LOG2;
+
+			explicit TlsfAllocator(size_t size);
+			TlsfAllocator(void* memoryStart, void* memoryEnd);
+
+			TlsfAllocator(const TlsfAllocator& other) = delete;
+			TlsfAllocator(const TlsfAllocator&& other) = delete;
+			TlsfAllocator operator=(const TlsfAllocator& other) = delete;
+			TlsfAllocator operator=(const TlsfAllocator&& other) = delete;
+
+			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
+			virtual void Dealloc(void* memory) override;
+			virtual void Reset() override;
+
+			virtual size_t GetAllocationSize(void* memory) override;
+
+			/// Sum of the payloads of all free blocks, walks all blocks and is meant for diagnostics
+			size_t GetFreeSize(void) const;
+			/// Payload of the largest free block, an upper bound for the next allocation
+			size_t GetLargestFreeBlockSize(void) const;
+
+			virtual ~TlsfAllocator() override;
+
+		private:
+			struct BlockHeader;
+
+			static const uint32_t ALIGN_SIZE_LOG2 = 3;
+			static const uint32_t FIRST_LEVEL_SHIFT = SECOND_LEVEL_COUNT_LOG2 + ALIGN_SIZE_LOG2;
+			static const uint32_t FIRST_LEVEL_MAX = 32;
+			static const uint32_t FIRST_LEVEL_COUNT = FIRST_LEVEL_MAX - FIRST_LEVEL_SHIFT + 1;
+
+			void Initialize(char* memoryBegin, char* memoryEnd);
+
+			void InsertFreeBlock(BlockHeader* block);
+			void RemoveFreeBlock(BlockHeader* block);
+			BlockHeader* FindFreeBlock(size_t size);
+
+			BlockHeader* MergeWithPrevious(BlockHeader* block);
+			void MergeWithNext(BlockHeader* block);
+
+			bool m_useInternalMemory;
+			char* m_memoryBegin;
+			char* m_memoryEnd;
+			BlockHeader* m_firstBlock;
+
+			uint32_t m_firstLevelBitmap;
+			uint32_t m_secondLevelBitmaps[FIRST_LEVEL_COUNT];
+			BlockHeader* m_freeLists[FIRST_LEVEL_COUNT][SECOND_LEVEL_COUNT];
+		};
+	}
+}
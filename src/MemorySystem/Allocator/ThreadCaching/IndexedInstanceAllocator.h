@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#include "../AllocatorBase.h"
+#include "Pointers/PointerUtil.h"
+#include "../../PageMap/PageMap.h"
+#include "../../ThreadPolicy/SpinLockThreadPolicy.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Keeps up to IndexPolicy::INSTANCE_COUNT instances of Allocator and serves every
+		 * allocation from the instance picked by IndexPolicy::GetIndex(), e.g. the thread
+		 * slot or the NUMA node of the calling thread. Instances are created on first use
+		 * within an IndexPolicy::CreationScope for their index.
+		 *
+		 * Every allocation stores the index of its owning instance in front of it, so the
+		 * size passed to a pool's constructor has to leave room for it. Dealloc() from
+		 * another index is forwarded to the owner. Each instance is guarded by a spinlock
+		 * which is uncontended unless threads share an index or free across them.
+		 *
+		 * Reset() resets all instances and must only be called while no other thread uses
+		 * the allocator. Instances are registered in the page map for the owner of this
+		 * allocator's construction (e.g. its realm) or the allocator itself, so freeing
+		 * them with sp::memory::Free() goes through the forwarding above.
+		 */
+		template <typename Allocator, typename IndexPolicy>
+		class IndexedInstanceAllocator : public AllocatorBase
+		{
+		public:
+			static constexpr bool HAS_EXACT_ALLOCATION_SIZE = Allocator::HAS_EXACT_ALLOCATION_SIZE;
+
+			/// All arguments are copied and forwarded to the constructor of every instance
+			template <typename... AllocatorArgs>
+			explicit IndexedInstanceAllocator(AllocatorArgs&&... allocatorArgs);
+
+			IndexedInstanceAllocator(const IndexedInstanceAllocator& other) = delete;
+			IndexedInstanceAllocator(const IndexedInstanceAllocator&& other) = delete;
+			IndexedInstanceAllocator operator=(const IndexedInstanceAllocator& other) = delete;
+			IndexedInstanceAllocator operator=(const IndexedInstanceAllocator&& other) = delete;
+
+			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
+			virtual void Dealloc(void* memory) override;
+			virtual void Reset() override;
+
+			virtual size_t GetAllocationSize(void* memory) override;
+
+			/// Instance of the given index, nullptr if it was not used yet
+			Allocator* GetInstance(uint32_t index) const { return m_instances[index].allocator; }
+
+			~IndexedInstanceAllocator() override;
+
+		private:
+			struct OwnerHeader
+			{
+				uint32_t ownerIndex;
+			};
+
+			static const uint32_t OWNER_META_SIZE = sizeof(OwnerHeader);
+
+			struct alignas(64) Instance
+			{
+				SpinLockThreadPolicy lock;
+				Allocator* allocator;
+				alignas(Allocator) char storage[sizeof(Allocator)];
+			};
+
+			Instance& GetOwner(char* allocatorMemory);
+
+			const std::function<Allocator*(void*)> m_createInstance;
+			const PageOwner m_pageOwner;
+			Instance m_instances[IndexPolicy::INSTANCE_COUNT];
+		};
+
+#pragma region Implementation
+
+		template <typename Allocator, typename IndexPolicy>
+		template <typename... AllocatorArgs>
+		IndexedInstanceAllocator<Allocator, IndexPolicy>::IndexedInstanceAllocator(AllocatorArgs&&... allocatorArgs)
+			: m_createInstance([args = std::make_tuple(std::forward<AllocatorArgs>(allocatorArgs)...)](void* storage)
+				{
+					return std::apply([storage](const auto&... instanceArgs) { return new (storage) Allocator(instanceArgs...); }, args);
+				})
+			, m_pageOwner(ResolvePageOwner(this))
+		{
+			for (Instance& instance : m_instances)
+			{
+				instance.allocator = nullptr;
+			}
+		}
+
+		template <typename Allocator, typename IndexPolicy>
+		void* IndexedInstanceAllocator<Allocator, IndexPolicy>::Alloc(size_t size, size_t alignment, size_t offset)
+		{
+			const uint32_t ownerIndex = IndexPolicy::GetIndex();
+			Instance& instance = m_instances[ownerIndex];
+
+			char* memory = nullptr;
+			{
+				std::lock_guard<SpinLockThreadPolicy> lock(instance.lock);
+
+				// Threads sharing an index race for the creation, the lock decides
+				if (!instance.allocator)
+				{
+					ScopedPageOwner pageOwnerScope(m_pageOwner);
+					typename IndexPolicy::CreationScope creationScope(ownerIndex);
+					instance.allocator = m_createInstance(instance.storage);
+				}
+
+				memory = static_cast<char*>(instance.allocator->Alloc(OWNER_META_SIZE + size, alignment, OWNER_META_SIZE + offset));
+			}
+
+			if (!memory)
+			{
+				return nullptr;
+			}
+
+			pointerUtil::pseudo_cast<OwnerHeader*>(memory, 0)->ownerIndex = ownerIndex;
+			return memory + OWNER_META_SIZE;
+		}
+
+		template <typename Allocator, typename IndexPolicy>
+		void IndexedInstanceAllocator<Allocator, IndexPolicy>::Dealloc(void* memory)
+		{
+			{
+				const bool isNotNull = memory != nullptr;
+				assert(isNotNull && "Freeing a nullptr is not allowed");
+			}
+
+			char* allocatorMemory = static_cast<char*>(memory) - OWNER_META_SIZE;
+			Instance& owner = GetOwner(allocatorMemory);
+
+			std::lock_guard<SpinLockThreadPolicy> lock(owner.lock);
+			owner.allocator->Dealloc(allocatorMemory);
+		}
+
+		template <typename Allocator, typename IndexPolicy>
+		void IndexedInstanceAllocator<Allocator, IndexPolicy>::Reset()
+		{
+			for (Instance& instance : m_instances)
+			{
+				if (instance.allocator)
+				{
+					instance.allocator->Reset();
+				}
+			}
+		}
+
+		template <typename Allocator, typename IndexPolicy>
+		size_t IndexedInstanceAllocator<Allocator, IndexPolicy>::GetAllocationSize(void* memory)
+		{
+			{
+				const bool isNotNull = memory != nullptr;
+				assert(isNotNull && "Cannot return allocation size of a nullptr");
+			}
+
+			// The header of a live allocation is only read, the owner does not have to be locked
+			char* allocatorMemory = static_cast<char*>(memory) - OWNER_META_SIZE;
+			return GetOwner(allocatorMemory).allocator->GetAllocationSize(allocatorMemory) - OWNER_META_SIZE;
+		}
+
+		template <typename Allocator, typename IndexPolicy>
+		IndexedInstanceAllocator<Allocator, IndexPolicy>::~IndexedInstanceAllocator()
+		{
+			for (Instance& instance : m_instances)
+			{
+				if (instance.allocator)
+				{
+					instance.allocator->~Allocator();
+				}
+			}
+		}
+
+		template <typename Allocator, typename IndexPolicy>
+		typename IndexedInstanceAllocator<Allocator, IndexPolicy>::Instance& IndexedInstanceAllocator<Allocator, IndexPolicy>::GetOwner(char* allocatorMemory)
+		{
+			const uint32_t ownerIndex = pointerUtil::pseudo_cast<OwnerHeader*>(allocatorMemory, 0)->ownerIndex;
+
+			{
+				const bool isKnownOwner = ownerIndex < IndexPolicy::INSTANCE_COUNT && m_instances[ownerIndex].allocator != nullptr;
+				assert(isKnownOwner && "Memory was not allocated by this allocator, its owner header is invalid");
+			}
+
+			return m_instances[ownerIndex];
+		}
+
+#pragma endregion
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "IndexedInstanceAllocator.h"
+#include "../../VirtualMemory/VirtualMemory.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Picks the instance of a PerNodeAllocator by the NUMA node of the calling thread
+		 * and binds the memory of a new instance to that node.
+		 */
+		struct NumaNodeIndexPolicy
+		{
+			static const uint32_t INSTANCE_COUNT = NUMA_MAX_NODE_COUNT;
+
+			///
+			/// Looking the node up costs a syscall, it is done once per thread instead of per allocation
+			///
+			static uint32_t GetIndex(void)
+			{
+				thread_local const uint32_t node = GetCurrentNumaNode();
+				return node;
+			}
+
+			typedef ScopedNumaNode CreationScope;
+		};
+
+		/**
+		 * Keeps one instance of Allocator per NUMA node, e.g. a GrowingPoolAllocator or a
+		 * GrowingLinearAllocator. Threads allocate from the instance of the node they run
+		 * on, which is created within a ScopedNumaNode on first use, so all memory it
+		 * reserves and commits later on is local to the threads of that node.
+		 *
+		 * The node of a thread is looked up on its first allocation, threads are expected
+		 * to be pinned to a node before that. On machines with a single node (or without
+		 * NUMA support) there is exactly one instance and this only adds a spinlock.
+		 *
+		 * Owner headers, forwarding of frees from other nodes, Reset() and the page map
+		 * registration are the ones of the IndexedInstanceAllocator, threads of one node
+		 * share an instance.
+		 */
+		template <typename Allocator>
+		class PerNodeAllocator : public IndexedInstanceAllocator<Allocator, NumaNodeIndexPolicy>
+		{
+		public:
+			/// All arguments are copied and forwarded to the constructor of every instance
+			template <typename... AllocatorArgs>
+			explicit PerNodeAllocator(AllocatorArgs&&... allocatorArgs)
+				: IndexedInstanceAllocator<Allocator, NumaNodeIndexPolicy>(std::forward<AllocatorArgs>(allocatorArgs)...)
+			{}
+
+			/// Instance serving the given node, nullptr if no thread of it allocated yet
+			Allocator* GetNodeAllocator(uint32_t node) const { return this->GetInstance(node); }
+		};
+	}
+}
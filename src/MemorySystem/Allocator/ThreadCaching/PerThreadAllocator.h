@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+#include "IndexedInstanceAllocator.h"
+#include "ThreadCachingPoolAllocator.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Picks the instance of a PerThreadAllocator by GetThreadCacheIndex(). Threads
+		 * without an index share the last instance.
+		 */
+		struct ThreadCacheIndexPolicy
+		{
+			static const uint32_t INSTANCE_COUNT = THREAD_CACHE_MAX_THREADS + 1;
+
+			static_assert(THREAD_CACHE_NO_INDEX == THREAD_CACHE_MAX_THREADS, "Threads without an index use the last instance");
+
+			static uint32_t GetIndex(void) { return GetThreadCacheIndex(); }
+
+			/// Instances of threads are not bound to anything while they are created
+			struct CreationScope
+			{
+				explicit CreationScope(uint32_t index) {}
+			};
+		};
+
+		/**
+		 * Keeps one instance of Allocator per thread, created on the thread's first
+		 * allocation with the size given at construction. Threads allocate from their
+		 * own instance, so different threads do not contend with each other. Owner
+		 * headers, forwarding of remote frees and locking are the ones of the
+		 * IndexedInstanceAllocator.
+		 *
+		 * Instances are indexed by GetThreadCacheIndex(), a thread started after another
+		 * one exited takes over its instance. Threads without an index share one extra
+		 * instance, which is contended like any other locked allocator.
+		 */
+		template <typename Allocator>
+		class PerThreadAllocator : public IndexedInstanceAllocator<Allocator, ThreadCacheIndexPolicy>
+		{
+		public:
+			explicit PerThreadAllocator(size_t bytesPerThread)
+				: IndexedInstanceAllocator<Allocator, ThreadCacheIndexPolicy>(bytesPerThread)
+			{}
+		};
+	}
+}
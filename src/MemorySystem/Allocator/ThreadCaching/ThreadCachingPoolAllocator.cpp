@@ -0,0 +1,62 @@
+#include "ThreadCachingPoolAllocator.h"
+
+#include <atomic>
+
+namespace
+{
+	static_assert(sp::memory::THREAD_CACHE_MAX_THREADS <= 64, "Thread cache indices are tracked in a 64 bit mask");
+	static_assert(sp::memory::THREAD_CACHE_NO_INDEX >= sp::memory::THREAD_CACHE_MAX_THREADS, "The missing index must not collide with a valid one");
+
+	std::atomic<uint64_t> g_usedThreadCacheIndices(0u);
+
+	///
+	/// Claims the lowest free index on construction and releases it again
+	/// when the owning thread exits.
+	///
+	struct ThreadCacheIndex
+	{
+		ThreadCacheIndex()
+			: index(sp::memory::THREAD_CACHE_NO_INDEX)
+		{
+			uint64_t usedIndices = g_usedThreadCacheIndices.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				uint32_t freeIndex = 0u;
+				while (freeIndex < sp::memory::THREAD_CACHE_MAX_THREADS && (usedIndices & (uint64_t(1) << freeIndex)) != 0u)
+				{
+					++freeIndex;
+				}
+
+				// All indices taken, the thread keeps THREAD_CACHE_NO_INDEX and allocates uncached
+				if (freeIndex == sp::memory::THREAD_CACHE_MAX_THREADS)
+				{
+					return;
+				}
+
+				if (g_usedThreadCacheIndices.compare_exchange_weak(usedIndices, usedIndices | (uint64_t(1) << freeIndex), std::memory_order_acquire))
+				{
+					index = freeIndex;
+					return;
+				}
+			}
+		}
+
+		~ThreadCacheIndex()
+		{
+			if (index == sp::memory::THREAD_CACHE_NO_INDEX)
+			{
+				return;
+			}
+
+			g_usedThreadCacheIndices.fetch_and(~(uint64_t(1) << index), std::memory_order_release);
+		}
+
+		uint32_t index;
+	};
+}
+
+uint32_t sp::memory::GetThreadCacheIndex()
+{
+	static thread_local const ThreadCacheIndex threadCacheIndex;
+	return threadCacheIndex.index;
+}
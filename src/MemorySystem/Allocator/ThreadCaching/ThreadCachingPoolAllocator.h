@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "../AllocatorBase.h"
+#include "../../PageMap/PageMap.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		static const uint32_t THREAD_CACHE_MAX_THREADS = 64;
+		static const uint32_t THREAD_CACHE_NO_INDEX = THREAD_CACHE_MAX_THREADS;
+
+		/**
+		 * Returns a process-wide unique index in [0, THREAD_CACHE_MAX_THREADS) for
+		 * the calling thread. Indices are handed back when a thread exits and are
+		 * re-used by threads started later on. Threads started while all indices
+		 * are taken get THREAD_CACHE_NO_INDEX for their whole lifetime.
+		 */
+		uint32_t GetThreadCacheIndex(void);
+
+		/**
+		 * A thread-safe front-end for PoolAllocator and GrowingPoolAllocator.
+		 *
+		 * Every thread owns a small magazine of chunks per allocator which it can
+		 * allocate from and free into without any locking. Only when a magazine
+		 * runs empty or full, half of its capacity is refilled from or flushed to
+		 * the wrapped pool, which acts as the central free list and is guarded by
+		 * a mutex. Chunks freed on a different thread than they were allocated on
+		 * end up in the freeing thread's magazine and eventually flow back to the
+		 * pool, so they are never lost.
+		 *
+		 * Chunks cached in the magazines of other threads are not visible to the pool, a
+		 * non-growing pool can therefore run dry while up to MAGAZINE_CAPACITY free chunks
+		 * per thread are still cached. Pools should be sized with that slack in mind.
+		 *
+		 * Like with the pool, the alignment and offset are fixed at construction. Alloc()
+		 * asserts the alignment, the offset is the one the pool was constructed with.
+		 *
+		 * Threads without a thread cache index (more than THREAD_CACHE_MAX_THREADS
+		 * at once) bypass the magazines and go to the pool under the mutex.
+		 *
+		 * Reset() is not synchronized with Alloc()/Dealloc() and must only be
+		 * called while no other thread uses the allocator.
+		 *
+		 * The pages of the wrapped pool are registered for this front-end in the page map,
+		 * sp::memory::Free() therefore does not bypass the magazines.
+		 */
+		template <typename Pool>
+		class ThreadCachingPoolAllocator : public AllocatorBase
+		{
+		public:
+			static const size_t MAGAZINE_CAPACITY = 64;
+			static const size_t MAGAZINE_BATCH_SIZE = MAGAZINE_CAPACITY / 2;
+			static constexpr bool HAS_EXACT_ALLOCATION_SIZE = Pool::HAS_EXACT_ALLOCATION_SIZE;
+
+			/// All arguments are forwarded to the constructor of the wrapped pool
+			template <typename... PoolArgs>
+			explicit ThreadCachingPoolAllocator(PoolArgs&&... poolArgs);
+
+			ThreadCachingPoolAllocator(const ThreadCachingPoolAllocator& other) = delete;
+			ThreadCachingPoolAllocator(const ThreadCachingPoolAllocator&& other) = delete;
+			ThreadCachingPoolAllocator operator=(const ThreadCachingPoolAllocator& other) = delete;
+			ThreadCachingPoolAllocator operator=(const ThreadCachingPoolAllocator&& other) = delete;
+
+			virtual void* Alloc(size_t size, size_t alignment, size_t offset) override;
+			virtual void Dealloc(void* memory) override;
+			virtual void Reset() override;
+
+			virtual size_t GetAllocationSize(void* memory) override;
+
+			~ThreadCachingPoolAllocator() override = default;
+
+		private:
+			/// Constructs the pool while the scope attributes its reservation to this front-end
+			template <typename... PoolArgs>
+			ThreadCachingPoolAllocator(ScopedPageOwner&& pageOwnerScope, PoolArgs&&... poolArgs);
+
+			struct alignas(64) Magazine
+			{
+				size_t count;
+				void* chunks[MAGAZINE_CAPACITY];
+			};
+
+			void Refill(Magazine& magazine);
+			void Flush(Magazine& magazine);
+
+			std::mutex m_centralMutex;
+			Pool m_pool;
+			Magazine m_magazines[THREAD_CACHE_MAX_THREADS];
+		};
+
+#pragma region Implementation
+
+		template <typename Pool>
+		template <typename... PoolArgs>
+		ThreadCachingPoolAllocator<Pool>::ThreadCachingPoolAllocator(PoolArgs&&... poolArgs)
+			: ThreadCachingPoolAllocator(ScopedPageOwner(this), std::forward<PoolArgs>(poolArgs)...)
+		{
+		}
+
+		template <typename Pool>
+		template <typename... PoolArgs>
+		ThreadCachingPoolAllocator<Pool>::ThreadCachingPoolAllocator(ScopedPageOwner&&, PoolArgs&&... poolArgs)
+			: m_pool(std::forward<PoolArgs>(poolArgs)...)
+		{
+			for (Magazine& magazine : m_magazines)
+			{
+				magazine.count = 0u;
+			}
+		}
+
+		template <typename Pool>
+		void* ThreadCachingPoolAllocator<Pool>::Alloc(size_t size, size_t alignment, size_t offset)
+		{
+			{
+				const bool alignmentLesserOrEqualMaxElementAlignment = alignment <= m_pool.GetMaxElementAlignment();
+				assert(alignmentLesserOrEqualMaxElementAlignment && "Allocation alignment has to be lesser or equal to the maximum element alignment provided at construction");
+			}
+
+			const uint32_t cacheIndex = GetThreadCacheIndex();
+			if (cacheIndex == THREAD_CACHE_NO_INDEX)
+			{
+				void* chunk = nullptr;
+				{
+					std::lock_guard<std::mutex> lock(m_centralMutex);
+					if (m_pool.AllocChunks(&chunk, 1u) == 0u)
+					{
+						return nullptr;
+					}
+				}
+
+				return m_pool.InitializeChunk(chunk, size);
+			}
+
+			Magazine& magazine = m_magazines[cacheIndex];
+
+			if (magazine.count == 0u)
+			{
+				Refill(magazine);
+
+				if (magazine.count == 0u)
+				{
+					return nullptr;
+				}
+			}
+
+			void* chunk = magazine.chunks[--magazine.count];
+			return m_pool.InitializeChunk(chunk, size);
+		}
+
+		template <typename Pool>
+		void ThreadCachingPoolAllocator<Pool>::Dealloc(void* memory)
+		{
+			{
+				const bool isNotNull = memory != nullptr;
+				assert(isNotNull && "Freeing a nullptr is not allowed");
+			}
+
+			void* chunk = m_pool.GetChunk(memory);
+
+			const uint32_t cacheIndex = GetThreadCacheIndex();
+			if (cacheIndex == THREAD_CACHE_NO_INDEX)
+			{
+				std::lock_guard<std::mutex> lock(m_centralMutex);
+				m_pool.DeallocChunks(&chunk, 1u);
+				return;
+			}
+
+			Magazine& magazine = m_magazines[cacheIndex];
+
+			if (magazine.count == MAGAZINE_CAPACITY)
+			{
+				Flush(magazine);
+			}
+
+			magazine.chunks[magazine.count++] = chunk;
+		}
+
+		template <typename Pool>
+		void ThreadCachingPoolAllocator<Pool>::Reset()
+		{
+			std::lock_guard<std::mutex> lock(m_centralMutex);
+
+			for (Magazine& magazine : m_magazines)
+			{
+				magazine.count = 0u;
+			}
+
+			m_pool.Reset();
+		}
+
+		template <typename Pool>
+		size_t ThreadCachingPoolAllocator<Pool>::GetAllocationSize(void* memory)
+		{
+			return m_pool.GetAllocationSize(memory);
+		}
+
+		template <typename Pool>
+		void ThreadCachingPoolAllocator<Pool>::Refill(Magazine& magazine)
+		{
+			std::lock_guard<std::mutex> lock(m_centralMutex);
+			magazine.count += m_pool.AllocChunks(magazine.chunks + magazine.count, MAGAZINE_BATCH_SIZE);
+		}
+
+		template <typename Pool>
+		void ThreadCachingPoolAllocator<Pool>::Flush(Magazine& magazine)
+		{
+			// Hand back the chunks at the bottom of the magazine, the recently freed (cache-hot) ones stay
+			std::lock_guard<std::mutex> lock(m_centralMutex);
+			m_pool.DeallocChunks(magazine.chunks, MAGAZINE_BATCH_SIZE);
+
+			magazine.count -= MAGAZINE_BATCH_SIZE;
+			for (size_t idx = 0u; idx < magazine.count; ++idx)
+			{
+				magazine.chunks[idx] = magazine.chunks[idx + MAGAZINE_BATCH_SIZE];
+			}
+		}
+
+#pragma endregion
+	}
+}
@@ -0,0 +1,97 @@
+#include "GuardPageBoundsChecker.h"
+
+#include <cassert>
+
+#include "Math/MathUtil.h"
+#include "Pointers/PointerUtil.h"
+#include "../VirtualMemory/VirtualMemory.h"
+
+///
+/// Layout of a guarded allocation: [guard page][committed pages][guard page]. The user
+/// pointer is aligned down from the start of the trailing guard page, so an alignment
+/// of at most a page never moves it in front of the committed pages.
+///
+void* sp::memory::GuardedAllocations::Alloc(size_t size, size_t alignment)
+{
+	assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+	const size_t pageSize = GetPageSize();
+
+	{
+		const bool alignmentFitsIntoPage = alignment <= pageSize;
+		assert(alignmentFitsIntoPage && "Guarded allocations cannot be aligned to more than a page");
+	}
+
+	const size_t committedSize = math::RoundUp(size > 0u ? size : 1u, pageSize);
+	const size_t reservationSize = pageSize + committedSize + pageSize;
+
+	char* reservation = static_cast<char*>(ReserveAddressSpace(reservationSize, m_pageOwner));
+	if (!reservation)
+	{
+		return nullptr;
+	}
+
+	char* committedBegin = reservation + pageSize;
+	if (!CommitPhysicalMemory(committedBegin, committedSize))
+	{
+		FreeAddressSpace(reservation, reservationSize);
+		return nullptr;
+	}
+
+	char* backGuardPage = committedBegin + committedSize;
+	void* allocation = pointerUtil::AlignBottom(backGuardPage - size, alignment);
+
+	m_allocations.emplace(allocation, GuardedAllocation{ reservation, reservationSize, size });
+	return allocation;
+}
+
+void sp::memory::GuardedAllocations::Dealloc(void* memory)
+{
+	auto it = m_allocations.find(memory);
+
+	{
+		const bool isGuardedAllocation = it != m_allocations.end();
+		assert(isGuardedAllocation && "Memory was not allocated with guard pages");
+	}
+
+	FreeAddressSpace(it->second.reservation, it->second.reservationSize);
+	m_allocations.erase(it);
+}
+
+void sp::memory::GuardedAllocations::Reset(void)
+{
+	for (const auto& allocation : m_allocations)
+	{
+		FreeAddressSpace(allocation.second.reservation, allocation.second.reservationSize);
+	}
+
+	m_allocations.clear();
+}
+
+bool sp::memory::GuardedAllocations::Owns(const void* memory) const
+{
+	// Most realms only guard a fraction of their allocations, skip the lookup while there are none
+	return !m_allocations.empty() && m_allocations.find(memory) != m_allocations.end();
+}
+
+size_t sp::memory::GuardedAllocations::GetAllocationSize(const void* memory) const
+{
+	auto it = m_allocations.find(memory);
+
+	{
+		const bool isGuardedAllocation = it != m_allocations.end();
+		assert(isGuardedAllocation && "Memory was not allocated with guard pages");
+	}
+
+	return it->second.allocationSize;
+}
+
+size_t sp::memory::GuardedAllocations::GetCount(void) const
+{
+	return m_allocations.size();
+}
+
+sp::memory::GuardedAllocations::~GuardedAllocations()
+{
+	Reset();
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+
+#include "../PageMap/PageMap.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Bookkeeping of the guarded allocations of a GuardPageBoundsChecker. Every guarded
+		 * allocation owns its own reservation with an inaccessible page on either side of
+		 * the committed pages. The allocation is placed at the end of its committed pages,
+		 * so writing past it faults on the very first byte of the trailing guard page.
+		 *
+		 * Freed allocations release their reservation, later accesses through dangling
+		 * pointers fault as well as long as the address range is not reused. Reservations
+		 * are registered in the page map for the owner of the construction (the realm).
+		 */
+		class GuardedAllocations
+		{
+		public:
+			GuardedAllocations() = default;
+
+			GuardedAllocations(const GuardedAllocations& other) = delete;
+			GuardedAllocations(const GuardedAllocations&& other) = delete;
+			GuardedAllocations operator=(const GuardedAllocations& other) = delete;
+			GuardedAllocations operator=(const GuardedAllocations&& other) = delete;
+
+			void* Alloc(size_t size, size_t alignment);
+			void Dealloc(void* memory);
+			void Reset(void);
+
+			bool Owns(const void* memory) const;
+			size_t GetAllocationSize(const void* memory) const;
+			size_t GetCount(void) const;
+
+			~GuardedAllocations();
+
+		private:
+			struct GuardedAllocation
+			{
+				void* reservation;
+				size_t reservationSize;
+				size_t allocationSize;
+			};
+
+			std::unordered_map<const void*, GuardedAllocation> m_allocations;
+			const PageOwner m_pageOwner = ResolvePageOwner(PageOwner());
+		};
+
+		/**
+		 * Bounds checking strategy that traps stomps the moment they happen instead of
+		 * when the block is freed. Allocations picked by this checker bypass the realm's
+		 * allocator and are placed directly in front of a PROT_NONE page reserved from
+		 * the virtual memory system, the faulting write shows up in the debugger or crash
+		 * dump with the offending callstack.
+		 *
+		 * Each guarded allocation costs at least one committed page and two reserved ones
+		 * plus a TLB entry. With a SAMPLE_RATE of N only every Nth allocation is guarded,
+		 * the others are served by the allocator without any checks, which keeps the cost
+		 * acceptable when running under production load and still catches frequent stomps.
+		 *
+		 * Overruns smaller than the padding needed for the requested alignment are not
+		 * detected. Like the other strategies it is synchronized by the realm's
+		 * ThreadPolicy and cannot be used with per-thread allocator instances.
+		 */
+		template <uint32_t SAMPLE_RATE = 1>
+		class GuardPageBoundsChecker
+		{
+			static_assert(SAMPLE_RATE > 0, "The sample rate has to be at least 1");
+
+		public:
+			static constexpr uint8_t CANARY_SIZE = 0;
+			static constexpr bool USES_GUARD_PAGES = true;
+			static constexpr bool TRACKS_ALLOCATIONS = false;
+
+			void WriteCanary(void* memory) const {}
+			void ValidateFrontCanary(void* memory) const {}
+			void ValidateBackCanary(void* memory) const {}
+
+			/// Decides whether the next allocation of the realm is guarded
+			bool ShouldGuard(void);
+
+			void* AllocGuarded(size_t size, size_t alignment);
+			void DeallocGuarded(void* memory);
+			void Reset(void);
+
+			bool IsGuarded(const void* memory) const;
+			size_t GetGuardedSize(const void* memory) const;
+			size_t GetGuardedCount(void) const;
+
+		private:
+			uint32_t m_allocationCounter = 0u;
+			GuardedAllocations m_guardedAllocations;
+		};
+
+#pragma region Implementation
+
+		template <uint32_t SAMPLE_RATE>
+		inline bool GuardPageBoundsChecker<SAMPLE_RATE>::ShouldGuard(void)
+		{
+			if constexpr (SAMPLE_RATE == 1)
+			{
+				return true;
+			}
+
+			if (++m_allocationCounter < SAMPLE_RATE)
+			{
+				return false;
+			}
+
+			m_allocationCounter = 0u;
+			return true;
+		}
+
+		template <uint32_t SAMPLE_RATE>
+		void* GuardPageBoundsChecker<SAMPLE_RATE>::AllocGuarded(size_t size, size_t alignment)
+		{
+			return m_guardedAllocations.Alloc(size, alignment);
+		}
+
+		template <uint32_t SAMPLE_RATE>
+		void GuardPageBoundsChecker<SAMPLE_RATE>::DeallocGuarded(void* memory)
+		{
+			m_guardedAllocations.Dealloc(memory);
+		}
+
+		template <uint32_t SAMPLE_RATE>
+		void GuardPageBoundsChecker<SAMPLE_RATE>::Reset(void)
+		{
+			m_allocationCounter = 0u;
+			m_guardedAllocations.Reset();
+		}
+
+		template <uint32_t SAMPLE_RATE>
+		inline bool GuardPageBoundsChecker<SAMPLE_RATE>::IsGuarded(const void* memory) const
+		{
+			return m_guardedAllocations.Owns(memory);
+		}
+
+		template <uint32_t SAMPLE_RATE>
+		size_t GuardPageBoundsChecker<SAMPLE_RATE>::GetGuardedSize(const void* memory) const
+		{
+			return m_guardedAllocations.GetAllocationSize(memory);
+		}
+
+		template <uint32_t SAMPLE_RATE>
+		size_t GuardPageBoundsChecker<SAMPLE_RATE>::GetGuardedCount(void) const
+		{
+			return m_guardedAllocations.GetCount();
+		}
+
+#pragma endregion
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Bounds checking strategy for realms that should not pay for any checks
+		 * (e.g. retail builds). Without canaries the realm skips all canary handling
+		 * at compile-time, so an allocation costs exactly what the allocator costs.
+		 */
+		class NoBoundsChecker
+		{
+		public:
+			static constexpr uint8_t CANARY_SIZE = 0;
+			static constexpr bool USES_GUARD_PAGES = false;
+			static constexpr bool TRACKS_ALLOCATIONS = false;
+
+			void WriteCanary(void* memory) const {}
+			void ValidateFrontCanary(void* memory) const {}
+			void ValidateBackCanary(void* memory) const {}
+		};
+	}
+}
@@ -1,5 +1,19 @@
 #pragma once
 #include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SP_CANARY_VECTOR_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SP_CANARY_VECTOR_WIDTH 16
+#else
+#define SP_CANARY_VECTOR_WIDTH 0
+#endif
+
+#include "Pointers/PointerUtil.h"
 
 namespace sp
 {
@@ -10,18 +24,157 @@ namespace sp
 		 * before and after the allocation block. This value
 		 * can later be checked for validity to discover
 		 * memory stomps.
+		 *
+		 * The canary is CANARY_WIDTH bytes wide. Wider canaries of 16, 32 or
+		 * 64 bytes also catch overruns that skip over the first few bytes
+		 * behind a block, they are written and compared with unaligned
+		 * SSE2/AVX2 stores and loads (one to four instructions per canary).
 		 */
-		class SimpleBoundsChecker
+		template <uint8_t CANARY_WIDTH>
+		class BasicSimpleBoundsChecker
 		{
+			static_assert(CANARY_WIDTH == 4 || CANARY_WIDTH == 16 || CANARY_WIDTH == 32 || CANARY_WIDTH == 64,
+				"Canaries have to be 4, 16, 32 or 64 bytes wide");
+
 		public:
-			static const uint8_t CANARY_SIZE;
+			static constexpr uint8_t CANARY_SIZE = CANARY_WIDTH;
+			static constexpr bool USES_GUARD_PAGES = false;
+			static constexpr bool TRACKS_ALLOCATIONS = false;
 
 			void WriteCanary(void* memory) const;
 			void ValidateFrontCanary(void* memory) const;
 			void ValidateBackCanary(void* memory) const;
 
+			bool IsValidCanary(const void* memory) const;
+			/// Index of the first byte differing from the canary, CANARY_SIZE if it is intact
+			size_t FindCorruptedByte(const void* memory) const;
+
 		private:
+			static constexpr uint8_t CANARY_BYTE = 0xCA;
+
 			const uint32_t m_canary = 0xCA;
 		};
+
+		typedef BasicSimpleBoundsChecker<4> SimpleBoundsChecker;
+		typedef BasicSimpleBoundsChecker<16> SimpleBoundsChecker16;
+		typedef BasicSimpleBoundsChecker<32> SimpleBoundsChecker32;
+		typedef BasicSimpleBoundsChecker<64> SimpleBoundsChecker64;
+
+#pragma region Implementation
+
+		// Defined inline so realms can fold the canary handling into their Alloc()/Dealloc()
+
+		template <uint8_t CANARY_WIDTH>
+		inline void BasicSimpleBoundsChecker<CANARY_WIDTH>::WriteCanary(void* const memory) const
+		{
+			if constexpr (CANARY_WIDTH == 4)
+			{
+				uint32_t* canaryLocation = sp::pointerUtil::pseudo_cast<uint32_t*>(memory, 0);
+				*canaryLocation = m_canary;
+			}
+			else
+			{
+				char* canaryLocation = static_cast<char*>(memory);
+#if SP_CANARY_VECTOR_WIDTH == 32
+				const __m256i canary = _mm256_set1_epi8(static_cast<char>(CANARY_BYTE));
+				for (size_t offset = 0; offset + 32 <= CANARY_WIDTH; offset += 32)
+				{
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(canaryLocation + offset), canary);
+				}
+
+				if constexpr (CANARY_WIDTH == 16)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(canaryLocation), _mm256_castsi256_si128(canary));
+				}
+#elif SP_CANARY_VECTOR_WIDTH == 16
+				const __m128i canary = _mm_set1_epi8(static_cast<char>(CANARY_BYTE));
+				for (size_t offset = 0; offset < CANARY_WIDTH; offset += 16)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(canaryLocation + offset), canary);
+				}
+#else
+				std::memset(canaryLocation, CANARY_BYTE, CANARY_WIDTH);
+#endif
+			}
+		}
+
+		template <uint8_t CANARY_WIDTH>
+		inline bool BasicSimpleBoundsChecker<CANARY_WIDTH>::IsValidCanary(const void* const memory) const
+		{
+			if constexpr (CANARY_WIDTH == 4)
+			{
+				const uint32_t* canaryLocation = sp::pointerUtil::pseudo_cast<const uint32_t*>(memory, 0);
+				return *canaryLocation == m_canary;
+			}
+			else
+			{
+				const char* canaryLocation = static_cast<const char*>(memory);
+#if SP_CANARY_VECTOR_WIDTH == 32
+				if constexpr (CANARY_WIDTH == 16)
+				{
+					const __m128i loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(canaryLocation));
+					return _mm_movemask_epi8(_mm_cmpeq_epi8(loaded, _mm_set1_epi8(static_cast<char>(CANARY_BYTE)))) == 0xFFFF;
+				}
+				else
+				{
+					// Accumulate the differences so wide canaries are checked with a single branch
+					const __m256i canary = _mm256_set1_epi8(static_cast<char>(CANARY_BYTE));
+					__m256i difference = _mm256_setzero_si256();
+					for (size_t offset = 0; offset < CANARY_WIDTH; offset += 32)
+					{
+						const __m256i loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(canaryLocation + offset));
+						difference = _mm256_or_si256(difference, _mm256_xor_si256(loaded, canary));
+					}
+					return _mm256_testz_si256(difference, difference) != 0;
+				}
+#elif SP_CANARY_VECTOR_WIDTH == 16
+				const __m128i canary = _mm_set1_epi8(static_cast<char>(CANARY_BYTE));
+				__m128i difference = _mm_setzero_si128();
+				for (size_t offset = 0; offset < CANARY_WIDTH; offset += 16)
+				{
+					const __m128i loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(canaryLocation + offset));
+					difference = _mm_or_si128(difference, _mm_xor_si128(loaded, canary));
+				}
+				return _mm_movemask_epi8(_mm_cmpeq_epi8(difference, _mm_setzero_si128())) == 0xFFFF;
+#else
+				return FindCorruptedByte(memory) == CANARY_WIDTH;
+#endif
+			}
+		}
+
+		template <uint8_t CANARY_WIDTH>
+		size_t BasicSimpleBoundsChecker<CANARY_WIDTH>::FindCorruptedByte(const void* const memory) const
+		{
+			// Only used to report a stomp, so compare byte by byte against a freshly written canary
+			char expectedCanary[CANARY_WIDTH];
+			WriteCanary(expectedCanary);
+
+			const char* canaryLocation = static_cast<const char*>(memory);
+			for (size_t idx = 0; idx < CANARY_WIDTH; ++idx)
+			{
+				if (canaryLocation[idx] != expectedCanary[idx])
+				{
+					return idx;
+				}
+			}
+
+			return CANARY_WIDTH;
+		}
+
+		template <uint8_t CANARY_WIDTH>
+		inline void BasicSimpleBoundsChecker<CANARY_WIDTH>::ValidateFrontCanary(void* const memory) const
+		{
+			const bool isValidCanary = IsValidCanary(memory);
+			assert(isValidCanary && "Front Canary was not valid");
+		}
+
+		template <uint8_t CANARY_WIDTH>
+		inline void BasicSimpleBoundsChecker<CANARY_WIDTH>::ValidateBackCanary(void* const memory) const
+		{
+			const bool isValidCanary = IsValidCanary(memory);
+			assert(isValidCanary && "Back Canary was not valid");
+		}
+
+#pragma endregion
 	}
 }
@@ -0,0 +1,135 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "SimpleBoundsChecker.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * First corrupted block found by a ValidateAll() sweep. The offset of the first
+		 * stomped byte is relative to the user pointer, negative offsets lie in the front
+		 * canary and offsets of at least size in the back canary. A nullptr allocation
+		 * means all canaries are intact.
+		 */
+		struct BoundsViolation
+		{
+			void* allocation;
+			size_t size;
+			ptrdiff_t offset;
+		};
+
+		/**
+		 * Canary bounds checker that additionally remembers every live allocation of its
+		 * realm, so all canaries can be validated at once with ValidateAll() instead of
+		 * only when a block is freed (e.g. once per frame or tick).
+		 *
+		 * The live blocks are kept in a dense array, a sweep only touches the canaries
+		 * themselves and costs two vector compares per allocation. Registering and
+		 * removing a block costs one hash map operation.
+		 */
+		template <uint8_t CANARY_WIDTH>
+		class SweepingBoundsChecker : public BasicSimpleBoundsChecker<CANARY_WIDTH>
+		{
+		public:
+			static constexpr bool TRACKS_ALLOCATIONS = true;
+
+			/// Called by the realm with the front canary location of a new allocation
+			void OnAlloc(void* memory, size_t userSize);
+			void OnDealloc(void* memory);
+			void Reset(void);
+
+			BoundsViolation ValidateAll(void) const;
+			size_t GetLiveCount(void) const;
+
+		private:
+			struct LiveAllocation
+			{
+				char* frontCanary;
+				size_t userSize;
+			};
+
+			std::vector<LiveAllocation> m_liveAllocations;
+			std::unordered_map<const void*, size_t> m_liveIndices;
+		};
+
+		typedef SweepingBoundsChecker<16> SweepingBoundsChecker16;
+		typedef SweepingBoundsChecker<32> SweepingBoundsChecker32;
+		typedef SweepingBoundsChecker<64> SweepingBoundsChecker64;
+
+#pragma region Implementation
+
+		template <uint8_t CANARY_WIDTH>
+		void SweepingBoundsChecker<CANARY_WIDTH>::OnAlloc(void* memory, size_t userSize)
+		{
+			m_liveIndices.emplace(memory, m_liveAllocations.size());
+			m_liveAllocations.push_back(LiveAllocation{ static_cast<char*>(memory), userSize });
+		}
+
+		template <uint8_t CANARY_WIDTH>
+		void SweepingBoundsChecker<CANARY_WIDTH>::OnDealloc(void* memory)
+		{
+			auto it = m_liveIndices.find(memory);
+
+			{
+				const bool isLiveAllocation = it != m_liveIndices.end();
+				assert(isLiveAllocation && "Memory is not a live allocation of this realm");
+			}
+
+			// Swap-and-pop keeps the array dense
+			const size_t index = it->second;
+			m_liveIndices.erase(it);
+
+			if (index != m_liveAllocations.size() - 1u)
+			{
+				m_liveAllocations[index] = m_liveAllocations.back();
+				m_liveIndices[m_liveAllocations[index].frontCanary] = index;
+			}
+
+			m_liveAllocations.pop_back();
+		}
+
+		template <uint8_t CANARY_WIDTH>
+		void SweepingBoundsChecker<CANARY_WIDTH>::Reset(void)
+		{
+			m_liveAllocations.clear();
+			m_liveIndices.clear();
+		}
+
+		template <uint8_t CANARY_WIDTH>
+		BoundsViolation SweepingBoundsChecker<CANARY_WIDTH>::ValidateAll(void) const
+		{
+			for (const LiveAllocation& allocation : m_liveAllocations)
+			{
+				char* userMemory = allocation.frontCanary + CANARY_WIDTH;
+				char* backCanary = userMemory + allocation.userSize;
+
+				if (!this->IsValidCanary(allocation.frontCanary))
+				{
+					const ptrdiff_t corruptedByte = static_cast<ptrdiff_t>(this->FindCorruptedByte(allocation.frontCanary));
+					return BoundsViolation{ userMemory, allocation.userSize, corruptedByte - CANARY_WIDTH };
+				}
+
+				if (!this->IsValidCanary(backCanary))
+				{
+					const ptrdiff_t corruptedByte = static_cast<ptrdiff_t>(this->FindCorruptedByte(backCanary));
+					return BoundsViolation{ userMemory, allocation.userSize, static_cast<ptrdiff_t>(allocation.userSize) + corruptedByte };
+				}
+			}
+
+			return BoundsViolation{ nullptr, 0u, 0 };
+		}
+
+		template <uint8_t CANARY_WIDTH>
+		size_t SweepingBoundsChecker<CANARY_WIDTH>::GetLiveCount(void) const
+		{
+			return m_liveAllocations.size();
+		}
+
+#pragma endregion
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <new>
+
+#include "GlobalNewRouting.h"
+
+/**
+ * Replaces the global operator new/delete (including the sized, nothrow and aligned
+ * overloads) with versions that route into sp::memory::GetGlobalRealm().
+ *
+ * This header defines the replacement functions, so it is opt-in and must be included
+ * in exactly one translation unit of the executable.
+ */
+
+namespace sp
+{
+	namespace memory
+	{
+		namespace globalNew
+		{
+			static void* AllocOrThrow(size_t size, size_t alignment)
+			{
+				void* memory = GlobalAlloc(size, alignment);
+				if (!memory)
+				{
+					throw std::bad_alloc();
+				}
+				return memory;
+			}
+		}
+	}
+}
+
+void* operator new(size_t size)
+{
+	return sp::memory::globalNew::AllocOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size)
+{
+	return sp::memory::globalNew::AllocOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return sp::memory::GlobalAlloc(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return sp::memory::GlobalAlloc(size, alignof(std::max_align_t));
+}
+
+void operator delete(void* memory) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+#if defined(__cpp_aligned_new)
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return sp::memory::globalNew::AllocOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return sp::memory::globalNew::AllocOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return sp::memory::GlobalAlloc(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return sp::memory::GlobalAlloc(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	sp::memory::GlobalDealloc(memory);
+}
+#endif
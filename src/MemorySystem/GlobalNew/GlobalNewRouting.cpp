@@ -0,0 +1,120 @@
+#include "GlobalNewRouting.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	///
+	/// Stored directly in front of every routed block.
+	///
+	struct GlobalAllocationHeader
+	{
+		MemoryRealmBase* realm;
+		void* allocation;
+	};
+
+	// Both malloc and the realms align to at least this, so the header always fits into the alignment padding
+	static const size_t MIN_ALIGNMENT = alignof(std::max_align_t);
+	static_assert(sizeof(GlobalAllocationHeader) <= MIN_ALIGNMENT, "Allocation header does not fit into the minimal alignment");
+
+	std::atomic<MemoryRealmBase*> g_globalRealm(nullptr);
+
+	thread_local MemoryRealmBase* t_scopedRealm = nullptr;
+	// Set while a realm is serving a request, nested allocations of the realm itself go to malloc
+	thread_local bool t_isRouting = false;
+}
+
+void sp::memory::SetGlobalRealm(MemoryRealmBase* realm)
+{
+	g_globalRealm.store(realm, std::memory_order_release);
+}
+
+MemoryRealmBase* sp::memory::GetGlobalRealm(void)
+{
+	if (t_scopedRealm)
+	{
+		return t_scopedRealm;
+	}
+
+	return g_globalRealm.load(std::memory_order_acquire);
+}
+
+void* sp::memory::GlobalAlloc(size_t bytes, size_t alignment)
+{
+	assert(pointerUtil::IsPowerOfTwo(alignment) && "Alignment has to be a power-of-two");
+
+	if (alignment < MIN_ALIGNMENT)
+	{
+		alignment = MIN_ALIGNMENT;
+	}
+
+	const size_t totalSize = alignment + bytes;
+	if (totalSize < bytes)
+	{
+		return nullptr;
+	}
+
+	MemoryRealmBase* realm = t_isRouting ? nullptr : GetGlobalRealm();
+	char* allocation = nullptr;
+
+	if (realm)
+	{
+		t_isRouting = true;
+		allocation = static_cast<char*>(realm->Alloc(totalSize, alignment));
+		t_isRouting = false;
+	}
+	else
+	{
+		allocation = static_cast<char*>(std::malloc(totalSize));
+	}
+
+	if (!allocation)
+	{
+		return nullptr;
+	}
+
+	char* userPointer = pointerUtil::AlignTop(allocation + sizeof(GlobalAllocationHeader), alignment);
+
+	GlobalAllocationHeader* header = pointerUtil::pseudo_cast<GlobalAllocationHeader*>(userPointer - sizeof(GlobalAllocationHeader), 0);
+	header->realm = realm;
+	header->allocation = allocation;
+
+	return userPointer;
+}
+
+void sp::memory::GlobalDealloc(void* memory)
+{
+	if (!memory)
+	{
+		return;
+	}
+
+	GlobalAllocationHeader* header = pointerUtil::pseudo_cast<GlobalAllocationHeader*>(static_cast<char*>(memory) - sizeof(GlobalAllocationHeader), 0);
+
+	if (header->realm)
+	{
+		const bool wasRouting = t_isRouting;
+		t_isRouting = true;
+		header->realm->Dealloc(header->allocation);
+		t_isRouting = wasRouting;
+	}
+	else
+	{
+		std::free(header->allocation);
+	}
+}
+
+sp::memory::ScopedGlobalRealm::ScopedGlobalRealm(MemoryRealmBase& realm)
+	: m_previousRealm(t_scopedRealm)
+{
+	t_scopedRealm = &realm;
+}
+
+sp::memory::ScopedGlobalRealm::~ScopedGlobalRealm()
+{
+	t_scopedRealm = m_previousRealm;
+}
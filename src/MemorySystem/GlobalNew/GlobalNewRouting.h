@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../MemoryRealm/MemoryRealmBase.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Routing of the global operator new/delete into MemoryRealms.
+		 *
+		 * The replacement operators themselves live in GlobalNewOverride.h and are opt-in.
+		 * Every request is sent to the realm returned by GetGlobalRealm(): the innermost
+		 * ScopedGlobalRealm of the calling thread, otherwise the process-wide realm set
+		 * with SetGlobalRealm(). Without any realm, malloc/free are used.
+		 *
+		 * Each block remembers the realm it came from, so it can be deleted anywhere,
+		 * also after the scope that allocated it ended. A realm has to outlive all of
+		 * its global allocations. The process-wide realm is used by all threads and has
+		 * to be thread-safe.
+		 */
+		void SetGlobalRealm(MemoryRealmBase* realm);
+		MemoryRealmBase* GetGlobalRealm(void);
+
+		/// Allocation and deallocation as done by the replacement operators, returns nullptr on failure
+		void* GlobalAlloc(size_t bytes, size_t alignment);
+		void GlobalDealloc(void* memory);
+
+		/**
+		 * Routes all global allocations of the current thread into the given realm
+		 * for the lifetime of this object. Scopes can be nested.
+		 */
+		class ScopedGlobalRealm
+		{
+		public:
+			explicit ScopedGlobalRealm(MemoryRealmBase& realm);
+
+			ScopedGlobalRealm(const ScopedGlobalRealm& other) = delete;
+			ScopedGlobalRealm(const ScopedGlobalRealm&& other) = delete;
+			ScopedGlobalRealm operator=(const ScopedGlobalRealm& other) = delete;
+			ScopedGlobalRealm operator=(const ScopedGlobalRealm&& other) = delete;
+
+			~ScopedGlobalRealm();
+
+		private:
+			MemoryRealmBase* m_previousRealm;
+		};
+	}
+}
@@ -1,6 +1,17 @@
 #pragma once
 
+#include <mutex>
+#include <ostream>
+#include <type_traits>
+
 #include "MemoryRealmBase.h"
+#include "../Allocator/ThreadCaching/PerThreadAllocator.h"
+#include "../MemoryTracker/MemoryStatistics.h"
+#include "../MemoryTracker/NoMemoryTracker.h"
+#include "../MemoryTracker/SourceInfo.h"
+#include "../MemoryTagger/NoMemoryTagger.h"
+#include "../PageMap/PageMap.h"
+#include "../ThreadPolicy/NoSyncThreadPolicy.h"
 #include "Pointers/PointerUtil.h"
 
 namespace sp
@@ -9,17 +20,46 @@ namespace sp
 	{
 		/**
 		 * The MemoryRealm is an abstraction over several strategies to allocate and debug memory
-		 * allocations in this system. It takes two template type parameters, allowing to specify
-		 * the allocation and bounds-checking strategy. These have to follow the common API in order
-		 * to work with the memory realm. This allows for flexible creation of different allocators
-		 * that can also change behaviour depending on the platform or build mode, if specified.
+		 * allocations in this system. It takes up to five template type parameters, allowing to specify
+		 * the allocation, bounds-checking, memory tracking, memory tagging and threading strategy (by
+		 * default untracked, untagged and unsynchronized).
+		 * These have to follow the common API in order to work with the memory realm. This allows
+		 * for flexible creation of different allocators that can also change behaviour depending
+		 * on the platform or build mode, if specified.
+		 *
+		 * The ThreadPolicy decides how concurrent use is synchronized: not at all, by a mutex or
+		 * a spinlock around every operation, or by keeping one allocator instance per thread.
+		 *
+		 * The realm calls its strategies by their concrete types only. Used by its concrete type
+		 * (the class is final), allocations with inline strategies like the LinearAllocator and
+		 * the NoBoundsChecker compile down to the allocator's own fast path. Canary handling is
+		 * dropped at compile-time for bounds checkers with a CANARY_SIZE of 0, the same goes for
+		 * all tracking and tagging work with the NoMemoryTracker and NoMemoryTagger.
+		 *
+		 * Allocators that only know an upper bound of the allocation size (HAS_EXACT_ALLOCATION_SIZE
+		 * is false, e.g. header-free pools) can only be used without canaries, tracking and tagging.
+		 *
+		 * Bounds checkers with USES_GUARD_PAGES serve the allocations they decide to guard
+		 * themselves, those never reach the allocator.
+		 *
+		 * All address space reserved while the realm's strategies are constructed is registered
+		 * for the realm in the page map, so sp::memory::Free() routes it through Dealloc() of the
+		 * realm. Allocators reserving later on (size classes, per-thread instances, guard pages)
+		 * remember their owner. Memory of realms built on a MemoryProvider is not registered.
 		 */
-		template <typename Allocator, typename BoundChecker>
-		class MemoryRealm : public MemoryRealmBase
+		template <typename Allocator, typename BoundChecker, typename MemoryTracker = NoMemoryTracker, typename MemoryTagger = NoMemoryTagger, typename ThreadPolicy = NoSyncThreadPolicy>
+		class MemoryRealm final : public MemoryRealmBase
 		{
+			static_assert(!ThreadPolicy::IS_PER_THREAD || (!MemoryTracker::IS_ENABLED && !MemoryTagger::IS_ENABLED),
+				"Memory trackers and taggers are shared between threads and cannot be used with per-thread allocator instances");
+			static_assert(!ThreadPolicy::IS_PER_THREAD || (!BoundChecker::USES_GUARD_PAGES && !BoundChecker::TRACKS_ALLOCATIONS),
+				"Guard page and sweeping bounds checkers are shared between threads and cannot be used with per-thread allocator instances");
+			static_assert(Allocator::HAS_EXACT_ALLOCATION_SIZE || (BoundChecker::CANARY_SIZE == 0 && !MemoryTracker::IS_ENABLED && !MemoryTagger::IS_ENABLED),
+				"Canaries, memory trackers and taggers need the exact allocation size, which header-free pools do not store");
+
 		public:
 			explicit MemoryRealm(size_t bytes)
-				: m_allocator(bytes)
+				: MemoryRealm(ScopedPageOwner(this), bytes)
 			{}
 
 			template<typename MemoryProvider>
@@ -29,37 +69,186 @@ namespace sp
 
 			void* Alloc(size_t bytes, size_t alignment) override
 			{
+				return Alloc(bytes, alignment, SourceInfo{ nullptr, 0u, nullptr });
+			}
+
+			///
+			/// Allocation recording the call-site for the memory tracker, pass SP_SOURCE_INFO
+			///
+			void* Alloc(size_t bytes, size_t alignment, const SourceInfo& sourceInfo)
+			{
+				std::lock_guard<ThreadPolicy> lock(m_threadPolicy);
+
+				if constexpr (BoundChecker::USES_GUARD_PAGES)
+				{
+					if (m_boundsChecker.ShouldGuard())
+					{
+						void* guardedMemory = m_boundsChecker.AllocGuarded(bytes, alignment);
+						if (guardedMemory)
+						{
+							OnAlloc(static_cast<char*>(guardedMemory), bytes, sourceInfo);
+						}
+
+						return guardedMemory;
+					}
+				}
+
 				const size_t totalMemory = BoundChecker::CANARY_SIZE + bytes + BoundChecker::CANARY_SIZE;
 
 				char* memory = static_cast<char*>(m_allocator.Alloc(totalMemory, alignment, BoundChecker::CANARY_SIZE));
+				if (!memory)
+				{
+					return nullptr;
+				}
+
+				char* userMemory = memory + BoundChecker::CANARY_SIZE;
+
+				// Tag first, the tagger checks the whole block for writes after it was freed
+				OnAlloc(userMemory, bytes, sourceInfo);
 
-				m_boundsChecker.WriteCanary(memory);
-				m_boundsChecker.WriteCanary(memory + m_boundsChecker.CANARY_SIZE + bytes);
+				if constexpr (BoundChecker::CANARY_SIZE != 0)
+				{
+					m_boundsChecker.WriteCanary(memory);
+					m_boundsChecker.WriteCanary(userMemory + bytes);
+				}
 
-				return memory + BoundChecker::CANARY_SIZE;
+				if constexpr (BoundChecker::TRACKS_ALLOCATIONS)
+				{
+					m_boundsChecker.OnAlloc(memory, bytes);
+				}
+
+				return userMemory;
 			}
 
 			void Dealloc(void* memory) override
 			{
+				std::lock_guard<ThreadPolicy> lock(m_threadPolicy);
+
+				if constexpr (BoundChecker::USES_GUARD_PAGES)
+				{
+					if (m_boundsChecker.IsGuarded(memory))
+					{
+						// No tagging, the pages are released and every later access faults anyway
+						if constexpr (MemoryTracker::IS_ENABLED)
+						{
+							m_memoryTracker.OnDealloc(memory, m_boundsChecker.GetGuardedSize(memory));
+						}
+
+						m_boundsChecker.DeallocGuarded(memory);
+						return;
+					}
+				}
+
 				char* allocatorMemory = static_cast<char*>(memory) - BoundChecker::CANARY_SIZE;
 
-				m_boundsChecker.ValidateFrontCanary(allocatorMemory);
-				const uint32_t allocationSize = static_cast<uint32_t>(m_allocator.GetAllocationSize(allocatorMemory));
-				m_boundsChecker.ValidateBackCanary(allocatorMemory + (allocationSize - BoundChecker::CANARY_SIZE));
+				// The allocation size is only looked up if any of the strategies needs it
+				if constexpr (BoundChecker::CANARY_SIZE != 0 || MemoryTracker::IS_ENABLED || MemoryTagger::IS_ENABLED)
+				{
+					m_boundsChecker.ValidateFrontCanary(allocatorMemory);
+					const size_t allocationSize = m_allocator.GetAllocationSize(allocatorMemory);
+					m_boundsChecker.ValidateBackCanary(allocatorMemory + (allocationSize - BoundChecker::CANARY_SIZE));
+
+					const size_t userSize = allocationSize - 2u * BoundChecker::CANARY_SIZE;
+
+					if constexpr (BoundChecker::TRACKS_ALLOCATIONS)
+					{
+						m_boundsChecker.OnDealloc(allocatorMemory);
+					}
+
+					if constexpr (MemoryTracker::IS_ENABLED)
+					{
+						m_memoryTracker.OnDealloc(memory, userSize);
+					}
+
+					if constexpr (MemoryTagger::IS_ENABLED)
+					{
+						m_memoryTagger.TagDeallocation(memory, userSize);
+					}
+				}
 
 				m_allocator.Dealloc(allocatorMemory);
 			}
 
 			void Reset(void) override
 			{
+				std::lock_guard<ThreadPolicy> lock(m_threadPolicy);
+
 				m_allocator.Reset();
+
+				if constexpr (BoundChecker::USES_GUARD_PAGES || BoundChecker::TRACKS_ALLOCATIONS)
+				{
+					m_boundsChecker.Reset();
+				}
+
+				m_memoryTracker.OnReset();
+				m_memoryTagger.OnReset();
+			}
+
+			///
+			/// Validates the canaries of all live allocations and returns the first corrupted
+			/// block, requires a bounds checker tracking its allocations (e.g. SweepingBoundsChecker)
+			///
+			auto ValidateAll(void)
+			{
+				static_assert(BoundChecker::TRACKS_ALLOCATIONS, "ValidateAll() requires a bounds checker that tracks live allocations");
+
+				std::lock_guard<ThreadPolicy> lock(m_threadPolicy);
+				return m_boundsChecker.ValidateAll();
+			}
+
+			/// Snapshot of the tracker's counters, taken under the lock of the thread policy
+			MemoryStatistics GetStatistics(void) const
+			{
+				static_assert(MemoryTracker::IS_ENABLED, "GetStatistics() requires a memory tracker");
+
+				std::lock_guard<ThreadPolicy> lock(m_threadPolicy);
+				return m_memoryTracker.GetStatistics();
+			}
+
+			/// Writes a JSON snapshot of the tracker, other threads are blocked while it is written
+			void WriteJson(std::ostream& stream) const
+			{
+				std::lock_guard<ThreadPolicy> lock(m_threadPolicy);
+				m_memoryTracker.WriteJson(stream);
+			}
+
+			///
+			/// Direct access to the tracker, e.g. to the records of the FullMemoryTracker. The
+			/// reference is not synchronized, only use it while no other thread uses the realm.
+			///
+			const MemoryTracker& GetMemoryTracker(void) const
+			{
+				return m_memoryTracker;
 			}
 
 			~MemoryRealm() = default;
 
 		private:
-			Allocator m_allocator;
+			MemoryRealm(ScopedPageOwner&&, size_t bytes)
+				: m_allocator(bytes)
+			{}
+
+			void OnAlloc(char* userMemory, size_t bytes, const SourceInfo& sourceInfo)
+			{
+				if constexpr (MemoryTagger::IS_ENABLED)
+				{
+					m_memoryTagger.TagAllocation(userMemory, bytes);
+				}
+
+				if constexpr (MemoryTracker::IS_ENABLED)
+				{
+					m_memoryTracker.OnAlloc(userMemory, bytes, sourceInfo);
+				}
+			}
+
+			typedef typename std::conditional<ThreadPolicy::IS_PER_THREAD, PerThreadAllocator<Allocator>, Allocator>::type AllocatorType;
+
+			AllocatorType m_allocator;
 			BoundChecker m_boundsChecker;
+			MemoryTracker m_memoryTracker;
+			MemoryTagger m_memoryTagger;
+			// Locked by the const snapshot accessors as well
+			mutable ThreadPolicy m_threadPolicy;
 		};
 	}
 }
\ No newline at end of file
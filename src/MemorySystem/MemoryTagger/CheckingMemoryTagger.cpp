@@ -0,0 +1,98 @@
+#include "CheckingMemoryTagger.h"
+
+#include <cassert>
+#include <iterator>
+
+#include "../VirtualMemory/VirtualMemory.h"
+
+namespace
+{
+	static const size_t ALLOCATOR_LINK_SIZE = sizeof(void*);
+}
+
+const size_t sp::memory::CheckingMemoryTagger::MAX_TRACKED_FREED_BLOCKS;
+
+sp::memory::CheckingMemoryTagger::CheckingMemoryTagger()
+{
+	AddMemoryReleaseListener(&CheckingMemoryTagger::OnMemoryReleased, this);
+}
+
+void sp::memory::CheckingMemoryTagger::TagAllocation(void* memory, size_t size)
+{
+	const char* begin = static_cast<const char*>(memory);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		const auto freedBlock = m_freedBlocks.find(begin);
+		if (freedBlock != m_freedBlocks.end() && freedBlock->second > ALLOCATOR_LINK_SIZE)
+		{
+			const bool isUntouchedSinceFree = IsFilledWithPattern(begin + ALLOCATOR_LINK_SIZE, freedBlock->second - ALLOCATOR_LINK_SIZE, FREED_MEMORY_PATTERN);
+			assert(isUntouchedSinceFree && "Freed memory was written after free");
+		}
+
+		// Blocks merged into this one by the allocator are overwritten from now on as well
+		ForgetBlocks(begin, begin + size);
+	}
+
+	FillPattern(memory, size, ALLOCATED_MEMORY_PATTERN);
+}
+
+void sp::memory::CheckingMemoryTagger::TagDeallocation(void* memory, size_t size)
+{
+	FillPattern(memory, size, FREED_MEMORY_PATTERN);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_freedBlocks.size() >= MAX_TRACKED_FREED_BLOCKS)
+	{
+		m_freedBlocks.erase(m_freedBlocks.begin());
+	}
+
+	m_freedBlocks[static_cast<const char*>(memory)] = size;
+}
+
+///
+/// Reset hands all memory out again without freeing single blocks first
+///
+void sp::memory::CheckingMemoryTagger::OnReset(void)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_freedBlocks.clear();
+}
+
+size_t sp::memory::CheckingMemoryTagger::GetTrackedBlockCount(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_freedBlocks.size();
+}
+
+sp::memory::CheckingMemoryTagger::~CheckingMemoryTagger()
+{
+	RemoveMemoryReleaseListener(&CheckingMemoryTagger::OnMemoryReleased, this);
+}
+
+void sp::memory::CheckingMemoryTagger::OnMemoryReleased(void* context, const void* from, size_t size)
+{
+	CheckingMemoryTagger* tagger = static_cast<CheckingMemoryTagger*>(context);
+	const char* begin = static_cast<const char*>(from);
+
+	std::lock_guard<std::mutex> lock(tagger->m_mutex);
+	tagger->ForgetBlocks(begin, begin + size);
+}
+
+void sp::memory::CheckingMemoryTagger::ForgetBlocks(const char* begin, const char* end)
+{
+	auto first = m_freedBlocks.lower_bound(begin);
+
+	// The block in front may reach into the range
+	if (first != m_freedBlocks.begin())
+	{
+		const auto previous = std::prev(first);
+		if (previous->first + previous->second > begin)
+		{
+			first = previous;
+		}
+	}
+
+	m_freedBlocks.erase(first, m_freedBlocks.lower_bound(end));
+}
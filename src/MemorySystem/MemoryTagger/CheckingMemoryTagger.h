@@ -0,0 +1,57 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "MemoryPattern.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Memory tagging strategy that fills memory like the FillingMemoryTagger and
+		 * additionally remembers freed blocks. When the allocator hands out a block at
+		 * the address of a freed one again, the freed range has to still hold the freed
+		 * pattern, otherwise it was written after free.
+		 *
+		 * The first pointer-sized bytes of a freed block are not checked, allocators keep
+		 * their free-list links there. Blocks in ranges that are decommitted or whose address
+		 * space is freed are forgotten, those read back as zero once they are committed again.
+		 * At most MAX_TRACKED_FREED_BLOCKS blocks are remembered, beyond that the ones at
+		 * the lowest addresses are dropped.
+		 */
+		class CheckingMemoryTagger
+		{
+		public:
+			static constexpr bool IS_ENABLED = true;
+			static const size_t MAX_TRACKED_FREED_BLOCKS = 64 * 1024;
+
+			CheckingMemoryTagger();
+
+			CheckingMemoryTagger(const CheckingMemoryTagger& other) = delete;
+			CheckingMemoryTagger(const CheckingMemoryTagger&& other) = delete;
+			CheckingMemoryTagger operator=(const CheckingMemoryTagger& other) = delete;
+			CheckingMemoryTagger operator=(const CheckingMemoryTagger&& other) = delete;
+
+			void TagAllocation(void* memory, size_t size);
+			void TagDeallocation(void* memory, size_t size);
+			void OnReset(void);
+
+			/// Number of freed blocks that are checked once their address is handed out again
+			size_t GetTrackedBlockCount(void) const;
+
+			~CheckingMemoryTagger();
+
+		private:
+			static void OnMemoryReleased(void* context, const void* from, size_t size);
+
+			/// Drops all blocks overlapping [begin, end), the mutex has to be held
+			void ForgetBlocks(const char* begin, const char* end);
+
+			// Released memory is reported from any thread, not only the one of the realm
+			mutable std::mutex m_mutex;
+			std::map<const char*, size_t> m_freedBlocks;
+		};
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "MemoryPattern.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Memory tagging strategy that fills new allocations with ALLOCATED_MEMORY_PATTERN (0xCD)
+		 * and freed ones with FREED_MEMORY_PATTERN (0xDD), so reads of uninitialized or freed
+		 * memory stand out in the debugger.
+		 */
+		class FillingMemoryTagger
+		{
+		public:
+			static constexpr bool IS_ENABLED = true;
+
+			void TagAllocation(void* memory, size_t size)
+			{
+				FillPattern(memory, size, ALLOCATED_MEMORY_PATTERN);
+			}
+
+			void TagDeallocation(void* memory, size_t size)
+			{
+				FillPattern(memory, size, FREED_MEMORY_PATTERN);
+			}
+
+			void OnReset(void) {}
+		};
+	}
+}
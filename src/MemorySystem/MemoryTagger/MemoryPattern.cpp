@@ -0,0 +1,112 @@
+#include "MemoryPattern.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SP_PATTERN_VECTOR_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SP_PATTERN_VECTOR_WIDTH 16
+#else
+#define SP_PATTERN_VECTOR_WIDTH 0
+#endif
+
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	///
+	/// Splits [memory, memory + size) into an unaligned scalar head, a body of whole
+	/// vectors starting at a vector-aligned address and a scalar tail
+	///
+	template <typename ScalarFunc, typename VectorFunc>
+	bool ForEachChunk(char* memory, size_t size, ScalarFunc scalar, VectorFunc vector)
+	{
+#if SP_PATTERN_VECTOR_WIDTH > 0
+		const size_t vectorWidth = SP_PATTERN_VECTOR_WIDTH;
+		char* alignedBegin = sp::pointerUtil::AlignTop(memory, vectorWidth);
+		const size_t headSize = static_cast<size_t>(alignedBegin - memory);
+
+		if (headSize < size)
+		{
+			if (!scalar(memory, headSize))
+			{
+				return false;
+			}
+
+			const size_t bodySize = (size - headSize) & ~(vectorWidth - 1);
+			for (char* current = alignedBegin; current < alignedBegin + bodySize; current += vectorWidth)
+			{
+				if (!vector(current))
+				{
+					return false;
+				}
+			}
+
+			return scalar(alignedBegin + bodySize, size - headSize - bodySize);
+		}
+#endif
+		return scalar(memory, size);
+	}
+}
+
+void sp::memory::FillPattern(void* memory, size_t size, uint8_t pattern)
+{
+#if SP_PATTERN_VECTOR_WIDTH == 32
+	const __m256i patternVector = _mm256_set1_epi8(static_cast<char>(pattern));
+#elif SP_PATTERN_VECTOR_WIDTH == 16
+	const __m128i patternVector = _mm_set1_epi8(static_cast<char>(pattern));
+#endif
+
+	ForEachChunk(static_cast<char*>(memory), size,
+		[pattern](char* begin, size_t count)
+		{
+			for (size_t idx = 0; idx < count; ++idx)
+			{
+				begin[idx] = static_cast<char>(pattern);
+			}
+			return true;
+		},
+		[&](char* vector)
+		{
+#if SP_PATTERN_VECTOR_WIDTH == 32
+			_mm256_store_si256(reinterpret_cast<__m256i*>(vector), patternVector);
+#elif SP_PATTERN_VECTOR_WIDTH == 16
+			_mm_store_si128(reinterpret_cast<__m128i*>(vector), patternVector);
+#endif
+			return true;
+		});
+}
+
+bool sp::memory::IsFilledWithPattern(const void* memory, size_t size, uint8_t pattern)
+{
+#if SP_PATTERN_VECTOR_WIDTH == 32
+	const __m256i patternVector = _mm256_set1_epi8(static_cast<char>(pattern));
+#elif SP_PATTERN_VECTOR_WIDTH == 16
+	const __m128i patternVector = _mm_set1_epi8(static_cast<char>(pattern));
+#endif
+
+	return ForEachChunk(const_cast<char*>(static_cast<const char*>(memory)), size,
+		[pattern](char* begin, size_t count)
+		{
+			for (size_t idx = 0; idx < count; ++idx)
+			{
+				if (static_cast<uint8_t>(begin[idx]) != pattern)
+				{
+					return false;
+				}
+			}
+			return true;
+		},
+		[&](char* vector)
+		{
+#if SP_PATTERN_VECTOR_WIDTH == 32
+			const __m256i equal = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(vector)), patternVector);
+			return _mm256_movemask_epi8(equal) == -1;
+#elif SP_PATTERN_VECTOR_WIDTH == 16
+			const __m128i equal = _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(vector)), patternVector);
+			return _mm_movemask_epi8(equal) == 0xFFFF;
+#else
+			return true;
+#endif
+		});
+}
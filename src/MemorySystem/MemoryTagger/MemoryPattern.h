@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace sp
+{
+	namespace memory
+	{
+		/// Pattern written to fresh allocations, reading it hints at uninitialized memory
+		static const uint8_t ALLOCATED_MEMORY_PATTERN = 0xCD;
+		/// Pattern written to freed allocations, reading it hints at use-after-free
+		static const uint8_t FREED_MEMORY_PATTERN = 0xDD;
+
+		/**
+		 * Pattern fill and check with the widest vector stores/loads enabled for the build
+		 * (AVX2, SSE2, scalar fallback), so large blocks run at memory bandwidth.
+		 */
+		void FillPattern(void* memory, size_t size, uint8_t pattern);
+		bool IsFilledWithPattern(const void* memory, size_t size, uint8_t pattern);
+	}
+}
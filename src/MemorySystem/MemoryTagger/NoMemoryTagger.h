@@ -0,0 +1,21 @@
+#pragma once
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Memory tagging strategy that leaves memory untouched. Realms check
+		 * IS_ENABLED at compile-time and drop all tagging work.
+		 */
+		class NoMemoryTagger
+		{
+		public:
+			static constexpr bool IS_ENABLED = false;
+
+			void TagAllocation(void* memory, size_t size) {}
+			void TagDeallocation(void* memory, size_t size) {}
+			void OnReset(void) {}
+		};
+	}
+}
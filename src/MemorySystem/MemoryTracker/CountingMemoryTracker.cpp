@@ -0,0 +1,50 @@
+#include "CountingMemoryTracker.h"
+
+sp::memory::CountingMemoryTracker::CountingMemoryTracker()
+	: m_liveBytes(0u)
+	, m_peakBytes(0u)
+	, m_liveAllocations(0u)
+	, m_totalAllocations(0u)
+	, m_creationTime(std::chrono::steady_clock::now())
+{}
+
+///
+/// Resetting the realm frees all allocations at once, the peak and the
+/// total count keep their values
+///
+void sp::memory::CountingMemoryTracker::OnReset(void)
+{
+	m_liveBytes = 0u;
+	m_liveAllocations = 0u;
+}
+
+sp::memory::MemoryStatistics sp::memory::CountingMemoryTracker::GetStatistics(void) const
+{
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_creationTime;
+
+	MemoryStatistics statistics;
+	statistics.liveBytes = m_liveBytes;
+	statistics.peakBytes = m_peakBytes;
+	statistics.liveAllocations = m_liveAllocations;
+	statistics.totalAllocations = m_totalAllocations;
+	statistics.allocationsPerSecond = elapsed.count() > 0.0 ? m_totalAllocations / elapsed.count() : 0.0;
+	return statistics;
+}
+
+void sp::memory::CountingMemoryTracker::WriteJson(std::ostream& stream) const
+{
+	stream << '{';
+	WriteJsonCounters(stream);
+	stream << '}';
+}
+
+void sp::memory::CountingMemoryTracker::WriteJsonCounters(std::ostream& stream) const
+{
+	const MemoryStatistics statistics = GetStatistics();
+
+	stream << "\"liveBytes\":" << statistics.liveBytes
+		<< ",\"peakBytes\":" << statistics.peakBytes
+		<< ",\"liveAllocations\":" << statistics.liveAllocations
+		<< ",\"totalAllocations\":" << statistics.totalAllocations
+		<< ",\"allocationsPerSecond\":" << statistics.allocationsPerSecond;
+}
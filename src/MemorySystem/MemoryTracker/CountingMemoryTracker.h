@@ -0,0 +1,65 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+
+#include "SourceInfo.h"
+#include "MemoryStatistics.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Memory tracking strategy that keeps a handful of counters: live and peak
+		 * bytes, live and total allocations and the allocation rate since the tracker
+		 * was created. Cheap enough to stay enabled in production, comparing two
+		 * snapshots shows whether a realm grows between frames.
+		 */
+		class CountingMemoryTracker
+		{
+		public:
+			static constexpr bool IS_ENABLED = true;
+
+			CountingMemoryTracker();
+
+			void OnAlloc(void* memory, size_t size, const SourceInfo& sourceInfo);
+			void OnDealloc(void* memory, size_t size);
+			void OnReset(void);
+
+			MemoryStatistics GetStatistics(void) const;
+
+			void WriteJson(std::ostream& stream) const;
+			/// Writes the counters as comma-separated JSON members, for trackers embedding them
+			void WriteJsonCounters(std::ostream& stream) const;
+
+		private:
+			size_t m_liveBytes;
+			size_t m_peakBytes;
+			size_t m_liveAllocations;
+			size_t m_totalAllocations;
+			std::chrono::steady_clock::time_point m_creationTime;
+		};
+
+#pragma region Implementation
+
+		inline void CountingMemoryTracker::OnAlloc(void* memory, size_t size, const SourceInfo& sourceInfo)
+		{
+			m_liveBytes += size;
+			++m_liveAllocations;
+			++m_totalAllocations;
+
+			if (m_liveBytes > m_peakBytes)
+			{
+				m_peakBytes = m_liveBytes;
+			}
+		}
+
+		inline void CountingMemoryTracker::OnDealloc(void* memory, size_t size)
+		{
+			m_liveBytes -= size;
+			--m_liveAllocations;
+		}
+
+#pragma endregion
+	}
+}
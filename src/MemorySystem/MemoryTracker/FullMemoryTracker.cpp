@@ -0,0 +1,85 @@
+#include "FullMemoryTracker.h"
+
+#include <cassert>
+
+namespace
+{
+	void WriteJsonString(std::ostream& stream, const char* string)
+	{
+		stream << '"';
+		for (const char* character = string ? string : ""; *character != '\0'; ++character)
+		{
+			if (*character == '"' || *character == '\\')
+			{
+				stream << '\\';
+			}
+			stream << *character;
+		}
+		stream << '"';
+	}
+}
+
+void sp::memory::FullMemoryTracker::OnAlloc(void* memory, size_t size, const SourceInfo& sourceInfo)
+{
+	m_counters.OnAlloc(memory, size, sourceInfo);
+
+	AllocationRecord record;
+	record.size = size;
+	record.sourceInfo = sourceInfo;
+	m_records[memory] = record;
+}
+
+void sp::memory::FullMemoryTracker::OnDealloc(void* memory, size_t size)
+{
+	{
+		const bool isTracked = m_records.find(memory) != m_records.end();
+		assert(isTracked && "Freeing memory that was not allocated from this realm");
+	}
+
+	m_counters.OnDealloc(memory, size);
+	m_records.erase(memory);
+}
+
+void sp::memory::FullMemoryTracker::OnReset(void)
+{
+	m_counters.OnReset();
+	m_records.clear();
+}
+
+sp::memory::MemoryStatistics sp::memory::FullMemoryTracker::GetStatistics(void) const
+{
+	return m_counters.GetStatistics();
+}
+
+const std::unordered_map<const void*, sp::memory::FullMemoryTracker::AllocationRecord>& sp::memory::FullMemoryTracker::GetAllocationRecords(void) const
+{
+	return m_records;
+}
+
+///
+/// Writes the counters followed by the records of all live allocations
+///
+void sp::memory::FullMemoryTracker::WriteJson(std::ostream& stream) const
+{
+	stream << '{';
+	m_counters.WriteJsonCounters(stream);
+	stream << ",\"allocations\":[";
+
+	bool isFirstRecord = true;
+	for (const auto& entry : m_records)
+	{
+		if (!isFirstRecord)
+		{
+			stream << ',';
+		}
+		isFirstRecord = false;
+
+		stream << "{\"address\":\"" << entry.first << "\",\"size\":" << entry.second.size << ",\"file\":";
+		WriteJsonString(stream, entry.second.sourceInfo.file);
+		stream << ",\"line\":" << entry.second.sourceInfo.line << ",\"function\":";
+		WriteJsonString(stream, entry.second.sourceInfo.function);
+		stream << '}';
+	}
+
+	stream << "]}";
+}
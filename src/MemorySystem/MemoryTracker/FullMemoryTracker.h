@@ -0,0 +1,41 @@
+#pragma once
+#include <ostream>
+#include <unordered_map>
+
+#include "CountingMemoryTracker.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Memory tracking strategy that keeps the counters of the CountingMemoryTracker
+		 * and additionally records size and call-site of every live allocation in a side
+		 * table. Meant for tracking down leaks and growth in development builds.
+		 */
+		class FullMemoryTracker
+		{
+		public:
+			static constexpr bool IS_ENABLED = true;
+
+			struct AllocationRecord
+			{
+				size_t size;
+				SourceInfo sourceInfo;
+			};
+
+			void OnAlloc(void* memory, size_t size, const SourceInfo& sourceInfo);
+			void OnDealloc(void* memory, size_t size);
+			void OnReset(void);
+
+			MemoryStatistics GetStatistics(void) const;
+			const std::unordered_map<const void*, AllocationRecord>& GetAllocationRecords(void) const;
+
+			void WriteJson(std::ostream& stream) const;
+
+		private:
+			CountingMemoryTracker m_counters;
+			std::unordered_map<const void*, AllocationRecord> m_records;
+		};
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Snapshot of the counters kept by the counting and full memory trackers.
+		 * Sizes are the sizes requested by the user, without any bookkeeping overhead.
+		 */
+		struct MemoryStatistics
+		{
+			size_t liveBytes;
+			size_t peakBytes;
+			size_t liveAllocations;
+			size_t totalAllocations;
+			double allocationsPerSecond;
+		};
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <ostream>
+
+#include "SourceInfo.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Memory tracking strategy that does not track anything. Realms check
+		 * IS_ENABLED at compile-time and drop all tracking work, including the
+		 * allocation size lookup on Dealloc().
+		 */
+		class NoMemoryTracker
+		{
+		public:
+			static constexpr bool IS_ENABLED = false;
+
+			void OnAlloc(void* memory, size_t size, const SourceInfo& sourceInfo) {}
+			void OnDealloc(void* memory, size_t size) {}
+			void OnReset(void) {}
+
+			void WriteJson(std::ostream& stream) const
+			{
+				stream << "{}";
+			}
+		};
+	}
+}
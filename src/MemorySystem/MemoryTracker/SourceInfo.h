@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Call-site of an allocation, recorded by the full memory tracker.
+		 * Use SP_SOURCE_INFO to capture the current location.
+		 */
+		struct SourceInfo
+		{
+			const char* file;
+			uint32_t line;
+			const char* function;
+		};
+	}
+}
+
+#define SP_SOURCE_INFO sp::memory::SourceInfo{ __FILE__, static_cast<uint32_t>(__LINE__), __FUNCTION__ }
@@ -0,0 +1,260 @@
+#include "PageMap.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+
+#include "../Allocator/AllocatorBase.h"
+
+namespace
+{
+	// Same as the ConcurrentFreeList, x86-64 only uses the lower 48 bits of an address
+#if UINTPTR_MAX == UINT32_MAX
+	static const uint32_t ADDRESS_BITS = 32;
+	static const uint32_t LEVEL_BITS = 10;
+#else
+	static const uint32_t ADDRESS_BITS = 48;
+	static const uint32_t LEVEL_BITS = 12;
+#endif
+	static const uint32_t PAGE_NUMBER_BITS = ADDRESS_BITS - sp::memory::PAGE_MAP_PAGE_SIZE_LOG2;
+	static const size_t LEVEL_SIZE = size_t(1) << LEVEL_BITS;
+	static const uintptr_t LEVEL_MASK = LEVEL_SIZE - 1u;
+
+	// The root takes the bits above a span node and a leaf, a single entry on 32-bit
+	static_assert(PAGE_NUMBER_BITS >= 2u * LEVEL_BITS, "The page map has more levels than page number bits");
+	static const size_t ROOT_SIZE = size_t(1) << (PAGE_NUMBER_BITS - 2u * LEVEL_BITS);
+
+	// Set on span entries that hold the owner of the whole span instead of a leaf
+	static const uintptr_t SPAN_OWNER_TAG = 2u;
+	static_assert(SPAN_OWNER_TAG != sp::memory::PageOwner::REALM_TAG, "Tags of the page map and the owner overlap");
+
+	///
+	/// One owner per page
+	///
+	struct Leaf
+	{
+		std::atomic<uintptr_t> owners[LEVEL_SIZE];
+	};
+
+	///
+	/// One entry per span of LEVEL_SIZE pages, either a Leaf* or an owner tagged with SPAN_OWNER_TAG
+	///
+	struct SpanNode
+	{
+		std::atomic<uintptr_t> spans[LEVEL_SIZE];
+	};
+
+	std::atomic<SpanNode*> g_pageMapRoot[ROOT_SIZE];
+
+	// Value of the outermost ScopedPageOwner, a plain integer keeps the thread_local constant-initialized
+	thread_local uintptr_t t_scopedPageOwner = 0u;
+
+	///
+	/// Nodes come from calloc instead of the virtual memory system, allocating them must
+	/// neither register pages again nor be routed into a realm by the global new/delete
+	///
+	template <typename Node>
+	Node* GetOrCreate(std::atomic<Node*>& slot)
+	{
+		Node* node = slot.load(std::memory_order_acquire);
+		if (node)
+		{
+			return node;
+		}
+
+		Node* newNode = static_cast<Node*>(std::calloc(1u, sizeof(Node)));
+		assert(newNode && "Out of memory while growing the page map");
+
+		if (slot.compare_exchange_strong(node, newNode, std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			return newNode;
+		}
+
+		// Another thread was faster, node holds its winner now
+		std::free(newNode);
+		return node;
+	}
+
+	///
+	/// Returns the leaf of a span, a span owned as a whole is split into single pages first
+	///
+	Leaf* GetOrCreateLeaf(std::atomic<uintptr_t>& span)
+	{
+		uintptr_t entry = span.load(std::memory_order_acquire);
+		if (entry != 0u && (entry & SPAN_OWNER_TAG) == 0u)
+		{
+			return reinterpret_cast<Leaf*>(entry);
+		}
+
+		Leaf* newLeaf = static_cast<Leaf*>(std::calloc(1u, sizeof(Leaf)));
+		assert(newLeaf && "Out of memory while growing the page map");
+
+		// Only one reservation covers the span, nobody else can race on splitting it
+		const uintptr_t spanOwner = entry & ~SPAN_OWNER_TAG;
+		for (std::atomic<uintptr_t>& owner : newLeaf->owners)
+		{
+			owner.store(spanOwner, std::memory_order_relaxed);
+		}
+
+		if (span.compare_exchange_strong(entry, reinterpret_cast<uintptr_t>(newLeaf), std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			return newLeaf;
+		}
+
+		std::free(newLeaf);
+		return reinterpret_cast<Leaf*>(entry);
+	}
+
+	///
+	/// Writes owner into all pages of [begin, end), an owner of 0 clears them. Whole spans
+	/// get a single entry unless they already have a leaf, which is kept and filled instead.
+	///
+	void SetPageOwners(const void* begin, size_t size, uintptr_t owner)
+	{
+		if (size == 0u)
+		{
+			return;
+		}
+
+		const uintptr_t firstPage = reinterpret_cast<uintptr_t>(begin) >> sp::memory::PAGE_MAP_PAGE_SIZE_LOG2;
+		const uintptr_t endPage = ((reinterpret_cast<uintptr_t>(begin) + size - 1u) >> sp::memory::PAGE_MAP_PAGE_SIZE_LOG2) + 1u;
+
+#if UINTPTR_MAX != UINT32_MAX
+		{
+			const bool isInsideAddressSpace = (endPage - 1u) >> PAGE_NUMBER_BITS == 0u;
+			assert(isInsideAddressSpace && "The page map only covers a 48-bit address space");
+		}
+#endif
+
+		uintptr_t page = firstPage;
+		while (page < endPage)
+		{
+			const uintptr_t spanBegin = page & ~LEVEL_MASK;
+			const uintptr_t spanEnd = spanBegin + LEVEL_SIZE;
+			const uintptr_t rangeEnd = endPage < spanEnd ? endPage : spanEnd;
+
+			std::atomic<SpanNode*>& rootEntry = g_pageMapRoot[page >> (2u * LEVEL_BITS)];
+			SpanNode* node = owner != 0u ? GetOrCreate(rootEntry) : rootEntry.load(std::memory_order_acquire);
+			if (!node)
+			{
+				// Nothing was ever registered in this part of the address space
+				page = (page | ((LEVEL_SIZE * LEVEL_SIZE) - 1u)) + 1u;
+				continue;
+			}
+
+			std::atomic<uintptr_t>& span = node->spans[(page >> LEVEL_BITS) & LEVEL_MASK];
+			const uintptr_t entry = span.load(std::memory_order_acquire);
+			const bool coversSpan = page == spanBegin && rangeEnd == spanEnd;
+			const bool hasLeaf = entry != 0u && (entry & SPAN_OWNER_TAG) == 0u;
+
+			if (coversSpan && !hasLeaf)
+			{
+				span.store(owner != 0u ? owner | SPAN_OWNER_TAG : 0u, std::memory_order_release);
+			}
+			else if (entry != 0u || owner != 0u)
+			{
+				Leaf* leaf = GetOrCreateLeaf(span);
+				for (uintptr_t idx = page; idx < rangeEnd; ++idx)
+				{
+					leaf->owners[idx & LEVEL_MASK].store(owner, std::memory_order_release);
+				}
+			}
+
+			page = rangeEnd;
+		}
+	}
+}
+
+void sp::memory::RegisterPages(const void* begin, size_t size, PageOwner owner)
+{
+	{
+		const bool isValidOwner = owner.IsValid();
+		assert(isValidOwner && "Pages have to be registered for an allocator or a realm");
+	}
+
+	SetPageOwners(begin, size, owner.GetValue());
+}
+
+void sp::memory::UnregisterPages(const void* begin, size_t size)
+{
+	SetPageOwners(begin, size, 0u);
+}
+
+sp::memory::PageOwner sp::memory::FindPageOwner(const void* memory)
+{
+	const uintptr_t page = reinterpret_cast<uintptr_t>(memory) >> PAGE_MAP_PAGE_SIZE_LOG2;
+#if UINTPTR_MAX != UINT32_MAX
+	if (page >> PAGE_NUMBER_BITS != 0u)
+	{
+		return PageOwner();
+	}
+#endif
+
+	const SpanNode* node = g_pageMapRoot[page >> (2u * LEVEL_BITS)].load(std::memory_order_acquire);
+	if (!node)
+	{
+		return PageOwner();
+	}
+
+	const uintptr_t entry = node->spans[(page >> LEVEL_BITS) & LEVEL_MASK].load(std::memory_order_acquire);
+	if (entry & SPAN_OWNER_TAG)
+	{
+		return PageOwner::FromValue(entry & ~SPAN_OWNER_TAG);
+	}
+
+	const Leaf* leaf = reinterpret_cast<const Leaf*>(entry);
+	if (!leaf)
+	{
+		return PageOwner();
+	}
+
+	return PageOwner::FromValue(leaf->owners[page & LEVEL_MASK].load(std::memory_order_acquire));
+}
+
+void sp::memory::Free(void* memory)
+{
+	if (!memory)
+	{
+		return;
+	}
+
+	const PageOwner owner = FindPageOwner(memory);
+
+	{
+		const bool hasOwner = owner.IsValid();
+		assert(hasOwner && "Memory was not allocated from an allocator or realm registered in the page map");
+	}
+
+	if (owner.IsRealm())
+	{
+		owner.GetRealm()->Dealloc(memory);
+	}
+	else
+	{
+		owner.GetAllocator()->Dealloc(memory);
+	}
+}
+
+sp::memory::ScopedPageOwner::ScopedPageOwner(PageOwner owner)
+	: m_isOutermost(t_scopedPageOwner == 0u)
+{
+	if (m_isOutermost)
+	{
+		t_scopedPageOwner = owner.GetValue();
+	}
+}
+
+sp::memory::ScopedPageOwner::~ScopedPageOwner()
+{
+	if (m_isOutermost)
+	{
+		t_scopedPageOwner = 0u;
+	}
+}
+
+sp::memory::PageOwner sp::memory::ResolvePageOwner(PageOwner fallback)
+{
+	return t_scopedPageOwner != 0u ? PageOwner::FromValue(t_scopedPageOwner) : fallback;
+}
+
+const uintptr_t sp::memory::PageOwner::REALM_TAG;
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../MemoryRealm/MemoryRealmBase.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		class AllocatorBase;
+
+		/**
+		 * Owner of a range of pages in the page map, either an allocator or a realm.
+		 * Memory of a realm is freed through the realm, so its bounds checking,
+		 * tracking and locking are not bypassed.
+		 */
+		class PageOwner
+		{
+		public:
+			PageOwner(void) : m_value(0u) {}
+			PageOwner(AllocatorBase* allocator) : m_value(reinterpret_cast<uintptr_t>(allocator)) {}
+			PageOwner(MemoryRealmBase* realm) : m_value(realm ? reinterpret_cast<uintptr_t>(realm) | REALM_TAG : 0u) {}
+
+			bool IsValid(void) const { return m_value != 0u; }
+			bool IsRealm(void) const { return (m_value & REALM_TAG) != 0u; }
+
+			AllocatorBase* GetAllocator(void) const { return IsRealm() ? nullptr : reinterpret_cast<AllocatorBase*>(m_value); }
+			MemoryRealmBase* GetRealm(void) const { return IsRealm() ? reinterpret_cast<MemoryRealmBase*>(m_value & ~REALM_TAG) : nullptr; }
+
+			bool operator==(const PageOwner& other) const { return m_value == other.m_value; }
+			bool operator!=(const PageOwner& other) const { return m_value != other.m_value; }
+
+			/// The tagged value as it is stored in the page map
+			uintptr_t GetValue(void) const { return m_value; }
+			static PageOwner FromValue(uintptr_t value) { PageOwner owner; owner.m_value = value; return owner; }
+
+			// Both owner types are polymorphic and at least pointer aligned, the low bits are free
+			static const uintptr_t REALM_TAG = 1u;
+
+		private:
+			uintptr_t m_value;
+		};
+
+		/**
+		 * Process-wide map from the address of a page to the allocator or realm owning
+		 * it. ReserveAddressSpace() fills it in for every reservation made on behalf of
+		 * an owner, FreeAddressSpace() removes the range again.
+		 *
+		 * The map is a radix tree over the 36-bit page numbers of a 48-bit address space
+		 * (20-bit page numbers on 32-bit builds). A lookup is three dependent loads and
+		 * needs no lock, registrations of different ranges may run concurrently. Spans of
+		 * 16 MiB (4 MiB on 32-bit) that belong to a single reservation store their owner
+		 * once instead of once per page, so even reservations of many GiB only cost a few
+		 * bytes. Nodes of the tree are never released.
+		 */
+		static const uint32_t PAGE_MAP_PAGE_SIZE_LOG2 = 12;
+
+		void RegisterPages(const void* begin, size_t size, PageOwner owner);
+		void UnregisterPages(const void* begin, size_t size);
+
+		/// Owner of the page containing memory, invalid if the page was not registered
+		PageOwner FindPageOwner(const void* memory);
+
+		/**
+		 * Frees memory through the allocator or realm owning its page, no matter which one
+		 * that is. Asserts if the page has no owner, e.g. for memory from the stack, malloc,
+		 * a realm working in caller-provided memory or a ReserveAddressSpace() call without
+		 * an owner. Freeing a nullptr does nothing.
+		 */
+		void Free(void* memory);
+
+		/**
+		 * Attributes all address space the calling thread reserves for the lifetime of this
+		 * object to the given owner, instead of to the allocator doing the reservation. The
+		 * outermost scope wins, so a realm owns everything its allocator reserves even if
+		 * that allocator opens a scope of its own.
+		 */
+		class ScopedPageOwner
+		{
+		public:
+			explicit ScopedPageOwner(PageOwner owner);
+
+			ScopedPageOwner(const ScopedPageOwner& other) = delete;
+			ScopedPageOwner(const ScopedPageOwner&& other) = delete;
+			ScopedPageOwner operator=(const ScopedPageOwner& other) = delete;
+			ScopedPageOwner operator=(const ScopedPageOwner&& other) = delete;
+
+			~ScopedPageOwner();
+
+		private:
+			bool m_isOutermost;
+		};
+
+		/// Owner of the outermost ScopedPageOwner of the calling thread, otherwise the fallback
+		PageOwner ResolvePageOwner(PageOwner fallback);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../Allocator/AllocatorBase.h"
+#include "../MemoryRealm/MemoryRealmBase.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Non-owning reference to either an AllocatorBase or a MemoryRealmBase, so the
+		 * STL adapters can draw memory from both without caring which one it is.
+		 */
+		class AllocatorReference
+		{
+		public:
+			explicit AllocatorReference(AllocatorBase& allocator)
+				: m_allocator(&allocator)
+				, m_realm(nullptr)
+			{}
+
+			explicit AllocatorReference(MemoryRealmBase& realm)
+				: m_allocator(nullptr)
+				, m_realm(&realm)
+			{}
+
+			void* Alloc(size_t size, size_t alignment) const
+			{
+				return m_allocator ? m_allocator->Alloc(size, alignment, 0) : m_realm->Alloc(size, alignment);
+			}
+
+			void Dealloc(void* memory) const
+			{
+				if (m_allocator)
+				{
+					m_allocator->Dealloc(memory);
+				}
+				else
+				{
+					m_realm->Dealloc(memory);
+				}
+			}
+
+			bool operator==(const AllocatorReference& other) const
+			{
+				return m_allocator == other.m_allocator && m_realm == other.m_realm;
+			}
+
+			bool operator!=(const AllocatorReference& other) const
+			{
+				return !(*this == other);
+			}
+
+		private:
+			AllocatorBase* m_allocator;
+			MemoryRealmBase* m_realm;
+		};
+	}
+}
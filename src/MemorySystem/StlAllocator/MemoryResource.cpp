@@ -0,0 +1,36 @@
+#include "MemoryResource.h"
+
+#include <new>
+
+sp::memory::MemoryResource::MemoryResource(AllocatorBase& allocator)
+	: m_reference(allocator)
+{}
+
+sp::memory::MemoryResource::MemoryResource(MemoryRealmBase& realm)
+	: m_reference(realm)
+{}
+
+void* sp::memory::MemoryResource::do_allocate(size_t bytes, size_t alignment)
+{
+	void* memory = m_reference.Alloc(bytes, alignment);
+	if (!memory)
+	{
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void sp::memory::MemoryResource::do_deallocate(void* memory, size_t bytes, size_t alignment)
+{
+	m_reference.Dealloc(memory);
+}
+
+///
+/// Two resources are interchangeable if they forward to the same allocator
+///
+bool sp::memory::MemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	const MemoryResource* otherResource = dynamic_cast<const MemoryResource*>(&other);
+	return otherResource && otherResource->m_reference == m_reference;
+}
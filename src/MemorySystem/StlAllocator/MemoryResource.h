@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory_resource>
+
+#include "AllocatorReference.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Bridge from std::pmr to Spark's allocators. Containers of the std::pmr namespace
+		 * (or a std::pmr::polymorphic_allocator) constructed with this resource draw their
+		 * memory from the referenced AllocatorBase or MemoryRealmBase, e.g.
+		 *
+		 *     MemoryResource frameResource(frameAllocator);
+		 *     std::pmr::unordered_map<uint32_t, Entity> scratch(&frameResource);
+		 *
+		 * The referenced allocator has to outlive the resource and all its containers.
+		 */
+		class MemoryResource : public std::pmr::memory_resource
+		{
+		public:
+			explicit MemoryResource(AllocatorBase& allocator);
+			explicit MemoryResource(MemoryRealmBase& realm);
+
+			MemoryResource(const MemoryResource& other) = delete;
+			MemoryResource(const MemoryResource&& other) = delete;
+			MemoryResource operator=(const MemoryResource& other) = delete;
+			MemoryResource operator=(const MemoryResource&& other) = delete;
+
+			~MemoryResource() override = default;
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override;
+			void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+			AllocatorReference m_reference;
+		};
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "AllocatorReference.h"
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Adapter that satisfies the standard Allocator requirements and forwards to an
+		 * AllocatorBase or MemoryRealmBase owned by someone else, e.g.
+		 *
+		 *     std::vector<Entity, StlAllocator<Entity>> scratch(StlAllocator<Entity>(frameAllocator));
+		 *
+		 * Copies and rebound copies share the same allocator, which has to outlive the
+		 * container. Allocations use the alignment of T and no offset. Pools only fit
+		 * node-based containers whose nodes are no larger than the pool's element size.
+		 */
+		template <typename T>
+		class StlAllocator
+		{
+		public:
+			typedef T value_type;
+
+			explicit StlAllocator(AllocatorBase& allocator) noexcept
+				: m_reference(allocator)
+			{}
+
+			explicit StlAllocator(MemoryRealmBase& realm) noexcept
+				: m_reference(realm)
+			{}
+
+			template <typename U>
+			StlAllocator(const StlAllocator<U>& other) noexcept
+				: m_reference(other.GetReference())
+			{}
+
+			T* allocate(size_t count)
+			{
+				if (count > size_t(-1) / sizeof(T))
+				{
+					throw std::bad_array_new_length();
+				}
+
+				void* memory = m_reference.Alloc(count * sizeof(T), alignof(T));
+				if (!memory)
+				{
+					throw std::bad_alloc();
+				}
+
+				return static_cast<T*>(memory);
+			}
+
+			void deallocate(T* memory, size_t) noexcept
+			{
+				m_reference.Dealloc(memory);
+			}
+
+			const AllocatorReference& GetReference(void) const
+			{
+				return m_reference;
+			}
+
+		private:
+			AllocatorReference m_reference;
+		};
+
+		template <typename T, typename U>
+		bool operator==(const StlAllocator<T>& lhs, const StlAllocator<U>& rhs)
+		{
+			return lhs.GetReference() == rhs.GetReference();
+		}
+
+		template <typename T, typename U>
+		bool operator!=(const StlAllocator<T>& lhs, const StlAllocator<U>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <mutex>
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Thread policy that serializes all realm operations with a std::mutex.
+		 * Threads waiting for the realm are put to sleep by the OS.
+		 */
+		class MutexThreadPolicy
+		{
+		public:
+			static constexpr bool IS_PER_THREAD = false;
+
+			void lock(void)
+			{
+				m_mutex.lock();
+			}
+
+			void unlock(void)
+			{
+				m_mutex.unlock();
+			}
+
+		private:
+			std::mutex m_mutex;
+		};
+	}
+}
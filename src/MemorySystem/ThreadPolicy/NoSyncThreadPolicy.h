@@ -0,0 +1,20 @@
+#pragma once
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Thread policy for realms that are only used by a single thread at a time.
+		 * Locking compiles away completely.
+		 */
+		class NoSyncThreadPolicy
+		{
+		public:
+			static constexpr bool IS_PER_THREAD = false;
+
+			void lock(void) {}
+			void unlock(void) {}
+		};
+	}
+}
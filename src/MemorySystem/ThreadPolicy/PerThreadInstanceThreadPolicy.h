@@ -0,0 +1,24 @@
+#pragma once
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Thread policy that gives every thread its own instance of the realm's allocator
+		 * (see PerThreadAllocator). Threads allocate without contending with each other,
+		 * frees from other threads are handed back to the owning instance.
+		 *
+		 * The realm's bytes are the budget of every single thread. Memory trackers and
+		 * taggers are shared state and cannot be used with this policy.
+		 */
+		class PerThreadInstanceThreadPolicy
+		{
+		public:
+			static constexpr bool IS_PER_THREAD = true;
+
+			void lock(void) {}
+			void unlock(void) {}
+		};
+	}
+}
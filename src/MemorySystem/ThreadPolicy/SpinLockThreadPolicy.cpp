@@ -0,0 +1,54 @@
+#include "SpinLockThreadPolicy.h"
+
+#include <cstdint>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SP_CPU_PAUSE() _mm_pause()
+#else
+#define SP_CPU_PAUSE() std::this_thread::yield()
+#endif
+
+namespace
+{
+	// Pause instructions per spin are doubled up to this limit, afterwards the thread yields
+	static const uint32_t MAX_SPIN_BACKOFF = 64;
+}
+
+sp::memory::SpinLockThreadPolicy::SpinLockThreadPolicy()
+	: m_isLocked(false)
+{}
+
+///
+/// Test-and-test-and-set: waiting threads only read the flag, so the cache line
+/// is not bounced between them until the lock is actually released
+///
+void sp::memory::SpinLockThreadPolicy::LockContended(void)
+{
+	uint32_t backoff = 1;
+
+	for (;;)
+	{
+		while (m_isLocked.load(std::memory_order_relaxed))
+		{
+			if (backoff <= MAX_SPIN_BACKOFF)
+			{
+				for (uint32_t spin = 0; spin < backoff; ++spin)
+				{
+					SP_CPU_PAUSE();
+				}
+				backoff *= 2;
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		if (!m_isLocked.exchange(true, std::memory_order_acquire))
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+
+namespace sp
+{
+	namespace memory
+	{
+		/**
+		 * Thread policy that serializes all realm operations with a spinlock. Realm
+		 * operations are short, so spinning usually beats putting the thread to sleep.
+		 * Under contention the lock backs off exponentially (pause instructions) and
+		 * finally yields the time slice, so it degrades gracefully when oversubscribed.
+		 */
+		class SpinLockThreadPolicy
+		{
+		public:
+			static constexpr bool IS_PER_THREAD = false;
+
+			SpinLockThreadPolicy();
+
+			void lock(void)
+			{
+				if (!m_isLocked.exchange(true, std::memory_order_acquire))
+				{
+					return;
+				}
+
+				LockContended();
+			}
+
+			void unlock(void)
+			{
+				m_isLocked.store(false, std::memory_order_release);
+			}
+
+		private:
+			void LockContended(void);
+
+			std::atomic<bool> m_isLocked;
+		};
+	}
+}
@@ -1,6 +1,78 @@
 #include "VirtualMemory.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
 #include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	std::atomic<bool> g_useTransparentHugePages(false);
+	thread_local uint32_t t_scopedNumaNode = sp::memory::NUMA_NODE_ANY;
+
+	void AssertValidNumaNode(uint32_t node)
+	{
+		const bool isValidNode = node < sp::memory::GetNumaNodeCount();
+		assert(isValidNode && "NUMA node does not exist on this machine");
+	}
+
+	typedef std::pair<sp::memory::MemoryReleaseCallback, void*> MemoryReleaseListener;
+
+	// Most processes never register a listener, the count keeps them from taking the lock
+	std::atomic<size_t> g_memoryReleaseListenerCount(0u);
+
+	std::mutex& GetMemoryReleaseListenerMutex(void)
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	std::vector<MemoryReleaseListener>& GetMemoryReleaseListeners(void)
+	{
+		static std::vector<MemoryReleaseListener> listeners;
+		return listeners;
+	}
+
+	void NotifyMemoryRelease(const void* from, size_t size)
+	{
+		if (g_memoryReleaseListenerCount.load(std::memory_order_acquire) == 0u)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(GetMemoryReleaseListenerMutex());
+		for (const MemoryReleaseListener& listener : GetMemoryReleaseListeners())
+		{
+			listener.first(listener.second, from, size);
+		}
+	}
+
+	void* RegisterReservation(void* memory, size_t size, sp::memory::PageOwner owner)
+	{
+		const sp::memory::PageOwner resolvedOwner = sp::memory::ResolvePageOwner(owner);
+		if (memory && resolvedOwner.IsValid())
+		{
+			sp::memory::RegisterPages(memory, size, resolvedOwner);
+		}
+
+		return memory;
+	}
+}
+
+#if defined(_WIN32)
 
 namespace sp
 {
@@ -13,13 +85,21 @@ namespace sp
 			return sysInfo.dwPageSize;
 		}
 
-		void* ReserveAddressSpace(size_t size)
+		void* ReserveAddressSpace(size_t size, PageOwner owner)
 		{
-			return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+			// The preferred node is stored with the reservation and applies to all later commits
+			const uint32_t node = ScopedNumaNode::GetNode();
+			void* memory = node == NUMA_NODE_ANY
+				? VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS)
+				: VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, MEM_RESERVE, PAGE_NOACCESS, node);
+			return RegisterReservation(memory, size, owner);
 		}
 
-		void FreeAddressSpace(void* from)
+		void FreeAddressSpace(void* from, size_t size)
 		{
+			NotifyMemoryRelease(from, size);
+			UnregisterPages(from, size);
+			// MEM_RELEASE always frees the whole reservation and requires a size of 0
 			VirtualFree(from, 0u, MEM_RELEASE);
 		}
 
@@ -30,7 +110,327 @@ namespace sp
 
 		void DecommitPhysicalMemory(void* from, size_t size)
 		{
+			NotifyMemoryRelease(from, size);
 			VirtualFree(from, size, MEM_DECOMMIT);
 		}
+
+		uint32_t GetNumaNodeCount(void)
+		{
+			static const uint32_t nodeCount = []()
+			{
+				ULONG highestNode = 0u;
+				return GetNumaHighestNodeNumber(&highestNode) ? std::min<uint32_t>(highestNode + 1u, NUMA_MAX_NODE_COUNT) : 1u;
+			}();
+			return nodeCount;
+		}
+
+		uint32_t GetCurrentNumaNode(void)
+		{
+			PROCESSOR_NUMBER processor;
+			GetCurrentProcessorNumberEx(&processor);
+
+			USHORT node = 0u;
+			return GetNumaProcessorNodeEx(&processor, &node) ? node % GetNumaNodeCount() : 0u;
+		}
+
+		uint32_t GetNumaNodeOfPage(const void* memory)
+		{
+			PSAPI_WORKING_SET_EX_INFORMATION workingSetInfo = {};
+			workingSetInfo.VirtualAddress = const_cast<void*>(memory);
+
+			if (!QueryWorkingSetEx(GetCurrentProcess(), &workingSetInfo, sizeof(workingSetInfo)) || !workingSetInfo.VirtualAttributes.Valid)
+			{
+				return NUMA_NODE_ANY;
+			}
+
+			return static_cast<uint32_t>(workingSetInfo.VirtualAttributes.Node);
+		}
+
+		void* CommitPhysicalMemoryOnNode(void* from, size_t size, uint32_t node)
+		{
+			AssertValidNumaNode(node);
+			return VirtualAllocExNuma(GetCurrentProcess(), from, size, MEM_COMMIT, PAGE_READWRITE, node);
+		}
+
+		bool BindToNumaNode(void* from, size_t size, uint32_t node)
+		{
+			// The node of a range can only be picked when reserving or committing it
+			AssertValidNumaNode(node);
+			return false;
+		}
+	}
+}
+
+#else
+
+namespace
+{
+	///
+	/// VirtualAlloc/VirtualFree silently widen a range to the pages it touches,
+	/// mprotect/madvise insist on a page-aligned start instead. To keep the same
+	/// semantics on both platforms the range is widened here before every call.
+	///
+	void PageAlignRange(void* from, size_t size, char*& alignedBegin, size_t& alignedSize)
+	{
+		const size_t pageSize = sp::memory::GetPageSize();
+		char* begin = sp::pointerUtil::pseudo_cast<char*>(sp::pointerUtil::AlignBottom(from, pageSize), 0);
+		char* end = sp::pointerUtil::AlignTop(sp::pointerUtil::pseudo_cast<char*>(from, 0) + size, pageSize);
+
+		alignedBegin = begin;
+		alignedSize = static_cast<size_t>(end - begin);
+	}
+
+	///
+	/// Reserves size + HUGE_PAGE_SIZE bytes and cuts away the unaligned head and
+	/// tail, leaving a reservation that starts on a huge page boundary. Only such
+	/// ranges can be backed by transparent huge pages.
+	///
+	void* ReserveHugePageAlignedAddressSpace(size_t size)
+	{
+		const size_t paddedSize = size + sp::memory::HUGE_PAGE_SIZE;
+		void* padded = mmap(nullptr, paddedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (padded == MAP_FAILED)
+		{
+			return nullptr;
+		}
+
+		char* paddedBegin = static_cast<char*>(padded);
+		char* paddedEnd = paddedBegin + paddedSize;
+		char* alignedBegin = sp::pointerUtil::AlignTop(paddedBegin, sp::memory::HUGE_PAGE_SIZE);
+		char* alignedEnd = sp::pointerUtil::AlignTop(alignedBegin + size, sp::memory::GetPageSize());
+
+		if (alignedBegin != paddedBegin)
+		{
+			munmap(paddedBegin, alignedBegin - paddedBegin);
+		}
+		if (alignedEnd != paddedEnd)
+		{
+			munmap(alignedEnd, paddedEnd - alignedEnd);
+		}
+
+#if defined(MADV_HUGEPAGE)
+		madvise(alignedBegin, alignedEnd - alignedBegin, MADV_HUGEPAGE);
+#endif
+		return alignedBegin;
+	}
+
+	// Taken from linux/mempolicy.h, the raw syscalls avoid a dependency on libnuma
+	const int LINUX_MPOL_PREFERRED = 1;
+	const unsigned long LINUX_MPOL_F_NODE = 1u << 0;
+	const unsigned long LINUX_MPOL_F_ADDR = 1u << 1;
+	const unsigned long LINUX_MPOL_F_MEMS_ALLOWED = 1u << 2;
+
+	// get_mempolicy() rejects masks with fewer bits than the kernel has nodes, this covers all configurations
+	const size_t LINUX_MAX_NUMA_NODES = 1024;
+	const size_t BITS_PER_MASK_WORD = 8 * sizeof(unsigned long);
+
+	///
+	/// Highest node the process may allocate memory on plus one. Nodes above
+	/// NUMA_MAX_NODE_COUNT are ignored, a failing call leaves a single node.
+	///
+	uint32_t QueryNumaNodeCount(void)
+	{
+		unsigned long allowedNodes[LINUX_MAX_NUMA_NODES / BITS_PER_MASK_WORD] = {};
+		if (syscall(SYS_get_mempolicy, nullptr, allowedNodes, LINUX_MAX_NUMA_NODES, nullptr, LINUX_MPOL_F_MEMS_ALLOWED) != 0)
+		{
+			return 1u;
+		}
+
+		uint32_t nodeCount = 1u;
+		for (uint32_t node = 0u; node < sp::memory::NUMA_MAX_NODE_COUNT; ++node)
+		{
+			if ((allowedNodes[node / BITS_PER_MASK_WORD] >> (node % BITS_PER_MASK_WORD)) & 1u)
+			{
+				nodeCount = node + 1u;
+			}
+		}
+
+		return nodeCount;
 	}
 }
+
+namespace sp
+{
+	namespace memory
+	{
+		size_t GetPageSize(void)
+		{
+			static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			return pageSize;
+		}
+
+		void* ReserveAddressSpace(size_t size, PageOwner owner)
+		{
+			void* memory = nullptr;
+			if (size >= HUGE_PAGE_SIZE && UsesTransparentHugePages())
+			{
+				memory = ReserveHugePageAlignedAddressSpace(size);
+			}
+			else
+			{
+				memory = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				memory = memory == MAP_FAILED ? nullptr : memory;
+			}
+
+			// A failed binding is no error, the pages then land wherever first touch puts them
+			const uint32_t node = ScopedNumaNode::GetNode();
+			if (memory && node != NUMA_NODE_ANY)
+			{
+				BindToNumaNode(memory, size, node);
+			}
+
+			return RegisterReservation(memory, size, owner);
+		}
+
+		void FreeAddressSpace(void* from, size_t size)
+		{
+			NotifyMemoryRelease(from, size);
+			UnregisterPages(from, size);
+			munmap(from, size);
+		}
+
+		void* CommitPhysicalMemory(void* from, size_t size)
+		{
+			char* alignedBegin = nullptr;
+			size_t alignedSize = 0u;
+			PageAlignRange(from, size, alignedBegin, alignedSize);
+
+			if (mprotect(alignedBegin, alignedSize, PROT_READ | PROT_WRITE) != 0)
+			{
+				return nullptr;
+			}
+
+			return alignedBegin;
+		}
+
+		void DecommitPhysicalMemory(void* from, size_t size)
+		{
+			char* alignedBegin = nullptr;
+			size_t alignedSize = 0u;
+			PageAlignRange(from, size, alignedBegin, alignedSize);
+			NotifyMemoryRelease(alignedBegin, alignedSize);
+
+			// Hand the physical pages back first, afterwards any access to the range faults again
+			madvise(alignedBegin, alignedSize, MADV_DONTNEED);
+			mprotect(alignedBegin, alignedSize, PROT_NONE);
+		}
+
+		uint32_t GetNumaNodeCount(void)
+		{
+			static const uint32_t nodeCount = QueryNumaNodeCount();
+			return nodeCount;
+		}
+
+		uint32_t GetCurrentNumaNode(void)
+		{
+			unsigned int cpu = 0u;
+			unsigned int node = 0u;
+			if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+			{
+				return 0u;
+			}
+
+			return node % GetNumaNodeCount();
+		}
+
+		uint32_t GetNumaNodeOfPage(const void* memory)
+		{
+			int node = -1;
+			if (syscall(SYS_get_mempolicy, &node, nullptr, 0ul, memory, LINUX_MPOL_F_NODE | LINUX_MPOL_F_ADDR) != 0 || node < 0)
+			{
+				return NUMA_NODE_ANY;
+			}
+
+			return static_cast<uint32_t>(node);
+		}
+
+		void* CommitPhysicalMemoryOnNode(void* from, size_t size, uint32_t node)
+		{
+			BindToNumaNode(from, size, node);
+			return CommitPhysicalMemory(from, size);
+		}
+
+		///
+		/// The policy sticks to the mapping, so it survives committing and decommitting
+		/// the pages with mprotect/madvise. MPOL_PREFERRED instead of MPOL_BIND falls back
+		/// to other nodes instead of failing once the node runs out of memory.
+		///
+		bool BindToNumaNode(void* from, size_t size, uint32_t node)
+		{
+			AssertValidNumaNode(node);
+
+			char* alignedBegin = nullptr;
+			size_t alignedSize = 0u;
+			PageAlignRange(from, size, alignedBegin, alignedSize);
+
+			unsigned long nodeMask[NUMA_MAX_NODE_COUNT / BITS_PER_MASK_WORD] = {};
+			nodeMask[node / BITS_PER_MASK_WORD] = 1ul << (node % BITS_PER_MASK_WORD);
+
+			// The kernel expects the mask size plus one
+			return syscall(SYS_mbind, alignedBegin, alignedSize, LINUX_MPOL_PREFERRED, nodeMask, NUMA_MAX_NODE_COUNT + 1ul, 0u) == 0;
+		}
+	}
+}
+
+#endif
+
+void sp::memory::AddMemoryReleaseListener(MemoryReleaseCallback callback, void* context)
+{
+	std::lock_guard<std::mutex> lock(GetMemoryReleaseListenerMutex());
+	GetMemoryReleaseListeners().emplace_back(callback, context);
+	g_memoryReleaseListenerCount.fetch_add(1u, std::memory_order_release);
+}
+
+void sp::memory::RemoveMemoryReleaseListener(MemoryReleaseCallback callback, void* context)
+{
+	std::lock_guard<std::mutex> lock(GetMemoryReleaseListenerMutex());
+	std::vector<MemoryReleaseListener>& listeners = GetMemoryReleaseListeners();
+
+	const auto listener = std::find(listeners.begin(), listeners.end(), MemoryReleaseListener(callback, context));
+	if (listener != listeners.end())
+	{
+		listeners.erase(listener);
+		g_memoryReleaseListenerCount.fetch_sub(1u, std::memory_order_release);
+	}
+}
+
+void sp::memory::SetTransparentHugePages(bool enabled)
+{
+	g_useTransparentHugePages.store(enabled, std::memory_order_relaxed);
+}
+
+bool sp::memory::UsesTransparentHugePages(void)
+{
+#if defined(_WIN32)
+	return false;
+#else
+	return g_useTransparentHugePages.load(std::memory_order_relaxed);
+#endif
+}
+
+void* sp::memory::ReserveAddressSpaceOnNode(size_t size, uint32_t node, PageOwner owner)
+{
+	ScopedNumaNode numaScope(node);
+	return ReserveAddressSpace(size, owner);
+}
+
+sp::memory::ScopedNumaNode::ScopedNumaNode(uint32_t node)
+	: m_previousNode(t_scopedNumaNode)
+{
+	if (node != NUMA_NODE_ANY)
+	{
+		AssertValidNumaNode(node);
+	}
+
+	t_scopedNumaNode = node;
+}
+
+sp::memory::ScopedNumaNode::~ScopedNumaNode()
+{
+	t_scopedNumaNode = m_previousNode;
+}
+
+uint32_t sp::memory::ScopedNumaNode::GetNode(void)
+{
+	return t_scopedNumaNode;
+}
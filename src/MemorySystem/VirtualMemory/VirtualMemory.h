@@ -1,15 +1,106 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include "../PageMap/PageMap.h"
+
 namespace sp
 {
 	namespace memory
 	{
+		/**
+		 * Size of a transparent huge page on x86-64 Linux. Reservations of at
+		 * least this size are aligned to it when huge pages are enabled, so the
+		 * kernel is able to back them with 2 MiB pages instead of 4 KiB ones.
+		 */
+		static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
 		size_t GetPageSize(void);
 
-		void* ReserveAddressSpace(size_t size);
-		void FreeAddressSpace(void* from);
+		/**
+		 * Reservations are registered in the page map for the outermost ScopedPageOwner
+		 * of the calling thread, otherwise for the given owner. Without either the range
+		 * is not registered. Freeing the address space unregisters it again.
+		 */
+		void* ReserveAddressSpace(size_t size, PageOwner owner = PageOwner());
+		void FreeAddressSpace(void* from, size_t size);
 
 		void* CommitPhysicalMemory(void* from, size_t size);
 		void DecommitPhysicalMemory(void* from, size_t size);
+
+		/**
+		 * Listeners are called with every range that is decommitted or whose address space
+		 * is freed, before its pages are handed back, e.g. so debug tooling can forget what
+		 * it knew about their content. Listeners may be called from any thread, removing one
+		 * waits for calls to it that are still running.
+		 */
+		typedef void (*MemoryReleaseCallback)(void* context, const void* from, size_t size);
+
+		void AddMemoryReleaseListener(MemoryReleaseCallback callback, void* context);
+		void RemoveMemoryReleaseListener(MemoryReleaseCallback callback, void* context);
+
+		/**
+		 * Opt-in for transparent huge pages (MADV_HUGEPAGE) on reservations of
+		 * at least HUGE_PAGE_SIZE bytes. Only reservations made after enabling
+		 * it are affected. On platforms without THP support this is a no-op.
+		 */
+		void SetTransparentHugePages(bool enabled);
+		bool UsesTransparentHugePages(void);
+
+		/**
+		 * NUMA nodes are numbered from 0 to GetNumaNodeCount() - 1. Without NUMA support
+		 * in the OS, or if the calls are blocked (e.g. by a container's seccomp profile),
+		 * there is a single node 0 and binding memory to it does nothing. The pages then
+		 * land on the node of the first thread touching them, as without binding.
+		 */
+		static const uint32_t NUMA_MAX_NODE_COUNT = 64;
+		static const uint32_t NUMA_NODE_ANY = 0xFFFFFFFFu;
+
+		uint32_t GetNumaNodeCount(void);
+		/// Node of the CPU the calling thread currently runs on
+		uint32_t GetCurrentNumaNode(void);
+		/// Node backing the page containing memory, NUMA_NODE_ANY if it is not committed or unknown
+		uint32_t GetNumaNodeOfPage(const void* memory);
+
+		/**
+		 * Reserves address space whose pages prefer the given node once they are committed,
+		 * other nodes are only used if it runs out of memory. Committing on a node does the
+		 * same for a range that was reserved without one.
+		 */
+		void* ReserveAddressSpaceOnNode(size_t size, uint32_t node, PageOwner owner = PageOwner());
+		void* CommitPhysicalMemoryOnNode(void* from, size_t size, uint32_t node);
+
+		/**
+		 * Lets all pages committed later on in the reserved range prefer the given node.
+		 * Returns false if the range could not be bound, e.g. without NUMA support or
+		 * on Windows, where the node is picked at reservation or commit time instead.
+		 */
+		bool BindToNumaNode(void* from, size_t size, uint32_t node);
+
+		/**
+		 * Binds all address space the calling thread reserves with ReserveAddressSpace() for
+		 * the lifetime of this object to the given node, so allocators constructed in the
+		 * scope get node-local memory without knowing about NUMA. The innermost scope wins,
+		 * NUMA_NODE_ANY lifts the binding again.
+		 */
+		class ScopedNumaNode
+		{
+		public:
+			explicit ScopedNumaNode(uint32_t node);
+
+			ScopedNumaNode(const ScopedNumaNode& other) = delete;
+			ScopedNumaNode(const ScopedNumaNode&& other) = delete;
+			ScopedNumaNode operator=(const ScopedNumaNode& other) = delete;
+			ScopedNumaNode operator=(const ScopedNumaNode&& other) = delete;
+
+			~ScopedNumaNode();
+
+			/// Node of the innermost scope of the calling thread, NUMA_NODE_ANY outside of any
+			static uint32_t GetNode(void);
+
+		private:
+			uint32_t m_previousNode;
+		};
 	}
-}
\ No newline at end of file
+}
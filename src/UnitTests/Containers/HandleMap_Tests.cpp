@@ -113,4 +113,18 @@ TEST(HandleMap, Item_Iteration)
 		ASSERT_EQ(texture[idx].width, 100) << "Texture width was corrupted";
 		ASSERT_EQ(texture[idx].height, 200) << "Texture height was corrupted";
 	}
-}
\ No newline at end of file
+}
+
+TEST(HandleMap, Insert_And_Erase_With_Concurrent_FreeList)
+{
+	sp::container::HandleMap<TextureResource, sp::core::ConcurrentFreeList> handleMap(10);
+	const TextureResource diffuse{ 100, 200,{ 3 } };
+
+	const sp::container::Handle first = handleMap.Insert(diffuse);
+	handleMap.Erase(first);
+	const sp::container::Handle second = handleMap.Insert(diffuse);
+
+	ASSERT_FALSE(handleMap.IsValid(first)) << "Erased handle should be invalid";
+	ASSERT_TRUE(handleMap.IsValid(second)) << "Handle of re-used slot should be valid";
+	ASSERT_EQ(handleMap.At(second).width, 100) << "Texture width was corrupted";
+}
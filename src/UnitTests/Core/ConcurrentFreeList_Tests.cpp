@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "FreeList/ConcurrentFreeList.h"
+
+const size_t CHUNK_SIZE = 32;
+const size_t CHUNK_COUNT = 1024;
+
+TEST(ConcurrentFreeList, Default_Constructed_List_Is_Empty)
+{
+	sp::core::ConcurrentFreeList freeList;
+	ASSERT_TRUE(freeList.IsEmpty()) << "Default constructed list should not contain any chunks";
+	ASSERT_EQ(freeList.GetChunk(), nullptr) << "Empty list should return a nullptr";
+}
+
+TEST(ConcurrentFreeList, Hands_Out_Chunks_In_Memory_Order)
+{
+	std::vector<char> memory(CHUNK_SIZE * CHUNK_COUNT);
+	sp::core::ConcurrentFreeList freeList(memory.data(), memory.data() + memory.size(), CHUNK_SIZE);
+
+	for (size_t idx = 0; idx < CHUNK_COUNT; ++idx)
+	{
+		ASSERT_EQ(freeList.GetChunk(), memory.data() + idx * CHUNK_SIZE) << "Chunks should be handed out front to back";
+	}
+
+	ASSERT_TRUE(freeList.IsEmpty()) << "All chunks were handed out";
+	ASSERT_EQ(freeList.GetChunk(), nullptr) << "Exhausted list should return a nullptr";
+}
+
+TEST(ConcurrentFreeList, Returned_Chunk_Is_Handed_Out_Next)
+{
+	std::vector<char> memory(CHUNK_SIZE * CHUNK_COUNT);
+	sp::core::ConcurrentFreeList freeList(memory.data(), memory.data() + memory.size(), CHUNK_SIZE);
+
+	void* first = freeList.GetChunk();
+	void* second = freeList.GetChunk();
+	freeList.ReturnChunk(first);
+
+	ASSERT_EQ(freeList.GetChunk(), first) << "Returned chunk should be on top of the list";
+	ASSERT_NE(freeList.GetChunk(), second) << "Chunk still in use was handed out twice";
+}
+
+TEST(ConcurrentFreeList, Concurrent_Get_And_Return_Keeps_Chunks_Unique)
+{
+	const size_t threadCount = 8;
+	const size_t iterations = 20000;
+
+	std::vector<char> memory(CHUNK_SIZE * CHUNK_COUNT);
+	sp::core::ConcurrentFreeList freeList(memory.data(), memory.data() + memory.size(), CHUNK_SIZE);
+
+	std::vector<std::thread> threads;
+	std::vector<size_t> corruptions(threadCount, 0);
+
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&freeList, &corruptions, t, iterations]()
+		{
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				size_t* chunk = static_cast<size_t*>(freeList.GetChunk());
+				if (!chunk)
+				{
+					continue;
+				}
+
+				// If another thread got the same chunk, one of the writes shows up here
+				chunk[1] = t;
+				chunk[2] = i;
+				if (chunk[1] != t || chunk[2] != i)
+				{
+					++corruptions[t];
+				}
+
+				freeList.ReturnChunk(chunk);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (size_t corruption : corruptions)
+	{
+		ASSERT_EQ(corruption, 0u) << "A chunk was used by two threads at once";
+	}
+
+	std::set<void*> chunks;
+	while (!freeList.IsEmpty())
+	{
+		chunks.insert(freeList.GetChunk());
+	}
+
+	ASSERT_EQ(chunks.size(), CHUNK_COUNT) << "Chunks were lost or duplicated under contention";
+}
@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "FreeList/RemoteFreeList.h"
+
+const size_t CHUNK_SIZE = 32;
+const size_t CHUNK_COUNT = 1024;
+
+TEST(RemoteFreeList, Default_Constructed_List_Is_Empty)
+{
+	sp::core::RemoteFreeList freeList;
+	ASSERT_TRUE(freeList.IsEmpty()) << "Default constructed list should not contain any chunks";
+	ASSERT_EQ(freeList.GetChunk(), nullptr) << "Empty list should return a nullptr";
+}
+
+TEST(RemoteFreeList, Hands_Out_Chunks_In_Memory_Order)
+{
+	std::vector<char> memory(CHUNK_SIZE * CHUNK_COUNT);
+	sp::core::RemoteFreeList freeList(memory.data(), memory.data() + memory.size(), CHUNK_SIZE);
+
+	for (size_t idx = 0; idx < CHUNK_COUNT; ++idx)
+	{
+		ASSERT_EQ(freeList.GetChunk(), memory.data() + idx * CHUNK_SIZE) << "Chunks should be handed out front to back";
+	}
+
+	ASSERT_TRUE(freeList.IsEmpty()) << "All chunks were handed out";
+	ASSERT_EQ(freeList.GetChunk(), nullptr) << "Exhausted list should return a nullptr";
+}
+
+TEST(RemoteFreeList, Remote_Chunks_Are_Used_Once_Local_Ones_Run_Out)
+{
+	std::vector<char> memory(CHUNK_SIZE * 4);
+	sp::core::RemoteFreeList freeList(memory.data(), memory.data() + memory.size(), CHUNK_SIZE);
+
+	void* first = freeList.GetChunk();
+	void* second = freeList.GetChunk();
+	std::thread([&]() { freeList.ReturnChunk(first); }).join();
+
+	ASSERT_FALSE(freeList.IsEmpty()) << "Remotely returned chunk is not visible";
+	ASSERT_EQ(freeList.GetChunk(), memory.data() + 2 * CHUNK_SIZE) << "Local chunks should be handed out first";
+	ASSERT_EQ(freeList.GetChunk(), memory.data() + 3 * CHUNK_SIZE) << "Local chunks should be handed out first";
+	ASSERT_EQ(freeList.GetChunk(), first) << "Remotely returned chunk was not taken over";
+
+	freeList.ReturnChunk(second);
+	ASSERT_EQ(freeList.GetChunk(), second) << "Chunk returned by the owner should be handed out next";
+	ASSERT_EQ(freeList.GetChunk(), nullptr) << "Exhausted list should return a nullptr";
+}
+
+TEST(RemoteFreeList, Concurrent_Remote_Returns_Are_Not_Lost)
+{
+	const size_t threadCount = 4;
+	std::vector<char> memory(CHUNK_SIZE * CHUNK_COUNT);
+	sp::core::RemoteFreeList freeList(memory.data(), memory.data() + memory.size(), CHUNK_SIZE);
+
+	std::vector<void*> chunks(CHUNK_COUNT);
+	ASSERT_EQ(freeList.GetChunks(chunks.data(), CHUNK_COUNT), CHUNK_COUNT) << "Not all chunks were handed out";
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&freeList, &chunks, t, threadCount]()
+		{
+			const size_t perThread = CHUNK_COUNT / threadCount;
+			const size_t begin = t * perThread;
+
+			// Half one by one, half as a batch
+			for (size_t idx = begin; idx < begin + perThread / 2; ++idx)
+			{
+				freeList.ReturnChunk(chunks[idx]);
+			}
+			freeList.ReturnChunks(chunks.data() + begin + perThread / 2, perThread - perThread / 2);
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::set<void*> returned;
+	std::vector<void*> batch(CHUNK_COUNT);
+	ASSERT_EQ(freeList.GetChunks(batch.data(), CHUNK_COUNT), CHUNK_COUNT) << "Remotely returned chunks were lost";
+	returned.insert(batch.begin(), batch.end());
+
+	ASSERT_EQ(returned.size(), CHUNK_COUNT) << "A chunk was handed out twice";
+	ASSERT_TRUE(freeList.IsEmpty()) << "All chunks were handed out";
+}
+
+TEST(RemoteFreeList, Ownership_Can_Be_Handed_Over)
+{
+	std::vector<char> memory(CHUNK_SIZE * CHUNK_COUNT);
+	sp::core::RemoteFreeList freeList(memory.data(), memory.data() + memory.size(), CHUNK_SIZE);
+
+	void* chunk = nullptr;
+	std::thread([&]()
+	{
+		freeList.SetOwnerThread();
+		chunk = freeList.GetChunk();
+		freeList.ReturnChunk(chunk);
+	}).join();
+
+	ASSERT_FALSE(freeList.IsOwnerThread()) << "Ownership was not handed over";
+	ASSERT_DEATH(freeList.GetChunk(), ".*");
+}
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Allocator/NonGrowing/BuddyAllocator.h"
+#include "BoundsChecker/SimpleBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	const size_t ONE_KIBIBYTE = 1024;
+	const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
+
+	typedef sp::memory::MemoryRealm<sp::memory::BuddyAllocator, sp::memory::SimpleBoundsChecker> BuddyRealm;
+}
+
+TEST(BuddyAllocator, Rounds_Region_Up_To_Power_Of_Two)
+{
+	sp::memory::BuddyAllocator buddyAllocator(ONE_MIBIBYTE * 3);
+	const sp::memory::BuddyAllocatorStatistics statistics = buddyAllocator.GetStatistics();
+
+	ASSERT_EQ(statistics.totalBytes, ONE_MIBIBYTE * 4);
+	ASSERT_EQ(statistics.freeBytes, ONE_MIBIBYTE * 4);
+	ASSERT_EQ(statistics.largestFreeBlock, ONE_MIBIBYTE * 4);
+	ASSERT_EQ(statistics.GetExternalFragmentation(), 0.0);
+}
+
+TEST(BuddyAllocator, Allocate_Aligned_Objects)
+{
+	sp::memory::BuddyAllocator buddyAllocator(ONE_MIBIBYTE);
+
+	const size_t alignments[] = { 1, 4, 16, 64, 256, 4096 };
+	for (size_t alignment : alignments)
+	{
+		void* raw_mem = buddyAllocator.Alloc(100, alignment, 0);
+		ASSERT_NE(raw_mem, nullptr) << "BuddyAllocator did not return a valid pointer";
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, alignment)) << "Allocation is not aligned to " << alignment;
+		ASSERT_EQ(buddyAllocator.GetAllocationSize(raw_mem), 100u);
+	}
+}
+
+TEST(BuddyAllocator, Allocate_Aligned_Objects_With_Offset)
+{
+	sp::memory::BuddyAllocator buddyAllocator(ONE_MIBIBYTE);
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		char* raw_mem = static_cast<char*>(buddyAllocator.Alloc(24, 16, 4));
+		ASSERT_NE(raw_mem, nullptr);
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem + 4, 16));
+		std::memset(raw_mem, 0xAB, 24 + 4);
+	}
+}
+
+TEST(BuddyAllocator, Splits_And_Coalesces_Blocks)
+{
+	sp::memory::BuddyAllocator buddyAllocator(ONE_MIBIBYTE);
+
+	void* first = buddyAllocator.Alloc(ONE_KIBIBYTE, 1, 0);
+	void* second = buddyAllocator.Alloc(ONE_KIBIBYTE, 1, 0);
+
+	sp::memory::BuddyAllocatorStatistics statistics = buddyAllocator.GetStatistics();
+	ASSERT_EQ(statistics.allocatedBlockBytes, ONE_KIBIBYTE * 4) << "1 KiB plus header has to be rounded up to 2 KiB blocks";
+	ASSERT_EQ(statistics.largestFreeBlock, ONE_MIBIBYTE / 2);
+	ASSERT_GT(statistics.GetInternalFragmentation(), 0.0);
+
+	buddyAllocator.Dealloc(first);
+	buddyAllocator.Dealloc(second);
+
+	statistics = buddyAllocator.GetStatistics();
+	ASSERT_EQ(statistics.freeBytes, ONE_MIBIBYTE);
+	ASSERT_EQ(statistics.largestFreeBlock, ONE_MIBIBYTE) << "Buddies were not merged back into a single block";
+	ASSERT_EQ(statistics.freeBlockCounts[statistics.orderCount - 1], 1u);
+}
+
+TEST(BuddyAllocator, Frees_In_Any_Order)
+{
+	sp::memory::BuddyAllocator buddyAllocator(ONE_MIBIBYTE * 16);
+	std::mt19937 random(42);
+	std::uniform_int_distribution<size_t> sizeDistribution(1, 64 * ONE_KIBIBYTE);
+
+	std::vector<void*> allocations;
+	for (size_t round = 0; round < 10; ++round)
+	{
+		for (size_t i = 0; i < 50; ++i)
+		{
+			const size_t size = sizeDistribution(random);
+			void* raw_mem = buddyAllocator.Alloc(size, 16, 0);
+			ASSERT_NE(raw_mem, nullptr);
+			std::memset(raw_mem, static_cast<int>(i), size);
+			allocations.push_back(raw_mem);
+		}
+
+		std::shuffle(allocations.begin(), allocations.end(), random);
+		for (size_t i = 0; i < 25; ++i)
+		{
+			buddyAllocator.Dealloc(allocations.back());
+			allocations.pop_back();
+		}
+	}
+
+	ASSERT_GT(buddyAllocator.GetStatistics().GetExternalFragmentation(), 0.0);
+
+	for (void* allocation : allocations)
+	{
+		buddyAllocator.Dealloc(allocation);
+	}
+
+	const sp::memory::BuddyAllocatorStatistics statistics = buddyAllocator.GetStatistics();
+	ASSERT_EQ(statistics.largestFreeBlock, ONE_MIBIBYTE * 16);
+	ASSERT_EQ(statistics.allocatedBlockBytes, 0u);
+	ASSERT_EQ(statistics.requestedBytes, 0u);
+}
+
+TEST(BuddyAllocator, Returns_Nullptr_When_Exhausted)
+{
+	sp::memory::BuddyAllocator buddyAllocator(ONE_MIBIBYTE);
+
+	ASSERT_NE(buddyAllocator.Alloc(ONE_KIBIBYTE * 400, 1, 0), nullptr);
+	ASSERT_NE(buddyAllocator.Alloc(ONE_KIBIBYTE * 400, 1, 0), nullptr);
+	ASSERT_EQ(buddyAllocator.Alloc(ONE_KIBIBYTE * 400, 1, 0), nullptr);
+	ASSERT_EQ(buddyAllocator.Alloc(ONE_MIBIBYTE * 2, 1, 0), nullptr);
+}
+
+TEST(BuddyAllocator, Double_Free_Asserts)
+{
+	sp::memory::BuddyAllocator buddyAllocator(ONE_MIBIBYTE);
+	void* first = buddyAllocator.Alloc(ONE_KIBIBYTE, 1, 0);
+	buddyAllocator.Alloc(ONE_KIBIBYTE, 1, 0);
+	buddyAllocator.Dealloc(first);
+
+	ASSERT_DEATH(buddyAllocator.Dealloc(first), "Block was already freed");
+}
+
+TEST(BuddyAllocator, User_Provided_Memory)
+{
+	std::vector<char> memory(ONE_MIBIBYTE);
+	sp::memory::BuddyAllocator buddyAllocator(memory.data(), memory.data() + memory.size());
+
+	const sp::memory::BuddyAllocatorStatistics statistics = buddyAllocator.GetStatistics();
+	ASSERT_EQ(statistics.totalBytes, ONE_MIBIBYTE / 2) << "The block states need room, so only the next smaller power-of-two fits";
+
+	char* raw_mem = static_cast<char*>(buddyAllocator.Alloc(ONE_KIBIBYTE * 256, 1, 0));
+	ASSERT_GE(raw_mem, memory.data());
+	ASSERT_LE(raw_mem + ONE_KIBIBYTE * 256, memory.data() + memory.size());
+}
+
+TEST(BuddyAllocator, Plugs_Into_Memory_Realm)
+{
+	BuddyRealm memRealm(ONE_MIBIBYTE);
+
+	void* first = memRealm.Alloc(100, 16);
+	void* second = memRealm.Alloc(200, 16);
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(first, 16));
+
+	memRealm.Dealloc(first);
+	memRealm.Dealloc(second);
+
+	char* stomped = static_cast<char*>(memRealm.Alloc(100, 16));
+	stomped[100] = 0;
+	ASSERT_DEATH(memRealm.Dealloc(stomped), "Back Canary was not valid");
+}
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+#include "Allocator/NonGrowing/FrameAllocator.h"
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	const size_t ONE_KIBIBYTE = 1024;
+	const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
+}
+
+TEST(FrameAllocator, Allocate_Aligned_Objects)
+{
+	sp::memory::FrameAllocator frameAllocator(ONE_MIBIBYTE);
+
+	void* raw_mem = frameAllocator.Alloc(100, 16, 0);
+	ASSERT_NE(raw_mem, nullptr) << "FrameAllocator did not return a valid pointer";
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 16));
+	ASSERT_EQ(frameAllocator.GetAllocationSize(raw_mem), 100u);
+}
+
+TEST(FrameAllocator, Allocations_Survive_The_Next_Frame)
+{
+	sp::memory::FrameAllocator frameAllocator(ONE_MIBIBYTE);
+
+	char* previousFrame = static_cast<char*>(frameAllocator.Alloc(ONE_KIBIBYTE, 1, 0));
+	std::memset(previousFrame, 0xAB, ONE_KIBIBYTE);
+
+	frameAllocator.BeginFrame();
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		char* raw_mem = static_cast<char*>(frameAllocator.Alloc(ONE_KIBIBYTE, 1, 0));
+		ASSERT_TRUE(raw_mem + ONE_KIBIBYTE <= previousFrame || raw_mem >= previousFrame + ONE_KIBIBYTE) << "Allocation overlaps the previous frame";
+		std::memset(raw_mem, 0xCD, ONE_KIBIBYTE);
+	}
+
+	for (size_t i = 0; i < ONE_KIBIBYTE; ++i)
+	{
+		ASSERT_EQ(static_cast<uint8_t>(previousFrame[i]), 0xAB) << "Data of the previous frame was overwritten";
+	}
+}
+
+TEST(FrameAllocator, Buffers_Are_Reused_After_Frame_Count_Frames)
+{
+	sp::memory::TripleBufferedFrameAllocator frameAllocator(ONE_MIBIBYTE);
+
+	std::vector<void*> firstAllocations;
+	for (size_t frame = 0; frame < 3; ++frame)
+	{
+		ASSERT_EQ(frameAllocator.GetCurrentBufferIndex(), frame);
+		firstAllocations.push_back(frameAllocator.Alloc(64, 8, 0));
+		frameAllocator.Alloc(64, 8, 0);
+		frameAllocator.BeginFrame();
+	}
+
+	ASSERT_EQ(frameAllocator.GetCurrentBufferIndex(), 0u);
+	ASSERT_EQ(frameAllocator.Alloc(64, 8, 0), firstAllocations[0]) << "Buffer of the oldest frame was not released";
+	ASSERT_NE(firstAllocations[1], firstAllocations[0]);
+}
+
+TEST(FrameAllocator, Returns_Nullptr_When_Frame_Is_Exhausted)
+{
+	sp::memory::FrameAllocator frameAllocator(ONE_MIBIBYTE);
+
+	ASSERT_NE(frameAllocator.Alloc(ONE_KIBIBYTE * 768, 1, 0), nullptr);
+	ASSERT_EQ(frameAllocator.Alloc(ONE_KIBIBYTE * 768, 1, 0), nullptr);
+
+	frameAllocator.BeginFrame();
+	ASSERT_NE(frameAllocator.Alloc(ONE_KIBIBYTE * 768, 1, 0), nullptr) << "The next frame has its own buffer";
+}
+
+TEST(FrameAllocator, User_Provided_Memory_Is_Split_Between_Buffers)
+{
+	std::vector<char> memory(ONE_KIBIBYTE * 2);
+	sp::memory::FrameAllocator frameAllocator(memory.data(), memory.data() + memory.size());
+
+	char* first = static_cast<char*>(frameAllocator.Alloc(512, 1, 0));
+	ASSERT_NE(first, nullptr);
+	ASSERT_EQ(frameAllocator.Alloc(768, 1, 0), nullptr);
+
+	frameAllocator.BeginFrame();
+	char* second = static_cast<char*>(frameAllocator.Alloc(512, 1, 0));
+	ASSERT_GE(second, memory.data() + ONE_KIBIBYTE);
+	ASSERT_LT(second, memory.data() + memory.size());
+}
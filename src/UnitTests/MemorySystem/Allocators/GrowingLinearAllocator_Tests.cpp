@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "Allocator/Growing/GrowingLinearAllocator.h"
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	const size_t ONE_KIBIBYTE = 1024;
+	const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
+}
+
+TEST(GrowingLinearAllocator, Commits_Only_The_First_Grow_Step)
+{
+	sp::memory::GrowingLinearAllocator allocator(ONE_MIBIBYTE * 64, ONE_KIBIBYTE * 64);
+
+	ASSERT_EQ(allocator.GetCommittedSize(), ONE_KIBIBYTE * 64);
+	ASSERT_EQ(allocator.GetUsedSize(), 0u);
+}
+
+TEST(GrowingLinearAllocator, Grows_On_Demand)
+{
+	sp::memory::GrowingLinearAllocator allocator(ONE_MIBIBYTE * 64, ONE_KIBIBYTE * 64);
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		void* raw_mem = allocator.Alloc(ONE_KIBIBYTE * 10, 16, 0);
+		ASSERT_NE(raw_mem, nullptr) << "GrowingLinearAllocator did not return a valid pointer";
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 16));
+		std::memset(raw_mem, 0xAB, ONE_KIBIBYTE * 10);
+		ASSERT_EQ(allocator.GetAllocationSize(raw_mem), ONE_KIBIBYTE * 10);
+	}
+
+	ASSERT_GE(allocator.GetCommittedSize(), ONE_KIBIBYTE * 1000);
+	ASSERT_LT(allocator.GetCommittedSize(), ONE_KIBIBYTE * 1000 + ONE_KIBIBYTE * 128);
+}
+
+TEST(GrowingLinearAllocator, Single_Allocation_Larger_Than_Grow_Step)
+{
+	sp::memory::GrowingLinearAllocator allocator(ONE_MIBIBYTE * 64, ONE_KIBIBYTE * 64);
+
+	void* raw_mem = allocator.Alloc(ONE_MIBIBYTE, 1, 0);
+	ASSERT_NE(raw_mem, nullptr);
+	std::memset(raw_mem, 0xAB, ONE_MIBIBYTE);
+}
+
+TEST(GrowingLinearAllocator, Return_Nullptr_When_Reservation_Is_Exhausted)
+{
+	sp::memory::GrowingLinearAllocator allocator(ONE_MIBIBYTE, ONE_KIBIBYTE * 64);
+
+	ASSERT_NE(allocator.Alloc(ONE_KIBIBYTE * 512, 1, 0), nullptr);
+	ASSERT_EQ(allocator.Alloc(ONE_KIBIBYTE * 768, 1, 0), nullptr);
+	ASSERT_NE(allocator.Alloc(ONE_KIBIBYTE * 256, 1, 0), nullptr) << "A failed allocation must not use up memory";
+}
+
+TEST(GrowingLinearAllocator, Reset_Keeps_Committed_Memory_Without_History)
+{
+	sp::memory::GrowingLinearAllocator allocator(ONE_MIBIBYTE * 64, ONE_KIBIBYTE * 64);
+
+	allocator.Alloc(ONE_MIBIBYTE * 4, 1, 0);
+	const size_t committedSize = allocator.GetCommittedSize();
+	allocator.Reset();
+
+	ASSERT_EQ(allocator.GetCommittedSize(), committedSize);
+	ASSERT_EQ(allocator.GetUsedSize(), 0u);
+}
+
+TEST(GrowingLinearAllocator, Reset_Decommits_Above_High_Water_Mark_Of_Last_Frames)
+{
+	const size_t historyLength = 3;
+	sp::memory::GrowingLinearAllocator allocator(ONE_MIBIBYTE * 64, ONE_KIBIBYTE * 64, historyLength);
+
+	// One frame with a spike, followed by quiet frames
+	allocator.Alloc(ONE_MIBIBYTE * 4, 1, 0);
+	allocator.Reset();
+	ASSERT_GE(allocator.GetCommittedSize(), ONE_MIBIBYTE * 4) << "The spike is still within the last frames";
+
+	for (size_t frame = 0; frame < historyLength; ++frame)
+	{
+		void* raw_mem = allocator.Alloc(ONE_KIBIBYTE * 100, 1, 0);
+		std::memset(raw_mem, 0xAB, ONE_KIBIBYTE * 100);
+		allocator.Reset();
+	}
+
+	ASSERT_EQ(allocator.GetCommittedSize(), ONE_KIBIBYTE * 128) << "Pages above the recent high-water mark were not decommitted";
+
+	// Decommitted pages are committed again on demand
+	void* raw_mem = allocator.Alloc(ONE_MIBIBYTE * 2, 1, 0);
+	ASSERT_NE(raw_mem, nullptr);
+	std::memset(raw_mem, 0xAB, ONE_MIBIBYTE * 2);
+}
@@ -1,7 +1,12 @@
 #include "gtest/gtest.h"
 
+#include <cstring>
+#include <thread>
+#include <vector>
+
 #include "Allocator/Growing/GrowingPoolAllocator.h"
 #include "Pointers/PointerUtil.h"
+#include "VirtualMemory/VirtualMemory.h"
 
 const size_t ONE_KIBIBYTE = 1024;
 const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
@@ -168,4 +173,229 @@ TEST(GrowingPoolAllocator, Allocations_Do_Not_Invalidate_Objects)
 		ASSERT_TRUE(data[idx]->without == idx);
 		ASSERT_TRUE(data[idx]->meaning == idx);
 	}
-}
\ No newline at end of file
+}
+/// Tests for trimming
+TEST(GrowingPoolAllocator, Trim_Decommits_Empty_Blocks)
+{
+	sp::memory::GrowingPoolAllocator poolAllocator(64, 64, 512, 8, 0);
+	const size_t blockSize = poolAllocator.GetCommittedSize();
+
+	void* allocations[400];
+	for (void*& allocation : allocations)
+	{
+		allocation = poolAllocator.Alloc(64, 8, 0);
+		ASSERT_NE(allocation, nullptr);
+	}
+	const size_t peakCommittedSize = poolAllocator.GetCommittedSize();
+	ASSERT_GT(peakCommittedSize, 2 * blockSize);
+
+	// Keep the first allocation alive, so only the first block has to stay committed
+	for (size_t idx = 1; idx < 400; ++idx)
+	{
+		poolAllocator.Dealloc(allocations[idx]);
+	}
+
+	ASSERT_EQ(poolAllocator.Trim(), peakCommittedSize - blockSize);
+	ASSERT_EQ(poolAllocator.GetCommittedSize(), blockSize);
+	ASSERT_EQ(poolAllocator.Trim(), 0u) << "Trimming twice must not release anything";
+
+	// The remaining free chunks are valid and trimmed blocks are recommitted on demand
+	for (size_t idx = 1; idx < 400; ++idx)
+	{
+		allocations[idx] = poolAllocator.Alloc(64, 8, 0);
+		ASSERT_NE(allocations[idx], nullptr);
+		std::memset(allocations[idx], 0xAB, 64);
+	}
+	ASSERT_EQ(poolAllocator.GetCommittedSize(), peakCommittedSize);
+}
+
+TEST(GrowingPoolAllocator, Reset_After_Trim)
+{
+	sp::memory::GrowingPoolAllocator poolAllocator(64, 64, 512, 8, 0);
+
+	void* allocations[400];
+	for (void*& allocation : allocations)
+	{
+		allocation = poolAllocator.Alloc(64, 8, 0);
+	}
+
+	for (void* allocation : allocations)
+	{
+		poolAllocator.Dealloc(allocation);
+	}
+
+	poolAllocator.Trim();
+	ASSERT_EQ(poolAllocator.GetCommittedSize(), 0u);
+
+	poolAllocator.Reset();
+	for (void*& allocation : allocations)
+	{
+		allocation = poolAllocator.Alloc(64, 8, 0);
+		ASSERT_NE(allocation, nullptr);
+		std::memset(allocation, 0xAB, 64);
+	}
+}
+
+TEST(GrowingPoolAllocator, Auto_Trim_Releases_Memory_After_Spike)
+{
+	sp::memory::GrowingPoolAllocator poolAllocator(64, 64, 512, 8, 0);
+	poolAllocator.SetAutoTrimThreshold(1);
+
+	void* allocations[400];
+	for (void*& allocation : allocations)
+	{
+		allocation = poolAllocator.Alloc(64, 8, 0);
+	}
+	const size_t peakCommittedSize = poolAllocator.GetCommittedSize();
+
+	for (void* allocation : allocations)
+	{
+		poolAllocator.Dealloc(allocation);
+	}
+
+	ASSERT_LT(poolAllocator.GetCommittedSize(), peakCommittedSize);
+}
+
+TEST(GrowingPoolAllocator, Auto_Trim_Is_Not_Supported_Concurrently)
+{
+	sp::memory::ConcurrentGrowingPoolAllocator poolAllocator(64, 64, 512, 8, 0);
+	ASSERT_DEATH(poolAllocator.SetAutoTrimThreshold(1), "Automatic trimming is not supported");
+}
+
+/// Tests for the lazily initialized free list
+TEST(GrowingPoolAllocator, Reset_Reuses_Committed_Blocks_In_Order)
+{
+	sp::memory::GrowingPoolAllocator poolAllocator(64, 64, 512, 8, 0);
+
+	void* allocations[400];
+	for (void*& allocation : allocations)
+	{
+		allocation = poolAllocator.Alloc(64, 8, 0);
+	}
+	const size_t peakCommittedSize = poolAllocator.GetCommittedSize();
+
+	poolAllocator.Reset();
+
+	// Handed out from the first block again, in the same order and without committing anything
+	for (void* allocation : allocations)
+	{
+		ASSERT_EQ(poolAllocator.Alloc(64, 8, 0), allocation);
+	}
+	ASSERT_EQ(poolAllocator.GetCommittedSize(), peakCommittedSize);
+}
+
+TEST(GrowingPoolAllocator, Trim_After_Reset_Releases_Untouched_Blocks)
+{
+	sp::memory::GrowingPoolAllocator poolAllocator(64, 64, 512, 8, 0);
+	const size_t blockSize = poolAllocator.GetCommittedSize();
+
+	void* allocations[400];
+	for (void*& allocation : allocations)
+	{
+		allocation = poolAllocator.Alloc(64, 8, 0);
+	}
+
+	poolAllocator.Reset();
+	void* first = poolAllocator.Alloc(64, 8, 0);
+	poolAllocator.Trim();
+	ASSERT_EQ(poolAllocator.GetCommittedSize(), blockSize);
+
+	// The bump pointer recommits the trimmed blocks when it reaches them
+	for (size_t idx = 1; idx < 400; ++idx)
+	{
+		allocations[idx] = poolAllocator.Alloc(64, 8, 0);
+		ASSERT_NE(allocations[idx], nullptr);
+		ASSERT_NE(allocations[idx], first);
+		std::memset(allocations[idx], 0xAB, 64);
+	}
+}
+
+TEST(GrowingPoolAllocator, Returned_Chunks_Are_Reused_Before_Untouched_Ones)
+{
+	sp::memory::GrowingPoolAllocator poolAllocator(64, 64, 512, 8, 0);
+
+	void* first = poolAllocator.Alloc(64, 8, 0);
+	void* second = poolAllocator.Alloc(64, 8, 0);
+	poolAllocator.Dealloc(first);
+
+	ASSERT_EQ(poolAllocator.Alloc(64, 8, 0), first);
+	ASSERT_GT(poolAllocator.Alloc(64, 8, 0), second);
+}
+
+TEST(GrowingPoolAllocator, Concurrent_Free_List_Grows_And_Resets)
+{
+	sp::memory::ConcurrentGrowingPoolAllocator poolAllocator(64, 64, 512, 8, 0);
+
+	void* allocations[400];
+	for (size_t round = 0; round < 2; ++round)
+	{
+		for (void*& allocation : allocations)
+		{
+			allocation = poolAllocator.Alloc(64, 8, 0);
+			ASSERT_NE(allocation, nullptr);
+			std::memset(allocation, 0xAB, 64);
+		}
+
+		poolAllocator.Reset();
+	}
+}
+
+TEST(GrowingPoolAllocator, Concurrent_Returns_Survive_Growing)
+{
+	const size_t chunkCount = 2048;
+	const size_t maxChunkCount = 8192;
+
+	size_t capacity = 0;
+	{
+		sp::memory::ConcurrentGrowingPoolAllocator emptyPool(64, 64, maxChunkCount, 8, 0);
+		std::vector<void*> chunks(maxChunkCount * 2);
+		capacity = emptyPool.AllocChunks(chunks.data(), chunks.size());
+	}
+
+	sp::memory::ConcurrentGrowingPoolAllocator poolAllocator(64, 64, maxChunkCount, 8, 0);
+
+	std::vector<void*> returned(chunkCount);
+	for (void*& allocation : returned)
+	{
+		allocation = poolAllocator.Alloc(64, 8, 0);
+	}
+
+	// The free list keeps running dry while the other thread returns chunks to it
+	std::vector<void*> allocated(chunkCount);
+	std::thread returner([&]()
+	{
+		for (void* allocation : returned)
+		{
+			poolAllocator.Dealloc(allocation);
+		}
+	});
+	for (void*& allocation : allocated)
+	{
+		allocation = poolAllocator.Alloc(64, 8, 0);
+	}
+	returner.join();
+
+	std::vector<void*> remaining(capacity);
+	ASSERT_EQ(poolAllocator.AllocChunks(remaining.data(), remaining.size()), capacity - chunkCount) << "Chunks returned while growing were lost";
+}
+
+TEST(GrowingPoolAllocator, Header_Free_Chunks_Are_Packed_And_Grow)
+{
+	sp::memory::HeaderFreeGrowingPoolAllocator pool(16, 256, 1024, 16, 0);
+
+	char* previous = static_cast<char*>(pool.Alloc(16, 16, 0));
+	ASSERT_EQ(pool.GetAllocationSize(previous), 16u) << "Allocation size is not implied by the pool";
+	for (size_t i = 1; i < 1024; ++i)
+	{
+		char* raw_mem = static_cast<char*>(pool.Alloc(16, 16, 0));
+		ASSERT_TRUE(pool.Owns(raw_mem)) << "Pool did not own its allocation";
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 16)) << "Pointer was not aligned to a 16";
+		// Consecutive chunks are packed within a block, growing starts the next one on a page boundary
+		ASSERT_TRUE(raw_mem - previous == 16 || sp::pointerUtil::IsAlignedTo(raw_mem, sp::memory::GetPageSize())) << "Chunks of a header-free pool were not packed";
+		memset(raw_mem, 0xAB, 16);
+		previous = raw_mem;
+	}
+
+	pool.Dealloc(previous);
+	ASSERT_EQ(pool.Alloc(16, 16, 0), previous) << "Freed chunk was not reused";
+}
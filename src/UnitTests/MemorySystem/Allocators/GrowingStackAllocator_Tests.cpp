@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "Allocator/Growing/GrowingStackAllocator.h"
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	const size_t ONE_KIBIBYTE = 1024;
+	const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
+}
+
+TEST(GrowingStackAllocator, Single_Allocation_Right_Alignment)
+{
+	sp::memory::GrowingStackAllocator stackAllocator(ONE_MIBIBYTE * 10);
+	void* raw_mem = stackAllocator.Alloc(256, 16, 0);
+	ASSERT_NE(raw_mem, nullptr) << "GrowingStackAllocator shall return a valid pointer";
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 16)) << "Raw_mem should be aligned to a 16-byte boundary";
+	ASSERT_EQ(stackAllocator.GetAllocationSize(raw_mem), 256u);
+}
+
+TEST(GrowingStackAllocator, Grows_On_Demand)
+{
+	sp::memory::GrowingStackAllocator stackAllocator(ONE_MIBIBYTE * 10, ONE_KIBIBYTE * 64);
+	ASSERT_EQ(stackAllocator.GetCommittedSize(), ONE_KIBIBYTE * 64);
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		void* raw_mem = stackAllocator.Alloc(ONE_MIBIBYTE, 16, 0);
+		ASSERT_NE(raw_mem, nullptr) << "GrowingStackAllocator shall grow to fulfill the request";
+		std::memset(raw_mem, 0xAB, ONE_MIBIBYTE);
+	}
+
+	ASSERT_GE(stackAllocator.GetCommittedSize(), ONE_MIBIBYTE * 4);
+}
+
+TEST(GrowingStackAllocator, Returns_Nullptr_When_Reservation_Is_Exhausted)
+{
+	sp::memory::GrowingStackAllocator stackAllocator(ONE_MIBIBYTE * 10);
+	ASSERT_NE(stackAllocator.Alloc(ONE_MIBIBYTE * 6, 4, 0), nullptr);
+	ASSERT_EQ(stackAllocator.Alloc(ONE_MIBIBYTE * 6, 4, 0), nullptr) << "GrowingStackAllocator shall return nullptr on oom";
+}
+
+TEST(GrowingStackAllocator, Reverse_Free)
+{
+	sp::memory::GrowingStackAllocator stackAllocator(ONE_MIBIBYTE * 10);
+	void* raw_mem_1 = stackAllocator.Alloc(ONE_KIBIBYTE, 4, 0);
+	void* raw_mem_2 = stackAllocator.Alloc(ONE_KIBIBYTE, 4, 0);
+
+	stackAllocator.Dealloc(raw_mem_2);
+	ASSERT_EQ(stackAllocator.Alloc(ONE_KIBIBYTE, 4, 0), raw_mem_2);
+
+	stackAllocator.Dealloc(raw_mem_2);
+	stackAllocator.Dealloc(raw_mem_1);
+	ASSERT_EQ(stackAllocator.GetMarker(), 0u);
+}
+
+TEST(GrowingStackAllocator, Free_To_Marker_Releases_Nested_Scopes)
+{
+	sp::memory::GrowingStackAllocator stackAllocator(ONE_MIBIBYTE * 10, ONE_KIBIBYTE * 64);
+	void* persistent = stackAllocator.Alloc(64, 8, 0);
+	std::memset(persistent, 0xAB, 64);
+
+	const sp::memory::GrowingStackAllocator::Marker outerMarker = stackAllocator.GetMarker();
+	void* firstTemporary = stackAllocator.Alloc(ONE_KIBIBYTE, 8, 0);
+
+	const sp::memory::GrowingStackAllocator::Marker innerMarker = stackAllocator.GetMarker();
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		ASSERT_NE(stackAllocator.Alloc(ONE_KIBIBYTE, 8, 0), nullptr);
+	}
+
+	stackAllocator.FreeToMarker(innerMarker);
+	ASSERT_EQ(stackAllocator.GetMarker(), innerMarker);
+
+	stackAllocator.FreeToMarker(outerMarker);
+	ASSERT_EQ(stackAllocator.Alloc(ONE_KIBIBYTE, 8, 0), firstTemporary) << "Memory of the scope was not reused";
+
+	for (size_t i = 0; i < 64; ++i)
+	{
+		ASSERT_EQ(static_cast<uint8_t*>(persistent)[i], 0xAB) << "Allocation in front of the marker was touched";
+	}
+}
+
+TEST(GrowingStackAllocator, Free_To_Released_Marker_Asserts)
+{
+	sp::memory::GrowingStackAllocator stackAllocator(ONE_MIBIBYTE * 10);
+	stackAllocator.Alloc(ONE_KIBIBYTE, 8, 0);
+	const sp::memory::GrowingStackAllocator::Marker marker = stackAllocator.GetMarker();
+	stackAllocator.Reset();
+
+	ASSERT_DEATH(stackAllocator.FreeToMarker(marker), "Marker lies above the top of the stack");
+}
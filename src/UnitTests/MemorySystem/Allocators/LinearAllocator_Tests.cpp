@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include "Allocator/NonGrowing/LinearAllocator.h"
+#include "Pointers/PointerUtil.h"
 
 const size_t ONE_KIBIBYTE = 1024;
 const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
@@ -82,4 +83,36 @@ TEST(LinearAllocator_NonGrowing, Allocations_Do_Not_Invalidate_Objects)
 		ASSERT_TRUE(data[idx]->without == idx);
 		ASSERT_TRUE(data[idx]->meaning == idx);
 	}
-}
\ No newline at end of file
+}
+TEST(LinearAllocator_NonGrowing, Batch_Allocation_Matches_Single_Allocations)
+{
+	sp::memory::LinearAllocator batchAlloc(ONE_MIBIBYTE);
+	sp::memory::LinearAllocator singleAlloc(ONE_MIBIBYTE);
+
+	void* batch[100];
+	ASSERT_EQ(batchAlloc.AllocN(100, 52, 16, 4, batch), 100u);
+
+	char* firstSingle = static_cast<char*>(singleAlloc.Alloc(52, 16, 4));
+	for (size_t idx = 1; idx < 100; ++idx)
+	{
+		char* single = static_cast<char*>(singleAlloc.Alloc(52, 16, 4));
+		ASSERT_EQ(static_cast<char*>(batch[idx]) - static_cast<char*>(batch[0]), single - firstSingle) << "Batch layout differs from single allocations";
+	}
+
+	for (void* allocation : batch)
+	{
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(static_cast<char*>(allocation) + 4, 16));
+		ASSERT_EQ(batchAlloc.GetAllocationSize(allocation), 52u);
+	}
+}
+
+TEST(LinearAllocator_NonGrowing, Batch_Allocation_Stops_When_Exhausted)
+{
+	sp::memory::LinearAllocator linearAlloc(ONE_KIBIBYTE);
+
+	void* batch[100];
+	const size_t allocationCount = linearAlloc.AllocN(100, 60, 4, 0, batch);
+	ASSERT_EQ(allocationCount, 16u) << "Only 16 blocks of 60 bytes plus header fit into one kibibyte";
+	ASSERT_LE(static_cast<char*>(batch[allocationCount - 1]) + 60, static_cast<char*>(batch[0]) + ONE_KIBIBYTE);
+	ASSERT_EQ(linearAlloc.Alloc(60, 4, 0), nullptr);
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Allocator/ThreadCaching/PerNodeAllocator.h"
+#include "Allocator/Growing/GrowingLinearAllocator.h"
+#include "Allocator/Growing/GrowingPoolAllocator.h"
+#include "PageMap/PageMap.h"
+#include "Pointers/PointerUtil.h"
+#include "VirtualMemory/VirtualMemory.h"
+
+const size_t ONE_KIBIBYTE = 1024;
+const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
+
+struct NodeObject
+{
+	uint32_t foo[16];
+	uint32_t bar[16];
+};
+
+// Every allocation carries the 4 byte index of its node in front, the pool has to leave room for it
+typedef sp::memory::PerNodeAllocator<sp::memory::GrowingPoolAllocator> PerNodePool;
+typedef sp::memory::PerNodeAllocator<sp::memory::GrowingLinearAllocator> PerNodeLinear;
+
+TEST(PerNodeAllocator, Instances_Are_Created_For_Used_Nodes_Only)
+{
+	PerNodeLinear allocator(ONE_MIBIBYTE);
+
+	char* raw_mem = static_cast<char*>(allocator.Alloc(sizeof(NodeObject), 16, 0));
+	ASSERT_NE(raw_mem, nullptr) << "PerNodeAllocator did not return a valid pointer";
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 16)) << "Pointer was not aligned to a 16";
+	ASSERT_EQ(allocator.GetAllocationSize(raw_mem), sizeof(NodeObject)) << "Allocation size is not the requested one";
+
+	size_t instanceCount = 0;
+	for (uint32_t node = 0; node < sp::memory::NUMA_MAX_NODE_COUNT; ++node)
+	{
+		if (allocator.GetNodeAllocator(node))
+		{
+			ASSERT_LT(node, sp::memory::GetNumaNodeCount()) << "Instance was created for a node that does not exist";
+			++instanceCount;
+		}
+	}
+	ASSERT_EQ(instanceCount, 1u) << "A single thread should only create the instance of its own node";
+
+	ASSERT_EQ(sp::memory::FindPageOwner(raw_mem).GetAllocator(), &allocator) << "Pages of the instance were not registered for the front-end";
+}
+
+TEST(PerNodeAllocator, Memory_Is_Committed_On_The_Node_Of_The_Instance)
+{
+	PerNodeLinear allocator(ONE_MIBIBYTE);
+
+	char* raw_mem = static_cast<char*>(allocator.Alloc(sizeof(NodeObject), 16, 0));
+	raw_mem[0] = 1;
+
+	for (uint32_t node = 0; node < sp::memory::GetNumaNodeCount(); ++node)
+	{
+		if (allocator.GetNodeAllocator(node))
+		{
+			const uint32_t pageNode = sp::memory::GetNumaNodeOfPage(raw_mem);
+			ASSERT_TRUE(pageNode == node || pageNode == sp::memory::NUMA_NODE_ANY) << "Memory was not committed on the node of the instance";
+		}
+	}
+}
+
+TEST(PerNodeAllocator, Frees_From_Other_Threads_Reach_The_Owner)
+{
+	PerNodePool allocator(sizeof(NodeObject) + sizeof(uint32_t), 100, 1000, 16, sizeof(uint32_t));
+
+	std::vector<void*> allocations;
+	std::thread([&]()
+	{
+		for (size_t i = 0; i < 100; ++i)
+		{
+			void* raw_mem = allocator.Alloc(sizeof(NodeObject), 16, 0);
+			ASSERT_NE(raw_mem, nullptr) << "PerNodeAllocator did not return a valid pointer";
+			ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 16)) << "Pointer was not aligned to a 16";
+			allocations.push_back(raw_mem);
+		}
+	}).join();
+
+	for (void* raw_mem : allocations)
+	{
+		allocator.Dealloc(raw_mem);
+	}
+
+	std::set<void*> reused;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		reused.insert(allocator.Alloc(sizeof(NodeObject), 16, 0));
+	}
+	ASSERT_EQ(reused, std::set<void*>(allocations.begin(), allocations.end())) << "Freed chunks were not returned to the instance of their node";
+}
+
+TEST(PerNodeAllocator, Reset_Resets_All_Instances)
+{
+	PerNodeLinear allocator(ONE_MIBIBYTE);
+
+	void* first = allocator.Alloc(sizeof(NodeObject), 16, 0);
+	allocator.Alloc(sizeof(NodeObject), 16, 0);
+	allocator.Reset();
+
+	ASSERT_EQ(allocator.Alloc(sizeof(NodeObject), 16, 0), first) << "Reset did not rewind the instance";
+}
@@ -1,5 +1,9 @@
 #include "gtest/gtest.h"
 
+#include <set>
+#include <thread>
+#include <vector>
+
 #include "Allocator/NonGrowing/PoolAllocator.h"
 #include "Pointers/PointerUtil.h"
 
@@ -148,4 +152,146 @@ TEST(PoolAllocator_NonGrowing, Allocations_Do_Not_Invalidate_Objects)
 		ASSERT_TRUE(data[idx]->without == idx);
 		ASSERT_TRUE(data[idx]->meaning == idx);
 	}
-}
\ No newline at end of file
+}
+
+TEST(PoolAllocator_NonGrowing, Concurrent_Pool_Allocations_Are_Unique)
+{
+	const size_t threadCount = 8;
+	const size_t allocationsPerThread = 500;
+	// One extra chunk per thread for the churning allocation
+	sp::memory::ConcurrentPoolAllocator pool(sizeof(size_t) * 4, threadCount * (allocationsPerThread + 1), 8, 0);
+
+	std::vector<std::vector<void*>> allocations(threadCount);
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&pool, &allocations, t, allocationsPerThread]()
+		{
+			for (size_t i = 0; i < allocationsPerThread; ++i)
+			{
+				void* raw_mem = pool.Alloc(sizeof(size_t) * 4, 8, 0);
+				allocations[t].push_back(raw_mem);
+
+				// Churn a little to provoke interleaved frees
+				if (i % 2 == 0)
+				{
+					pool.Dealloc(pool.Alloc(sizeof(size_t), 8, 0));
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::set<void*> uniqueAllocations;
+	for (const std::vector<void*>& threadAllocations : allocations)
+	{
+		uniqueAllocations.insert(threadAllocations.begin(), threadAllocations.end());
+	}
+
+	ASSERT_EQ(uniqueAllocations.size(), threadCount * allocationsPerThread) << "A chunk was handed out twice";
+}
+
+TEST(PoolAllocator_NonGrowing, Batch_Allocation_And_Free)
+{
+	sp::memory::PoolAllocator poolAllocator(64, 100, 16, 0);
+
+	void* batch[150];
+	ASSERT_EQ(poolAllocator.AllocN(150, 64, 16, 0, batch), 100u) << "Only the 100 chunks of the pool can be handed out";
+
+	std::set<void*> uniqueAllocations(batch, batch + 100);
+	ASSERT_EQ(uniqueAllocations.size(), 100u);
+	for (size_t idx = 0; idx < 100; ++idx)
+	{
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(batch[idx], 16));
+		ASSERT_EQ(poolAllocator.GetAllocationSize(batch[idx]), 64u);
+	}
+
+	poolAllocator.DeallocN(batch, 50);
+	ASSERT_EQ(poolAllocator.AllocN(150, 32, 16, 0, batch), 50u);
+}
+
+TEST(PoolAllocator_NonGrowing, Concurrent_Batch_Allocation_And_Free)
+{
+	sp::memory::ConcurrentPoolAllocator poolAllocator(64, 100, 16, 0);
+
+	void* chunks[100];
+	ASSERT_EQ(poolAllocator.AllocChunks(chunks, 100), 100u);
+	ASSERT_EQ(poolAllocator.AllocChunks(chunks, 1), 0u);
+
+	// The whole batch is spliced back into the lock-free list with a single swap
+	poolAllocator.DeallocChunks(chunks, 100);
+
+	void* batch[100];
+	ASSERT_EQ(poolAllocator.AllocN(100, 64, 16, 0, batch), 100u);
+	std::set<void*> uniqueAllocations(batch, batch + 100);
+	ASSERT_EQ(uniqueAllocations.size(), 100u);
+}
+
+TEST(PoolAllocator_NonGrowing, Header_Free_Chunks_Are_Packed)
+{
+	sp::memory::HeaderFreePoolAllocator pool(16, 100, 16, 0);
+
+	char* first = static_cast<char*>(pool.Alloc(16, 16, 0));
+	char* second = static_cast<char*>(pool.Alloc(16, 16, 0));
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(first, 16)) << "Pointer was not aligned to a 16";
+	ASSERT_EQ(second - first, 16) << "Chunks of a header-free pool were not packed";
+	ASSERT_EQ(pool.GetAllocationSize(first), 16u) << "Allocation size is not implied by the pool";
+	ASSERT_TRUE(pool.Owns(first)) << "Pool did not own its allocation";
+
+	int onStack = 0;
+	ASSERT_FALSE(pool.Owns(&onStack)) << "Pool claimed a pointer it did not allocate";
+
+	pool.Dealloc(second);
+	ASSERT_EQ(pool.Alloc(8, 8, 0), second) << "Freed chunk was not reused";
+}
+
+TEST(PoolAllocator_NonGrowing, Header_Free_Chunks_Keep_Offset_Alignment)
+{
+	sp::memory::HeaderFreePoolAllocator pool(32, 10, 16, 4);
+
+	for (size_t i = 0; i < 10; ++i)
+	{
+		char* raw_mem = static_cast<char*>(pool.Alloc(32, 16, 4));
+		ASSERT_NE(raw_mem, nullptr) << "PoolAllocator did not return a valid pointer";
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem + 4, 16)) << "Pointer + offset was not aligned to a 16";
+	}
+}
+
+TEST(PoolAllocator_NonGrowing, Remote_Frees_Are_Reused_By_The_Owner)
+{
+	sp::memory::RemoteFreePoolAllocator poolAllocator(64, 100, 16, 0);
+
+	void* chunks[100];
+	for (size_t idx = 0; idx < 100; ++idx)
+	{
+		chunks[idx] = poolAllocator.Alloc(64, 16, 0);
+		ASSERT_NE(chunks[idx], nullptr) << "PoolAllocator did not return a valid pointer";
+	}
+	ASSERT_EQ(poolAllocator.AllocChunks(chunks, 1), 0u) << "Pool should be exhausted";
+
+	// Freed on two other threads, both go to the remote list of the pool
+	std::thread first([&]() { poolAllocator.DeallocN(chunks, 50); });
+	std::thread second([&]()
+	{
+		for (size_t idx = 50; idx < 100; ++idx)
+		{
+			poolAllocator.Dealloc(chunks[idx]);
+		}
+	});
+	first.join();
+	second.join();
+
+	std::set<void*> uniqueAllocations;
+	for (size_t idx = 0; idx < 100; ++idx)
+	{
+		void* raw_mem = poolAllocator.Alloc(64, 16, 0);
+		ASSERT_NE(raw_mem, nullptr) << "Remotely freed chunk was not reused";
+		uniqueAllocations.insert(raw_mem);
+	}
+	ASSERT_EQ(uniqueAllocations.size(), 100u) << "A chunk was handed out twice";
+}
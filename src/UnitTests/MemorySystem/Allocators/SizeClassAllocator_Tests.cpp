@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+
+#include <set>
+
+#include "Allocator/Growing/SizeClassAllocator.h"
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	const size_t BYTES_PER_SIZE_CLASS = 1024 * 1024;
+}
+
+TEST(SizeClassAllocator, Size_Classes_Grow_Geometrically)
+{
+	ASSERT_EQ(sp::memory::SizeClassAllocator::GetSizeClassSize(0), 16u);
+	ASSERT_EQ(sp::memory::SizeClassAllocator::GetSizeClassSize(1), 24u);
+	ASSERT_EQ(sp::memory::SizeClassAllocator::GetSizeClassSize(2), 32u);
+	ASSERT_EQ(sp::memory::SizeClassAllocator::GetSizeClassSize(3), 48u);
+	ASSERT_EQ(sp::memory::SizeClassAllocator::GetSizeClassSize(sp::memory::SizeClassAllocator::SIZE_CLASS_COUNT - 1),
+		sp::memory::SizeClassAllocator::MAX_SMALL_SIZE);
+}
+
+TEST(SizeClassAllocator, Sizes_Map_To_Smallest_Fitting_Class)
+{
+	for (size_t size = 1; size <= sp::memory::SizeClassAllocator::MAX_SMALL_SIZE; ++size)
+	{
+		const size_t sizeClass = sp::memory::SizeClassAllocator::GetSizeClass(size);
+		ASSERT_LT(sizeClass, sp::memory::SizeClassAllocator::SIZE_CLASS_COUNT) << "Size " << size << " has no size class";
+		ASSERT_GE(sp::memory::SizeClassAllocator::GetSizeClassSize(sizeClass), size) << "Size class of " << size << " is too small";
+
+		if (sizeClass > 0)
+		{
+			ASSERT_LT(sp::memory::SizeClassAllocator::GetSizeClassSize(sizeClass - 1), size) << "Size " << size << " does not use the smallest class";
+		}
+	}
+}
+
+TEST(SizeClassAllocator, Allocate_Objects_Of_Every_Class)
+{
+	sp::memory::SizeClassAllocator allocator(BYTES_PER_SIZE_CLASS);
+	std::set<void*> allocations;
+
+	for (size_t sizeClass = 0; sizeClass < sp::memory::SizeClassAllocator::SIZE_CLASS_COUNT; ++sizeClass)
+	{
+		const size_t size = sp::memory::SizeClassAllocator::GetSizeClassSize(sizeClass);
+		void* raw_mem = allocator.Alloc(size, 1, 0);
+		ASSERT_NE(raw_mem, nullptr) << "SizeClassAllocator did not return a valid pointer";
+		ASSERT_EQ(allocator.GetAllocationSize(raw_mem), size) << "Allocation size was not recorded";
+		memset(raw_mem, 0xAB, size);
+		allocations.insert(raw_mem);
+	}
+
+	ASSERT_EQ(allocations.size(), sp::memory::SizeClassAllocator::SIZE_CLASS_COUNT) << "A block was handed out twice";
+}
+
+TEST(SizeClassAllocator, Allocate_Aligned_Objects)
+{
+	sp::memory::SizeClassAllocator allocator(BYTES_PER_SIZE_CLASS);
+
+	for (size_t size = 1; size < 1000; size += 7)
+	{
+		void* raw_mem = allocator.Alloc(size, 16, 0);
+		ASSERT_NE(raw_mem, nullptr) << "SizeClassAllocator did not return a valid pointer";
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 16)) << "Pointer was not aligned to a 16";
+	}
+}
+
+TEST(SizeClassAllocator, Allocate_Aligned_Objects_With_Offset)
+{
+	sp::memory::SizeClassAllocator allocator(BYTES_PER_SIZE_CLASS);
+
+	for (size_t size = 1; size < 1000; size += 7)
+	{
+		void* raw_mem = allocator.Alloc(size, 16, 4);
+		ASSERT_NE(raw_mem, nullptr) << "SizeClassAllocator did not return a valid pointer";
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(static_cast<char*>(raw_mem) + 4, 16)) << "Pointer + offset was not aligned to a 16";
+	}
+}
+
+TEST(SizeClassAllocator, Freed_Blocks_Are_Reused_Within_Their_Class)
+{
+	sp::memory::SizeClassAllocator allocator(BYTES_PER_SIZE_CLASS);
+
+	void* first_alloc = allocator.Alloc(40, 8, 0);
+	allocator.Dealloc(first_alloc);
+	void* second_alloc = allocator.Alloc(48, 8, 0);
+
+	ASSERT_EQ(first_alloc, second_alloc) << "Sizes of the same class should share freed blocks";
+}
+
+TEST(SizeClassAllocator, Large_Allocations_Bypass_The_Classes)
+{
+	sp::memory::SizeClassAllocator allocator(BYTES_PER_SIZE_CLASS);
+
+	const size_t size = 3 * sp::memory::SizeClassAllocator::MAX_SMALL_SIZE + 5;
+	void* raw_mem = allocator.Alloc(size, 256, 0);
+	ASSERT_NE(raw_mem, nullptr) << "SizeClassAllocator did not return a valid pointer";
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 256)) << "Pointer was not aligned to a 256";
+	ASSERT_EQ(allocator.GetAllocationSize(raw_mem), size) << "Allocation size was not recorded";
+
+	memset(raw_mem, 0xAB, size);
+	allocator.Dealloc(raw_mem);
+}
+
+TEST(SizeClassAllocator, Strictly_Aligned_Small_Allocations_Bypass_The_Classes)
+{
+	sp::memory::SizeClassAllocator allocator(BYTES_PER_SIZE_CLASS);
+
+	void* raw_mem = allocator.Alloc(32, 64, 0);
+	ASSERT_NE(raw_mem, nullptr) << "SizeClassAllocator did not return a valid pointer";
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 64)) << "Pointer was not aligned to a 64";
+	ASSERT_EQ(allocator.GetAllocationSize(raw_mem), 32u) << "Allocation size was not recorded";
+	allocator.Dealloc(raw_mem);
+}
+
+TEST(SizeClassAllocator, Exhausted_Class_Spills_Into_Large_Allocations)
+{
+	sp::memory::SizeClassAllocator allocator(sp::memory::SizeClassAllocator::MAX_SMALL_SIZE);
+	std::set<void*> allocations;
+
+	for (size_t i = 0; i < 4096; ++i)
+	{
+		void* raw_mem = allocator.Alloc(1024, 8, 0);
+		ASSERT_NE(raw_mem, nullptr) << "SizeClassAllocator did not return a valid pointer";
+		allocations.insert(raw_mem);
+	}
+
+	ASSERT_EQ(allocations.size(), 4096u) << "A block was handed out twice";
+
+	for (void* allocation : allocations)
+	{
+		allocator.Dealloc(allocation);
+	}
+}
+
+TEST(SizeClassAllocator, Reset_Frees_All_Blocks)
+{
+	sp::memory::SizeClassAllocator allocator(BYTES_PER_SIZE_CLASS);
+
+	void* first_small = allocator.Alloc(100, 8, 0);
+	allocator.Alloc(1024 * 1024, 8, 0);
+	allocator.Reset();
+
+	void* second_small = allocator.Alloc(100, 8, 0);
+	ASSERT_EQ(first_small, second_small) << "Reset did not free the small blocks";
+}
@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "Allocator/Growing/SlabAllocator.h"
+#include "Pointers/PointerUtil.h"
+#include "VirtualMemory/VirtualMemory.h"
+
+namespace
+{
+	struct EntityPayload
+	{
+		static size_t constructions;
+		static size_t destructions;
+
+		EntityPayload() : id(0u), health(100.0f) { ++constructions; }
+		EntityPayload(uint32_t id, float health) : id(id), health(health) { ++constructions; }
+		~EntityPayload() { ++destructions; }
+
+		uint32_t id;
+		float health;
+		double position[3];
+	};
+
+	size_t EntityPayload::constructions = 0u;
+	size_t EntityPayload::destructions = 0u;
+
+	struct alignas(64) AlignedPayload
+	{
+		char data[100];
+	};
+
+	void ResetCounters()
+	{
+		EntityPayload::constructions = 0u;
+		EntityPayload::destructions = 0u;
+	}
+}
+
+TEST(SlabAllocator, Constructs_And_Destroys_Objects)
+{
+	ResetCounters();
+	{
+		sp::memory::SlabAllocator<EntityPayload> slabAllocator(1000);
+
+		EntityPayload* payload = slabAllocator.Alloc(7u, 42.0f);
+		ASSERT_NE(payload, nullptr);
+		ASSERT_EQ(payload->id, 7u);
+		ASSERT_EQ(payload->health, 42.0f);
+		ASSERT_EQ(EntityPayload::constructions, 1u);
+
+		slabAllocator.Dealloc(payload);
+		ASSERT_EQ(EntityPayload::destructions, 1u);
+
+		slabAllocator.Alloc();
+		slabAllocator.Alloc();
+	}
+	ASSERT_EQ(EntityPayload::destructions, 3u) << "Live objects have to be destroyed with the allocator";
+}
+
+TEST(SlabAllocator, Aligns_Objects)
+{
+	sp::memory::SlabAllocator<AlignedPayload> slabAllocator(1000);
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		AlignedPayload* payload = slabAllocator.Alloc();
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(payload, alignof(AlignedPayload)));
+	}
+}
+
+TEST(SlabAllocator, Moves_Slabs_Between_Lists)
+{
+	sp::memory::SlabAllocator<EntityPayload> slabAllocator(10000);
+	const size_t objectsPerSlab = slabAllocator.GetStatistics().objectsPerSlab;
+	ASSERT_GE(objectsPerSlab, sp::memory::SlabAllocator<EntityPayload>::MIN_OBJECTS_PER_SLAB);
+	ASSERT_EQ(slabAllocator.GetStatistics().slabSize, sp::memory::GetPageSize());
+
+	std::vector<EntityPayload*> payloads;
+	for (size_t i = 0; i < objectsPerSlab + 1; ++i)
+	{
+		payloads.push_back(slabAllocator.Alloc());
+	}
+
+	sp::memory::SlabAllocatorStatistics statistics = slabAllocator.GetStatistics();
+	ASSERT_EQ(statistics.fullSlabs, 1u);
+	ASSERT_EQ(statistics.partialSlabs, 1u);
+	ASSERT_EQ(statistics.liveObjects, objectsPerSlab + 1);
+
+	// Freeing from the full slab makes it partial, the next allocations keep filling partial slabs
+	slabAllocator.Dealloc(payloads[0]);
+	statistics = slabAllocator.GetStatistics();
+	ASSERT_EQ(statistics.fullSlabs, 0u);
+	ASSERT_EQ(statistics.partialSlabs, 2u);
+
+	slabAllocator.Dealloc(payloads.back());
+	statistics = slabAllocator.GetStatistics();
+	ASSERT_EQ(statistics.partialSlabs, 1u);
+	ASSERT_EQ(statistics.emptySlabs, 1u);
+	ASSERT_EQ(statistics.committedBytes, 2 * statistics.slabSize);
+}
+
+TEST(SlabAllocator, Decommits_Surplus_Empty_Slabs)
+{
+	sp::memory::SlabAllocator<EntityPayload> slabAllocator(10000, 1);
+	const size_t objectsPerSlab = slabAllocator.GetStatistics().objectsPerSlab;
+
+	std::vector<EntityPayload*> payloads;
+	for (size_t i = 0; i < objectsPerSlab * 4; ++i)
+	{
+		payloads.push_back(slabAllocator.Alloc());
+	}
+	ASSERT_EQ(slabAllocator.GetStatistics().committedBytes, 4 * slabAllocator.GetStatistics().slabSize);
+
+	for (EntityPayload* payload : payloads)
+	{
+		slabAllocator.Dealloc(payload);
+	}
+
+	sp::memory::SlabAllocatorStatistics statistics = slabAllocator.GetStatistics();
+	ASSERT_EQ(statistics.emptySlabs, 1u) << "Only one empty slab is kept as a cache";
+	ASSERT_EQ(statistics.committedBytes, statistics.slabSize);
+
+	slabAllocator.ReleaseEmptySlabs();
+	ASSERT_EQ(slabAllocator.GetStatistics().committedBytes, 0u);
+
+	// Decommitted slabs are committed again on demand
+	for (size_t i = 0; i < objectsPerSlab * 4; ++i)
+	{
+		EntityPayload* payload = slabAllocator.Alloc(static_cast<uint32_t>(i), 1.0f);
+		ASSERT_NE(payload, nullptr);
+		ASSERT_EQ(payload->id, i);
+	}
+}
+
+TEST(SlabAllocator, Returns_Nullptr_When_Exhausted)
+{
+	sp::memory::SlabAllocator<EntityPayload> slabAllocator(1);
+	const size_t objectsPerSlab = slabAllocator.GetStatistics().objectsPerSlab;
+
+	for (size_t i = 0; i < objectsPerSlab; ++i)
+	{
+		ASSERT_NE(slabAllocator.Alloc(), nullptr);
+	}
+	ASSERT_EQ(slabAllocator.Alloc(), nullptr);
+}
+
+TEST(SlabAllocator, Double_Free_Asserts)
+{
+	sp::memory::SlabAllocator<EntityPayload> slabAllocator(100);
+	EntityPayload* payload = slabAllocator.Alloc();
+	slabAllocator.Alloc();
+	slabAllocator.Dealloc(payload);
+
+	ASSERT_DEATH(slabAllocator.Dealloc(payload), "Object was already freed");
+}
+
+TEST(CachingSlabAllocator, Keeps_Objects_Constructed)
+{
+	ResetCounters();
+	{
+		sp::memory::CachingSlabAllocator<EntityPayload> slabAllocator(1000, 0);
+		const size_t objectsPerSlab = slabAllocator.GetStatistics().objectsPerSlab;
+
+		EntityPayload* payload = slabAllocator.Alloc();
+		ASSERT_EQ(EntityPayload::constructions, objectsPerSlab) << "The whole slab is constructed up front";
+		ASSERT_EQ(payload->health, 100.0f);
+
+		EntityPayload* other = slabAllocator.Alloc();
+		payload->id = 1234u;
+		slabAllocator.Dealloc(payload);
+		ASSERT_EQ(EntityPayload::destructions, 0u);
+
+		EntityPayload* reused = slabAllocator.Alloc();
+		ASSERT_EQ(reused, payload);
+		ASSERT_EQ(reused->id, 1234u) << "A cached object is handed out in the state it was freed in";
+		ASSERT_EQ(EntityPayload::constructions, objectsPerSlab);
+
+		// Decommitting the slab destroys all of its objects
+		slabAllocator.Dealloc(reused);
+		slabAllocator.Dealloc(other);
+		ASSERT_EQ(EntityPayload::destructions, objectsPerSlab);
+
+		slabAllocator.Alloc();
+		ASSERT_EQ(EntityPayload::constructions, 2 * objectsPerSlab);
+	}
+	ASSERT_EQ(EntityPayload::destructions, EntityPayload::constructions);
+}
@@ -117,4 +117,45 @@ TEST(StackAllocator_NonGrowing, Allocations_Do_Not_Invalidate_Objects)
 		ASSERT_TRUE(data[idx]->without == idx);
 		ASSERT_TRUE(data[idx]->meaning == idx);
 	}
-}
\ No newline at end of file
+}
+TEST(StackAllocator_NonGrowing, Free_To_Marker_Releases_Scope)
+{
+	sp::memory::StackAllocator stackAllocator(ONE_MIBIBYTE * 10);
+	void* persistent = stackAllocator.Alloc(ONE_KIBIBYTE, 16, 0);
+
+	const sp::memory::StackAllocator::Marker marker = stackAllocator.GetMarker();
+	void* firstTemporary = stackAllocator.Alloc(ONE_KIBIBYTE, 16, 0);
+	for (size_t i = 0; i < 100; ++i)
+	{
+		stackAllocator.Alloc(ONE_KIBIBYTE, 16, 0);
+	}
+
+	stackAllocator.FreeToMarker(marker);
+
+	ASSERT_EQ(stackAllocator.GetMarker(), marker);
+	ASSERT_EQ(stackAllocator.Alloc(ONE_KIBIBYTE, 16, 0), firstTemporary) << "Memory of the scope was not reused";
+	ASSERT_EQ(stackAllocator.GetAllocationSize(persistent), ONE_KIBIBYTE);
+}
+
+TEST(StackAllocator_NonGrowing, Batch_Allocation_And_Free)
+{
+	sp::memory::StackAllocator stackAllocator(ONE_MIBIBYTE);
+	void* persistent = stackAllocator.Alloc(100, 8, 0);
+	const sp::memory::StackAllocator::Marker marker = stackAllocator.GetMarker();
+
+	void* batch[100];
+	ASSERT_EQ(stackAllocator.AllocN(100, 40, 16, 0, batch), 100u);
+	for (size_t idx = 0; idx < 100; ++idx)
+	{
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(batch[idx], 16));
+		ASSERT_EQ(stackAllocator.GetAllocationSize(batch[idx]), 40u);
+	}
+
+	// Single frees walk the batch down block by block
+	stackAllocator.Dealloc(batch[99]);
+	ASSERT_EQ(static_cast<char*>(stackAllocator.Alloc(40, 16, 0)), batch[99]);
+
+	stackAllocator.DeallocN(batch, 100);
+	ASSERT_EQ(stackAllocator.GetMarker(), marker);
+	ASSERT_EQ(stackAllocator.GetAllocationSize(persistent), 100u);
+}
@@ -0,0 +1,192 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Allocator/ThreadCaching/ThreadCachingPoolAllocator.h"
+#include "Allocator/NonGrowing/PoolAllocator.h"
+#include "Allocator/Growing/GrowingPoolAllocator.h"
+#include "Pointers/PointerUtil.h"
+
+struct CachedObject
+{
+	uint32_t foo[16];
+	uint32_t bar[16];
+};
+
+typedef sp::memory::ThreadCachingPoolAllocator<sp::memory::PoolAllocator> CachingPool;
+typedef sp::memory::ThreadCachingPoolAllocator<sp::memory::GrowingPoolAllocator> CachingGrowingPool;
+
+TEST(ThreadCachingPoolAllocator, Allocate_Single_Object)
+{
+	CachingPool pool(sizeof(CachedObject), 100, 1, 0);
+	void* raw_mem = pool.Alloc(sizeof(CachedObject), 1, 0);
+	ASSERT_NE(raw_mem, nullptr) << "ThreadCachingPoolAllocator did not return a valid pointer";
+	ASSERT_EQ(pool.GetAllocationSize(raw_mem), sizeof(CachedObject)) << "Allocation size was not recorded";
+}
+
+TEST(ThreadCachingPoolAllocator, Allocate_Aligned_Objects)
+{
+	CachingPool pool(sizeof(CachedObject), 100, 32, 0);
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		void* raw_mem = pool.Alloc(sizeof(CachedObject), 32, 0);
+		ASSERT_NE(raw_mem, nullptr) << "ThreadCachingPoolAllocator did not return a valid pointer";
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 32)) << "Pointer was not aligned to a 32";
+	}
+}
+
+TEST(ThreadCachingPoolAllocator, Alignment_Above_Pool_Alignment_Asserts)
+{
+	CachingPool pool(sizeof(CachedObject), 100, 16, 0);
+	ASSERT_DEATH(pool.Alloc(sizeof(CachedObject), 64, 0), ".*");
+}
+
+TEST(ThreadCachingPoolAllocator, Returns_Nullptr_When_Pool_Is_Exhausted)
+{
+	CachingPool pool(sizeof(CachedObject), 10, 1, 0);
+
+	for (size_t i = 0; i < 10; ++i)
+	{
+		ASSERT_NE(pool.Alloc(sizeof(CachedObject), 1, 0), nullptr) << "ThreadCachingPoolAllocator did not return a valid pointer";
+	}
+
+	ASSERT_EQ(pool.Alloc(sizeof(CachedObject), 1, 0), nullptr) << "Exhausted pool should return a nullptr";
+}
+
+TEST(ThreadCachingPoolAllocator, Freed_Chunks_Are_Reused)
+{
+	CachingPool pool(sizeof(CachedObject), 10, 1, 0);
+
+	void* first_alloc = pool.Alloc(sizeof(CachedObject), 1, 0);
+	pool.Dealloc(first_alloc);
+	void* second_alloc = pool.Alloc(sizeof(CachedObject), 1, 0);
+
+	ASSERT_EQ(first_alloc, second_alloc) << "The last freed chunk should be handed out first";
+}
+
+TEST(ThreadCachingPoolAllocator, Growing_Pool_Grows_Through_Cache)
+{
+	CachingGrowingPool pool(sizeof(CachedObject), 10, 1000, 1, 0);
+	std::set<void*> allocations;
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		void* raw_mem = pool.Alloc(sizeof(CachedObject), 1, 0);
+		ASSERT_NE(raw_mem, nullptr) << "ThreadCachingPoolAllocator did not return a valid pointer";
+		allocations.insert(raw_mem);
+	}
+
+	ASSERT_EQ(allocations.size(), 1000u) << "A chunk was handed out twice";
+}
+
+TEST(ThreadCachingPoolAllocator, Concurrent_Allocations_Are_Unique)
+{
+	const size_t threadCount = 8;
+	const size_t allocationsPerThread = 2000;
+	// Leave headroom for the chunks that stay cached in the magazines of the other threads
+	CachingGrowingPool pool(sizeof(CachedObject), 256, 2 * threadCount * allocationsPerThread, 1, 0);
+
+	std::vector<std::vector<void*>> allocations(threadCount);
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&pool, &allocations, t, allocationsPerThread]()
+		{
+			for (size_t i = 0; i < allocationsPerThread; ++i)
+			{
+				CachedObject* object = new (pool.Alloc(sizeof(CachedObject), 1, 0)) CachedObject;
+				object->foo[0] = static_cast<uint32_t>(t);
+				allocations[t].push_back(object);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::set<void*> uniqueAllocations;
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		for (void* allocation : allocations[t])
+		{
+			ASSERT_EQ(static_cast<CachedObject*>(allocation)->foo[0], t) << "Object was overwritten by another thread";
+			uniqueAllocations.insert(allocation);
+		}
+	}
+
+	ASSERT_EQ(uniqueAllocations.size(), threadCount * allocationsPerThread) << "A chunk was handed out twice";
+}
+
+TEST(ThreadCachingPoolAllocator, Cross_Thread_Frees_Return_To_Pool)
+{
+	const size_t objectCount = 1000;
+	CachingPool pool(sizeof(CachedObject), objectCount, 1, 0);
+	std::vector<void*> allocations;
+
+	for (size_t i = 0; i < objectCount; ++i)
+	{
+		allocations.push_back(pool.Alloc(sizeof(CachedObject), 1, 0));
+	}
+
+	std::thread consumer([&pool, &allocations]()
+	{
+		for (void* allocation : allocations)
+		{
+			pool.Dealloc(allocation);
+		}
+	});
+	consumer.join();
+
+	// All chunks apart from the ones still cached by the exited consumer's magazine have to be available again
+	size_t reallocations = 0;
+	while (pool.Alloc(sizeof(CachedObject), 1, 0) != nullptr)
+	{
+		++reallocations;
+	}
+
+	ASSERT_GE(reallocations, objectCount - CachingPool::MAGAZINE_CAPACITY) << "Chunks freed on another thread did not return to the pool";
+}
+
+TEST(ThreadCachingPoolAllocator, Threads_Without_Cache_Index_Use_The_Pool)
+{
+	const size_t threadCount = sp::memory::THREAD_CACHE_MAX_THREADS + 16;
+	CachingPool pool(sizeof(CachedObject), threadCount * CachingPool::MAGAZINE_BATCH_SIZE, 1, 0);
+
+	// All threads stay alive until every one allocated, so the indices run out
+	std::atomic<size_t> allocatedCount(0);
+	std::vector<void*> allocations(threadCount, nullptr);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&pool, &allocatedCount, &allocations, t, threadCount]()
+		{
+			allocations[t] = pool.Alloc(sizeof(CachedObject), 1, 0);
+			allocatedCount.fetch_add(1);
+			while (allocatedCount.load() < threadCount)
+			{
+				std::this_thread::yield();
+			}
+
+			if (allocations[t])
+			{
+				pool.Dealloc(allocations[t]);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::set<void*> uniqueAllocations(allocations.begin(), allocations.end());
+	ASSERT_EQ(uniqueAllocations.count(nullptr), 0u) << "A thread without a cache index did not get a chunk";
+	ASSERT_EQ(uniqueAllocations.size(), threadCount) << "A chunk was handed out twice";
+}
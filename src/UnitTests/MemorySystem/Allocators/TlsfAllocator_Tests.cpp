@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Allocator/NonGrowing/TlsfAllocator.h"
+#include "BoundsChecker/SimpleBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	const size_t ONE_KIBIBYTE = 1024;
+	const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
+
+	typedef sp::memory::MemoryRealm<sp::memory::TlsfAllocator, sp::memory::SimpleBoundsChecker> TlsfRealm;
+}
+
+TEST(TlsfAllocator, Allocate_Aligned_Objects)
+{
+	sp::memory::TlsfAllocator tlsfAllocator(ONE_MIBIBYTE);
+
+	const size_t alignments[] = { 1, 4, 8, 16, 64, 256, 4096 };
+	for (size_t alignment : alignments)
+	{
+		void* raw_mem = tlsfAllocator.Alloc(100, alignment, 0);
+		ASSERT_NE(raw_mem, nullptr) << "TlsfAllocator did not return a valid pointer";
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, alignment)) << "Allocation is not aligned to " << alignment;
+		ASSERT_EQ(tlsfAllocator.GetAllocationSize(raw_mem), 100u);
+	}
+}
+
+TEST(TlsfAllocator, Allocate_Aligned_Objects_With_Offset)
+{
+	sp::memory::TlsfAllocator tlsfAllocator(ONE_MIBIBYTE);
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		char* raw_mem = static_cast<char*>(tlsfAllocator.Alloc(24, 16, 4));
+		ASSERT_NE(raw_mem, nullptr);
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem + 4, 16));
+		std::memset(raw_mem, 0xAB, 24 + 4);
+	}
+}
+
+TEST(TlsfAllocator, Coalesces_Freed_Neighbours)
+{
+	sp::memory::TlsfAllocator tlsfAllocator(ONE_MIBIBYTE);
+	const size_t initialFreeBlock = tlsfAllocator.GetLargestFreeBlockSize();
+
+	void* first = tlsfAllocator.Alloc(ONE_KIBIBYTE, 8, 0);
+	void* second = tlsfAllocator.Alloc(ONE_KIBIBYTE, 8, 0);
+	void* third = tlsfAllocator.Alloc(ONE_KIBIBYTE, 8, 0);
+	ASSERT_LT(tlsfAllocator.GetLargestFreeBlockSize(), initialFreeBlock);
+
+	// Free the middle block last, so it merges with both neighbours
+	tlsfAllocator.Dealloc(first);
+	tlsfAllocator.Dealloc(third);
+	tlsfAllocator.Dealloc(second);
+
+	ASSERT_EQ(tlsfAllocator.GetLargestFreeBlockSize(), initialFreeBlock) << "Freed blocks were not merged into a single one";
+	ASSERT_EQ(tlsfAllocator.GetFreeSize(), initialFreeBlock);
+}
+
+TEST(TlsfAllocator, Frees_In_Any_Order)
+{
+	sp::memory::TlsfAllocator tlsfAllocator(ONE_MIBIBYTE * 16);
+	const size_t initialFreeSize = tlsfAllocator.GetFreeSize();
+
+	std::mt19937 random(42);
+	std::uniform_int_distribution<size_t> sizeDistribution(1, 16 * ONE_KIBIBYTE);
+
+	std::vector<void*> allocations;
+	for (size_t round = 0; round < 20; ++round)
+	{
+		for (size_t i = 0; i < 100; ++i)
+		{
+			const size_t size = sizeDistribution(random);
+			void* raw_mem = tlsfAllocator.Alloc(size, 16, 0);
+			ASSERT_NE(raw_mem, nullptr);
+			std::memset(raw_mem, static_cast<int>(i), size);
+			allocations.push_back(raw_mem);
+		}
+
+		std::shuffle(allocations.begin(), allocations.end(), random);
+		for (size_t i = 0; i < 50; ++i)
+		{
+			tlsfAllocator.Dealloc(allocations.back());
+			allocations.pop_back();
+		}
+	}
+
+	for (void* allocation : allocations)
+	{
+		tlsfAllocator.Dealloc(allocation);
+	}
+
+	ASSERT_EQ(tlsfAllocator.GetFreeSize(), initialFreeSize);
+	ASSERT_EQ(tlsfAllocator.GetLargestFreeBlockSize(), initialFreeSize);
+}
+
+TEST(TlsfAllocator, Returns_Nullptr_When_Exhausted)
+{
+	sp::memory::TlsfAllocator tlsfAllocator(ONE_MIBIBYTE);
+
+	ASSERT_NE(tlsfAllocator.Alloc(ONE_KIBIBYTE * 600, 1, 0), nullptr);
+	ASSERT_EQ(tlsfAllocator.Alloc(ONE_KIBIBYTE * 600, 1, 0), nullptr);
+	ASSERT_NE(tlsfAllocator.Alloc(ONE_KIBIBYTE * 100, 1, 0), nullptr);
+}
+
+TEST(TlsfAllocator, Double_Free_Asserts)
+{
+	sp::memory::TlsfAllocator tlsfAllocator(ONE_MIBIBYTE);
+	void* first = tlsfAllocator.Alloc(ONE_KIBIBYTE, 1, 0);
+	tlsfAllocator.Alloc(ONE_KIBIBYTE, 1, 0);
+	tlsfAllocator.Dealloc(first);
+
+	ASSERT_DEATH(tlsfAllocator.Dealloc(first), "Block was already freed");
+}
+
+TEST(TlsfAllocator, User_Provided_Memory)
+{
+	std::vector<char> memory(64 * ONE_KIBIBYTE);
+	sp::memory::TlsfAllocator tlsfAllocator(memory.data() + 3, memory.data() + memory.size());
+
+	std::vector<char*> allocations;
+	while (char* raw_mem = static_cast<char*>(tlsfAllocator.Alloc(1000, 8, 0)))
+	{
+		ASSERT_GE(raw_mem, memory.data() + 3);
+		ASSERT_LE(raw_mem + 1000, memory.data() + memory.size());
+		allocations.push_back(raw_mem);
+	}
+
+	ASSERT_GE(allocations.size(), 60u) << "Per-block overhead is too large";
+}
+
+TEST(TlsfAllocator, Plugs_Into_Memory_Realm)
+{
+	TlsfRealm memRealm(ONE_MIBIBYTE);
+
+	void* first = memRealm.Alloc(100, 16);
+	void* second = memRealm.Alloc(200, 16);
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(first, 16));
+
+	memRealm.Dealloc(first);
+	memRealm.Dealloc(second);
+
+	char* stomped = static_cast<char*>(memRealm.Alloc(100, 16));
+	stomped[100] = 0;
+	ASSERT_DEATH(memRealm.Dealloc(stomped), "Back Canary was not valid");
+}
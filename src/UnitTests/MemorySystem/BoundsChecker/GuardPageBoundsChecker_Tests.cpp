@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+
+#include "Allocator/NonGrowing/LinearAllocator.h"
+#include "BoundsChecker/GuardPageBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "MemoryTracker/CountingMemoryTracker.h"
+#include "Pointers/PointerUtil.h"
+#include "VirtualMemory/VirtualMemory.h"
+
+namespace
+{
+	const size_t ONE_KIBIBYTE = 1024;
+	const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
+
+	typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::GuardPageBoundsChecker<>> GuardedLinearRealm;
+	typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::GuardPageBoundsChecker<4>, sp::memory::CountingMemoryTracker> SampledLinearRealm;
+
+	void WriteBytes(void* memory, size_t size)
+	{
+		volatile char* bytes = static_cast<char*>(memory);
+		for (size_t i = 0; i < size; ++i)
+		{
+			bytes[i] = 0x42;
+		}
+	}
+}
+
+TEST(GuardPage_BoundsChecker, Places_Allocation_Directly_In_Front_Of_Guard_Page)
+{
+	sp::memory::GuardPageBoundsChecker<> boundsChecker;
+	const size_t pageSize = sp::memory::GetPageSize();
+
+	void* memory = boundsChecker.AllocGuarded(100, 4);
+
+	ASSERT_TRUE(boundsChecker.IsGuarded(memory));
+	ASSERT_EQ(boundsChecker.GetGuardedSize(memory), 100);
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(memory, 4));
+	ASSERT_EQ(sp::pointerUtil::pseudo_cast<uintptr_t>(memory, 100) % pageSize, 0u) << "Allocation does not end at the guard page";
+
+	WriteBytes(memory, 100);
+	boundsChecker.DeallocGuarded(memory);
+
+	ASSERT_FALSE(boundsChecker.IsGuarded(memory));
+	ASSERT_EQ(boundsChecker.GetGuardedCount(), 0u);
+}
+
+TEST(GuardPage_BoundsChecker, Respects_Alignment)
+{
+	sp::memory::GuardPageBoundsChecker<> boundsChecker;
+
+	void* memory = boundsChecker.AllocGuarded(100, 64);
+
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(memory, 64));
+	WriteBytes(memory, 100);
+}
+
+TEST(GuardPage_BoundsChecker, Faults_On_Write_Past_The_End)
+{
+	sp::memory::GuardPageBoundsChecker<> boundsChecker;
+	void* memory = boundsChecker.AllocGuarded(ONE_KIBIBYTE, 1);
+
+	ASSERT_DEATH(WriteBytes(memory, ONE_KIBIBYTE + 1), "");
+}
+
+TEST(GuardPage_BoundsChecker, Faults_On_Write_Before_The_Start)
+{
+	sp::memory::GuardPageBoundsChecker<> boundsChecker;
+	const size_t pageSize = sp::memory::GetPageSize();
+	char* memory = static_cast<char*>(boundsChecker.AllocGuarded(pageSize, 1));
+
+	ASSERT_DEATH(WriteBytes(memory - 1, 1), "");
+}
+
+TEST(GuardPage_BoundsChecker, Faults_On_Access_After_Free)
+{
+	sp::memory::GuardPageBoundsChecker<> boundsChecker;
+	void* memory = boundsChecker.AllocGuarded(ONE_KIBIBYTE, 1);
+	boundsChecker.DeallocGuarded(memory);
+
+	ASSERT_DEATH(WriteBytes(memory, 1), "");
+}
+
+TEST(GuardPage_BoundsChecker, Guards_Every_Nth_Allocation)
+{
+	sp::memory::GuardPageBoundsChecker<4> boundsChecker;
+
+	size_t guardedCount = 0;
+	for (size_t i = 0; i < 16; ++i)
+	{
+		guardedCount += boundsChecker.ShouldGuard() ? 1u : 0u;
+	}
+
+	ASSERT_EQ(guardedCount, 4u);
+}
+
+TEST(GuardPage_BoundsChecker, Realm_Traps_Stomp_On_The_Faulting_Write)
+{
+	GuardedLinearRealm memRealm(ONE_MIBIBYTE);
+	void* memory = memRealm.Alloc(128, 8);
+
+	WriteBytes(memory, 128);
+	ASSERT_DEATH(WriteBytes(memory, 129), "");
+
+	memRealm.Dealloc(memory);
+}
+
+TEST(GuardPage_BoundsChecker, Sampled_Realm_Serves_Other_Allocations_From_Allocator)
+{
+	SampledLinearRealm memRealm(ONE_MIBIBYTE);
+	const size_t pageSize = sp::memory::GetPageSize();
+
+	void* allocations[8];
+	size_t allocationsAtPageEnd = 0;
+	for (void*& memory : allocations)
+	{
+		memory = memRealm.Alloc(64, 16);
+		ASSERT_NE(memory, nullptr);
+		WriteBytes(memory, 64);
+		allocationsAtPageEnd += (sp::pointerUtil::pseudo_cast<uintptr_t>(memory, 64) % pageSize) == 0u ? 1u : 0u;
+	}
+
+	ASSERT_GE(allocationsAtPageEnd, 2u);
+	ASSERT_EQ(memRealm.GetStatistics().liveAllocations, 8u);
+
+	for (void* memory : allocations)
+	{
+		memRealm.Dealloc(memory);
+	}
+
+	ASSERT_EQ(memRealm.GetStatistics().liveAllocations, 0u);
+}
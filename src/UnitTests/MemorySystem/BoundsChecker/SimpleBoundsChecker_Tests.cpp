@@ -64,4 +64,47 @@ TEST(Simple_BoundsChecker, Return_False_On_Corrupted_Front_Canary)
 	*somePtr = someVariable;
 
 	ASSERT_DEATH(boundsChecker.ValidateFrontCanary(raw_mem), "Front Canary was not valid") << "Could not validate front canary";
-}
\ No newline at end of file
+}
+
+TEST(Simple_BoundsChecker, Wide_Canaries_Fill_Whole_Width)
+{
+	sp::memory::SimpleBoundsChecker64 boundsChecker;
+	char raw_mem[1 + 64 + 1] = {};
+
+	// Unaligned on purpose, canaries follow arbitrarily sized user blocks
+	boundsChecker.WriteCanary(raw_mem + 1);
+
+	for (size_t idx = 1; idx <= 64; ++idx)
+	{
+		ASSERT_EQ(static_cast<uint8_t>(raw_mem[idx]), 0xCA) << "Canary byte " << idx - 1 << " was not written";
+	}
+	ASSERT_EQ(raw_mem[0], 0) << "Wrote in front of the canary";
+	ASSERT_EQ(raw_mem[65], 0) << "Wrote past the canary";
+}
+
+TEST(Simple_BoundsChecker, Wide_Canaries_Detect_Stomp_On_Last_Byte)
+{
+	sp::memory::SimpleBoundsChecker16 boundsChecker16;
+	sp::memory::SimpleBoundsChecker32 boundsChecker32;
+	sp::memory::SimpleBoundsChecker64 boundsChecker64;
+	char raw_mem[3][64];
+
+	boundsChecker16.WriteCanary(raw_mem[0]);
+	boundsChecker32.WriteCanary(raw_mem[1]);
+	boundsChecker64.WriteCanary(raw_mem[2]);
+
+	ASSERT_TRUE(boundsChecker16.IsValidCanary(raw_mem[0]));
+	ASSERT_TRUE(boundsChecker32.IsValidCanary(raw_mem[1]));
+	ASSERT_TRUE(boundsChecker64.IsValidCanary(raw_mem[2]));
+
+	raw_mem[0][15] = 0;
+	raw_mem[1][31] = 0;
+	raw_mem[2][63] = 0;
+
+	ASSERT_FALSE(boundsChecker16.IsValidCanary(raw_mem[0]));
+	ASSERT_FALSE(boundsChecker32.IsValidCanary(raw_mem[1]));
+	ASSERT_FALSE(boundsChecker64.IsValidCanary(raw_mem[2]));
+
+	ASSERT_EQ(boundsChecker64.FindCorruptedByte(raw_mem[2]), 63u);
+	ASSERT_DEATH(boundsChecker32.ValidateBackCanary(raw_mem[1]), "Back Canary was not valid");
+}
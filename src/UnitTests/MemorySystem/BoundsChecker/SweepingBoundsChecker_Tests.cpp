@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include "Allocator/NonGrowing/LinearAllocator.h"
+#include "BoundsChecker/SweepingBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+
+namespace
+{
+	const size_t ONE_MIBIBYTE = 1024 * 1024;
+
+	typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::SweepingBoundsChecker32> SweepingLinearRealm;
+}
+
+TEST(Sweeping_BoundsChecker, Realm_Uses_Wide_Canaries)
+{
+	SweepingLinearRealm memRealm(ONE_MIBIBYTE);
+	char* memory = static_cast<char*>(memRealm.Alloc(100, 16));
+
+	for (int idx = -32; idx < 0; ++idx)
+	{
+		ASSERT_EQ(static_cast<uint8_t>(memory[idx]), 0xCA) << "Front canary byte " << idx << " not set";
+	}
+	for (int idx = 100; idx < 132; ++idx)
+	{
+		ASSERT_EQ(static_cast<uint8_t>(memory[idx]), 0xCA) << "Back canary byte " << idx << " not set";
+	}
+}
+
+TEST(Sweeping_BoundsChecker, ValidateAll_Passes_Without_Stomps)
+{
+	SweepingLinearRealm memRealm(ONE_MIBIBYTE);
+
+	for (size_t idx = 0; idx < 100; ++idx)
+	{
+		memRealm.Alloc(idx + 1, 8);
+	}
+
+	const sp::memory::BoundsViolation violation = memRealm.ValidateAll();
+	ASSERT_EQ(violation.allocation, nullptr);
+}
+
+TEST(Sweeping_BoundsChecker, ValidateAll_Reports_Back_Stomp_With_Offset)
+{
+	SweepingLinearRealm memRealm(ONE_MIBIBYTE);
+
+	memRealm.Alloc(64, 8);
+	char* stomped = static_cast<char*>(memRealm.Alloc(48, 8));
+	memRealm.Alloc(64, 8);
+
+	// Skips the first bytes behind the block, a 4 byte canary would not notice
+	stomped[48 + 20] = 0;
+
+	const sp::memory::BoundsViolation violation = memRealm.ValidateAll();
+	ASSERT_EQ(violation.allocation, stomped);
+	ASSERT_EQ(violation.size, 48u);
+	ASSERT_EQ(violation.offset, 68);
+}
+
+TEST(Sweeping_BoundsChecker, ValidateAll_Reports_Front_Stomp_With_Offset)
+{
+	SweepingLinearRealm memRealm(ONE_MIBIBYTE);
+
+	char* stomped = static_cast<char*>(memRealm.Alloc(16, 8));
+	stomped[-3] = 0;
+
+	const sp::memory::BoundsViolation violation = memRealm.ValidateAll();
+	ASSERT_EQ(violation.allocation, stomped);
+	ASSERT_EQ(violation.offset, -3);
+}
+
+TEST(Sweeping_BoundsChecker, Freed_And_Reset_Allocations_Are_Not_Validated)
+{
+	SweepingLinearRealm memRealm(ONE_MIBIBYTE);
+
+	char* first = static_cast<char*>(memRealm.Alloc(16, 8));
+	char* second = static_cast<char*>(memRealm.Alloc(16, 8));
+	char* third = static_cast<char*>(memRealm.Alloc(16, 8));
+
+	memRealm.Dealloc(first);
+	first[16] = 0;
+	ASSERT_EQ(memRealm.ValidateAll().allocation, nullptr);
+
+	// The last block was moved into the freed slot and is still validated
+	third[16] = 0;
+	ASSERT_EQ(memRealm.ValidateAll().allocation, third);
+	third[16] = static_cast<char>(0xCA);
+
+	memRealm.Dealloc(third);
+	memRealm.Dealloc(second);
+
+	memRealm.Alloc(16, 8);
+	memRealm.Reset();
+	ASSERT_EQ(memRealm.ValidateAll().allocation, nullptr);
+}
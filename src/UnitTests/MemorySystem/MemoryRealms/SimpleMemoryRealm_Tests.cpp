@@ -1,7 +1,9 @@
 #include "gtest/gtest.h"
 
 #include "Allocator/NonGrowing/LinearAllocator.h"
+#include "Allocator/NonGrowing/PoolAllocator.h"
 #include "BoundsChecker/SimpleBoundsChecker.h"
+#include "BoundsChecker/NoBoundsChecker.h"
 #include "MemoryRealm/MemoryRealm.h"
 #include "Pointers/PointerUtil.h"
 
@@ -9,7 +11,26 @@ const size_t ONE_KIBIBYTE = 1024;
 const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
 
 typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::SimpleBoundsChecker> SimpleLinearRealm;
-typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::SimpleBoundsChecker> SimpleLinearRealm_Retail;
+typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::NoBoundsChecker> SimpleLinearRealm_Retail;
+
+/// Pool sized by the realm, the offset has to match the canary size of the bounds checker
+template <bool HEADER_FREE, size_t OFFSET>
+class RealmPool : public sp::memory::BasicPoolAllocator<sp::core::FreeList, HEADER_FREE>
+{
+public:
+	static const size_t ELEMENT_SIZE = 64;
+
+	explicit RealmPool(size_t bytes)
+		: sp::memory::BasicPoolAllocator<sp::core::FreeList, HEADER_FREE>(ELEMENT_SIZE, bytes / ELEMENT_SIZE, 16, OFFSET)
+	{}
+};
+
+typedef sp::memory::MemoryRealm<RealmPool<false, 4>, sp::memory::SimpleBoundsChecker> SimplePoolRealm;
+typedef sp::memory::MemoryRealm<RealmPool<true, 0>, sp::memory::NoBoundsChecker> HeaderFreePoolRealm_Retail;
+
+// Canaries, trackers and taggers look up the allocation size, header-free pools only know the maximum
+static_assert(!sp::memory::HeaderFreePoolAllocator::HAS_EXACT_ALLOCATION_SIZE && sp::memory::PoolAllocator::HAS_EXACT_ALLOCATION_SIZE,
+	"Only header-free pools may report more than the requested size");
 
 TEST(SimpleMemoryRealm, Linear_Allocator_With_BoundsChecking_sets_canaries)
 {
@@ -36,4 +57,54 @@ TEST(SimpleMemoryRealm, Linear_Allocator_With_BoundsChecking_Asserts_On_Back_Sto
 	*sp::pointerUtil::pseudo_cast<uint32_t*>(raw_mem_0, ONE_MIBIBYTE) = 0xAA;
 
 	ASSERT_DEATH(memRealm.Dealloc(raw_mem_0), "Back Canary was not valid");
-}
\ No newline at end of file
+}
+
+TEST(SimpleMemoryRealm, Linear_Allocator_Without_BoundsChecking_Adds_No_Canaries)
+{
+	SimpleLinearRealm_Retail memRealm(ONE_MIBIBYTE);
+	char* raw_mem_0 = static_cast<char*>(memRealm.Alloc(16, 1));
+	char* raw_mem_1 = static_cast<char*>(memRealm.Alloc(16, 1));
+
+	ASSERT_NE(raw_mem_0, nullptr) << "Realm did not return a valid pointer";
+	ASSERT_EQ(raw_mem_1 - raw_mem_0, 16 + 4) << "Allocations should only be separated by the allocator's header";
+	memRealm.Dealloc(raw_mem_1);
+	memRealm.Dealloc(raw_mem_0);
+}
+
+TEST(SimpleMemoryRealm, Linear_Allocator_Without_BoundsChecking_Respects_Alignment)
+{
+	SimpleLinearRealm_Retail memRealm(ONE_MIBIBYTE);
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		void* raw_mem = memRealm.Alloc(7, 32);
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(raw_mem, 32)) << "Pointer was not aligned to a 32";
+	}
+}
+
+TEST(SimpleMemoryRealm, Pool_Allocator_With_BoundsChecking_Uses_Exact_Size)
+{
+	SimplePoolRealm memRealm(ONE_KIBIBYTE);
+	char* raw_mem_0 = static_cast<char*>(memRealm.Alloc(8, 4));
+	char* raw_mem_1 = static_cast<char*>(memRealm.Alloc(40, 4));
+	ASSERT_NE(raw_mem_0, nullptr) << "Realm did not return a valid pointer";
+	ASSERT_NE(raw_mem_1, nullptr) << "Realm did not return a valid pointer";
+
+	// Allocations below the maximum element size find their back canary right behind them
+	memRealm.Dealloc(raw_mem_1);
+	*sp::pointerUtil::pseudo_cast<uint32_t*>(raw_mem_0, 8) = 0xAA;
+	ASSERT_DEATH(memRealm.Dealloc(raw_mem_0), "Back Canary was not valid");
+}
+
+TEST(SimpleMemoryRealm, Header_Free_Pool_Allocator_Without_BoundsChecking_Reuses_Chunks)
+{
+	HeaderFreePoolRealm_Retail memRealm(ONE_KIBIBYTE);
+	void* raw_mem_0 = memRealm.Alloc(8, 16);
+	void* raw_mem_1 = memRealm.Alloc(RealmPool<true, 0>::ELEMENT_SIZE, 16);
+	ASSERT_NE(raw_mem_0, nullptr) << "Realm did not return a valid pointer";
+	ASSERT_NE(raw_mem_1, nullptr) << "Realm did not return a valid pointer";
+
+	memRealm.Dealloc(raw_mem_0);
+	memRealm.Dealloc(raw_mem_1);
+	ASSERT_EQ(memRealm.Alloc(8, 16), raw_mem_1) << "Freed chunk was not handed out again";
+}
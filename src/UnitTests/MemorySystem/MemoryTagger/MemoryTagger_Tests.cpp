@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+#include "Allocator/Growing/SizeClassAllocator.h"
+#include "BoundsChecker/NoBoundsChecker.h"
+#include "BoundsChecker/SimpleBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "MemoryTracker/NoMemoryTracker.h"
+#include "MemoryTagger/FillingMemoryTagger.h"
+#include "MemoryTagger/CheckingMemoryTagger.h"
+#include "MemoryTagger/MemoryPattern.h"
+#include "VirtualMemory/VirtualMemory.h"
+
+namespace
+{
+	const size_t REALM_BYTES = 1024 * 1024;
+
+	typedef sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::SimpleBoundsChecker, sp::memory::NoMemoryTracker, sp::memory::FillingMemoryTagger> FillingRealm;
+	typedef sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::SimpleBoundsChecker, sp::memory::NoMemoryTracker, sp::memory::CheckingMemoryTagger> CheckingRealm;
+	typedef sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::NoBoundsChecker, sp::memory::NoMemoryTracker, sp::memory::CheckingMemoryTagger> CheckingRealmWithoutCanaries;
+}
+
+TEST(MemoryPattern, Fills_And_Checks_Unaligned_Ranges)
+{
+	std::vector<uint8_t> buffer(512, 0u);
+
+	for (size_t offset = 0; offset < 64; offset += 3)
+	{
+		for (size_t size = 0; size < 300; size += 7)
+		{
+			std::fill(buffer.begin(), buffer.end(), 0u);
+			sp::memory::FillPattern(buffer.data() + offset, size, 0xAB);
+
+			ASSERT_TRUE(sp::memory::IsFilledWithPattern(buffer.data() + offset, size, 0xAB)) << "Range was not filled completely";
+			if (offset > 0)
+			{
+				ASSERT_EQ(buffer[offset - 1], 0u) << "Fill started before the range";
+			}
+			ASSERT_EQ(buffer[offset + size], 0u) << "Fill continued after the range";
+		}
+	}
+}
+
+TEST(MemoryPattern, Detects_Single_Differing_Byte)
+{
+	std::vector<uint8_t> buffer(256, 0xDD);
+
+	for (size_t idx = 0; idx < buffer.size(); ++idx)
+	{
+		buffer[idx] = 0xDC;
+		ASSERT_FALSE(sp::memory::IsFilledWithPattern(buffer.data(), buffer.size(), 0xDD)) << "Differing byte at " << idx << " was not detected";
+		buffer[idx] = 0xDD;
+	}
+
+	ASSERT_TRUE(sp::memory::IsFilledWithPattern(buffer.data(), buffer.size(), 0xDD));
+}
+
+TEST(MemoryTagger, Fills_New_And_Freed_Memory)
+{
+	FillingRealm realm(REALM_BYTES);
+
+	uint8_t* memory = static_cast<uint8_t*>(realm.Alloc(100, 8));
+	ASSERT_TRUE(sp::memory::IsFilledWithPattern(memory, 100, sp::memory::ALLOCATED_MEMORY_PATTERN)) << "New allocation was not filled";
+
+	realm.Dealloc(memory);
+	ASSERT_TRUE(sp::memory::IsFilledWithPattern(memory, 100, sp::memory::FREED_MEMORY_PATTERN)) << "Freed allocation was not filled";
+}
+
+TEST(MemoryTagger, Reusing_Untouched_Memory_Passes)
+{
+	CheckingRealm realm(REALM_BYTES);
+	CheckingRealmWithoutCanaries realmWithoutCanaries(REALM_BYTES);
+
+	for (size_t size = 8; size < 2000; size += 13)
+	{
+		void* first = realm.Alloc(size, 8);
+		realm.Dealloc(first);
+		void* second = realm.Alloc(size / 2 + 8, 8);
+		realm.Dealloc(second);
+
+		first = realmWithoutCanaries.Alloc(size, 8);
+		realmWithoutCanaries.Dealloc(first);
+		second = realmWithoutCanaries.Alloc(size, 8);
+		realmWithoutCanaries.Dealloc(second);
+	}
+}
+
+TEST(MemoryTagger, Detects_Write_After_Free_On_Reuse)
+{
+	CheckingRealm realm(REALM_BYTES);
+
+	uint8_t* memory = static_cast<uint8_t*>(realm.Alloc(100, 8));
+	realm.Dealloc(memory);
+	memory[50] = 0x42;
+
+	ASSERT_DEATH(realm.Alloc(100, 8), "Freed memory was written after free");
+}
+
+TEST(MemoryTagger, Reset_Forgets_Freed_Blocks)
+{
+	CheckingRealm realm(REALM_BYTES);
+
+	uint8_t* memory = static_cast<uint8_t*>(realm.Alloc(100, 8));
+	realm.Dealloc(memory);
+	realm.Reset();
+	memory[50] = 0x42;
+
+	ASSERT_NE(realm.Alloc(100, 8), nullptr);
+}
+
+TEST(MemoryTagger, Detects_Zeroing_After_Free)
+{
+	CheckingRealm realm(REALM_BYTES);
+
+	uint8_t* memory = static_cast<uint8_t*>(realm.Alloc(100, 8));
+	realm.Dealloc(memory);
+	memset(memory, 0, 100);
+
+	ASSERT_DEATH(realm.Alloc(100, 8), "Freed memory was written after free");
+}
+
+TEST(MemoryTagger, Decommitted_Blocks_Are_Forgotten)
+{
+	const size_t pageSize = sp::memory::GetPageSize();
+	char* pages = static_cast<char*>(sp::memory::ReserveAddressSpace(2 * pageSize));
+	sp::memory::CommitPhysicalMemory(pages, 2 * pageSize);
+
+	sp::memory::CheckingMemoryTagger tagger;
+	tagger.TagDeallocation(pages, 100);
+	tagger.TagDeallocation(pages + pageSize - 50, 100);
+	tagger.TagDeallocation(pages + pageSize + 100, 100);
+	ASSERT_EQ(tagger.GetTrackedBlockCount(), 3u);
+
+	// The second block straddles the page boundary and is dropped as well
+	sp::memory::DecommitPhysicalMemory(pages, pageSize);
+	ASSERT_EQ(tagger.GetTrackedBlockCount(), 1u) << "Blocks in decommitted pages were not forgotten";
+
+	sp::memory::CommitPhysicalMemory(pages, pageSize);
+	tagger.TagAllocation(pages, 100);
+
+	sp::memory::FreeAddressSpace(pages, 2 * pageSize);
+	ASSERT_EQ(tagger.GetTrackedBlockCount(), 0u) << "Blocks in freed address space were not forgotten";
+}
+
+TEST(MemoryTagger, Freed_Blocks_Are_Capped)
+{
+	const size_t blockCount = sp::memory::CheckingMemoryTagger::MAX_TRACKED_FREED_BLOCKS + 16;
+	std::vector<uint8_t> memory(blockCount * 16);
+
+	sp::memory::CheckingMemoryTagger tagger;
+	for (size_t idx = 0; idx < blockCount; ++idx)
+	{
+		tagger.TagDeallocation(memory.data() + idx * 16, 16);
+	}
+
+	ASSERT_EQ(tagger.GetTrackedBlockCount(), sp::memory::CheckingMemoryTagger::MAX_TRACKED_FREED_BLOCKS) << "Freed blocks grow without limit";
+
+	// Allocating a block covering several freed ones forgets all of them
+	tagger.TagAllocation(memory.data(), 64 * 16);
+	ASSERT_LT(tagger.GetTrackedBlockCount(), sp::memory::CheckingMemoryTagger::MAX_TRACKED_FREED_BLOCKS);
+}
@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Allocator/Growing/SizeClassAllocator.h"
+#include "Allocator/NonGrowing/LinearAllocator.h"
+#include "BoundsChecker/NoBoundsChecker.h"
+#include "BoundsChecker/SimpleBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "MemoryTracker/CountingMemoryTracker.h"
+#include "MemoryTracker/FullMemoryTracker.h"
+#include "MemoryTagger/NoMemoryTagger.h"
+#include "ThreadPolicy/MutexThreadPolicy.h"
+
+namespace
+{
+	const size_t REALM_BYTES = 1024 * 1024;
+
+	typedef sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::SimpleBoundsChecker, sp::memory::CountingMemoryTracker> CountingRealm;
+	typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::NoBoundsChecker, sp::memory::CountingMemoryTracker> CountingLinearRealm;
+	typedef sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::SimpleBoundsChecker, sp::memory::FullMemoryTracker> FullRealm;
+	typedef sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::SimpleBoundsChecker, sp::memory::FullMemoryTracker,
+		sp::memory::NoMemoryTagger, sp::memory::MutexThreadPolicy> SharedFullRealm;
+}
+
+TEST(MemoryTracker, Counting_Tracks_Live_And_Peak_Bytes)
+{
+	CountingRealm realm(REALM_BYTES);
+
+	void* first = realm.Alloc(100, 8);
+	void* second = realm.Alloc(50, 8);
+	realm.Dealloc(first);
+
+	const sp::memory::MemoryStatistics statistics = realm.GetStatistics();
+	ASSERT_EQ(statistics.liveBytes, 50u) << "Live bytes do not match the outstanding allocations";
+	ASSERT_EQ(statistics.peakBytes, 150u) << "Peak bytes were not recorded";
+	ASSERT_EQ(statistics.liveAllocations, 1u);
+	ASSERT_EQ(statistics.totalAllocations, 2u);
+	ASSERT_GE(statistics.allocationsPerSecond, 0.0);
+
+	realm.Dealloc(second);
+}
+
+TEST(MemoryTracker, Counting_Works_Without_Canaries)
+{
+	CountingLinearRealm realm(REALM_BYTES);
+
+	void* memory = realm.Alloc(64, 16);
+	ASSERT_EQ(realm.GetStatistics().liveBytes, 64u);
+
+	realm.Dealloc(memory);
+	ASSERT_EQ(realm.GetStatistics().liveBytes, 0u);
+}
+
+TEST(MemoryTracker, Reset_Clears_Live_Counters)
+{
+	CountingRealm realm(REALM_BYTES);
+
+	realm.Alloc(100, 8);
+	realm.Alloc(200, 8);
+	realm.Reset();
+
+	const sp::memory::MemoryStatistics statistics = realm.GetStatistics();
+	ASSERT_EQ(statistics.liveBytes, 0u) << "Reset did not clear the live bytes";
+	ASSERT_EQ(statistics.liveAllocations, 0u) << "Reset did not clear the live allocations";
+	ASSERT_EQ(statistics.peakBytes, 300u) << "Reset should keep the peak";
+}
+
+TEST(MemoryTracker, Full_Records_Call_Sites)
+{
+	FullRealm realm(REALM_BYTES);
+
+	const uint32_t expectedLine = __LINE__ + 1;
+	void* memory = realm.Alloc(128, 8, SP_SOURCE_INFO);
+	realm.Alloc(32, 8);
+
+	const auto& records = realm.GetMemoryTracker().GetAllocationRecords();
+	ASSERT_EQ(records.size(), 2u);
+
+	const auto record = records.find(memory);
+	ASSERT_NE(record, records.end()) << "Allocation was not recorded";
+	ASSERT_EQ(record->second.size, 128u);
+	ASSERT_EQ(record->second.sourceInfo.line, expectedLine) << "Call-site was not recorded";
+	ASSERT_STREQ(record->second.sourceInfo.file, __FILE__);
+
+	realm.Dealloc(memory);
+	ASSERT_EQ(records.size(), 1u) << "Freed allocation is still recorded";
+}
+
+TEST(MemoryTracker, Dumps_Json_Snapshots)
+{
+	CountingRealm countingRealm(REALM_BYTES);
+	FullRealm fullRealm(REALM_BYTES);
+
+	countingRealm.Alloc(100, 8);
+	fullRealm.Alloc(100, 8, SP_SOURCE_INFO);
+
+	std::ostringstream countingJson;
+	countingRealm.WriteJson(countingJson);
+	ASSERT_NE(countingJson.str().find("\"liveBytes\":100"), std::string::npos) << countingJson.str();
+	ASSERT_EQ(countingJson.str().front(), '{');
+	ASSERT_EQ(countingJson.str().back(), '}');
+
+	std::ostringstream fullJson;
+	fullRealm.WriteJson(fullJson);
+	ASSERT_NE(fullJson.str().find("\"allocations\":[{"), std::string::npos) << fullJson.str();
+	ASSERT_NE(fullJson.str().find("\"size\":100"), std::string::npos) << fullJson.str();
+	ASSERT_NE(fullJson.str().find(std::string("\"function\":\"") + __FUNCTION__ + "\""), std::string::npos) << fullJson.str();
+}
+
+TEST(MemoryTracker, Snapshots_Are_Taken_Under_The_Realm_Lock)
+{
+	const size_t threadCount = 4;
+	const size_t allocationCount = 2000;
+	SharedFullRealm realm(REALM_BYTES);
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&realm]()
+		{
+			for (size_t i = 0; i < allocationCount; ++i)
+			{
+				realm.Dealloc(realm.Alloc(32, 8, SP_SOURCE_INFO));
+			}
+		});
+	}
+
+	// The records of the full tracker are rehashed while the other threads allocate
+	for (size_t i = 0; i < 100; ++i)
+	{
+		std::ostringstream json;
+		realm.WriteJson(json);
+		ASSERT_LE(realm.GetStatistics().liveAllocations, threadCount);
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	const sp::memory::MemoryStatistics statistics = realm.GetStatistics();
+	ASSERT_EQ(statistics.liveAllocations, 0u);
+	ASSERT_EQ(statistics.totalAllocations, threadCount * allocationCount);
+}
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+
+#include "Allocator/Growing/SizeClassAllocator.h"
+#include "Allocator/NonGrowing/LinearAllocator.h"
+#include "Allocator/NonGrowing/PoolAllocator.h"
+#include "Allocator/ThreadCaching/ThreadCachingPoolAllocator.h"
+#include "BoundsChecker/SimpleBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "PageMap/PageMap.h"
+#include "ThreadPolicy/MutexThreadPolicy.h"
+#include "VirtualMemory/VirtualMemory.h"
+
+const size_t ONE_KIBIBYTE = 1024;
+const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
+
+typedef sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::SimpleBoundsChecker> SizeClassRealm;
+
+TEST(PageMap, Allocator_Reservations_Are_Registered)
+{
+	void* raw_mem = nullptr;
+	{
+		sp::memory::PoolAllocator pool(64, 100, 16, 0);
+		raw_mem = pool.Alloc(64, 16, 0);
+
+		const sp::memory::PageOwner owner = sp::memory::FindPageOwner(raw_mem);
+		ASSERT_FALSE(owner.IsRealm()) << "Pages of a plain allocator were registered for a realm";
+		ASSERT_EQ(owner.GetAllocator(), &pool) << "Pages were not registered for the pool";
+	}
+
+	ASSERT_FALSE(sp::memory::FindPageOwner(raw_mem).IsValid()) << "Pages were not unregistered with the address space";
+
+	int onStack = 0;
+	ASSERT_FALSE(sp::memory::FindPageOwner(&onStack).IsValid()) << "Stack memory has an owner";
+}
+
+TEST(PageMap, Free_Routes_To_The_Owning_Allocator)
+{
+	sp::memory::PoolAllocator pool(64, 100, 16, 0);
+	sp::memory::LinearAllocator linear(ONE_MIBIBYTE);
+
+	void* poolMemory = pool.Alloc(64, 16, 0);
+	void* linearMemory = linear.Alloc(64, 16, 0);
+	ASSERT_EQ(sp::memory::FindPageOwner(linearMemory).GetAllocator(), &linear) << "Pages were not registered for the linear allocator";
+
+	sp::memory::Free(poolMemory);
+	sp::memory::Free(linearMemory);
+	sp::memory::Free(nullptr);
+
+	ASSERT_EQ(pool.Alloc(64, 16, 0), poolMemory) << "Freed chunk was not returned to its pool";
+}
+
+TEST(PageMap, Realms_Own_Everything_Their_Allocator_Reserves)
+{
+	SizeClassRealm realm(ONE_MIBIBYTE);
+
+	// The pool and the large allocation are both reserved lazily, after the realm was constructed
+	void* small = realm.Alloc(64, 16);
+	void* large = realm.Alloc(64 * ONE_KIBIBYTE, 16);
+
+	ASSERT_EQ(sp::memory::FindPageOwner(small).GetRealm(), &realm) << "Pages of a size class were not registered for the realm";
+	ASSERT_EQ(sp::memory::FindPageOwner(large).GetRealm(), &realm) << "Pages of a large allocation were not registered for the realm";
+
+	// Goes through the realm, so the canaries are validated on the way
+	sp::memory::Free(small);
+	sp::memory::Free(large);
+
+	ASSERT_FALSE(sp::memory::FindPageOwner(large).IsValid()) << "Freed large allocation is still registered";
+}
+
+TEST(PageMap, Thread_Caching_Front_End_Owns_Its_Pool)
+{
+	sp::memory::ThreadCachingPoolAllocator<sp::memory::PoolAllocator> allocator(64, 1000, 16, 0);
+
+	void* raw_mem = nullptr;
+	std::thread([&]() { raw_mem = allocator.Alloc(64, 16, 0); }).join();
+
+	ASSERT_EQ(sp::memory::FindPageOwner(raw_mem).GetAllocator(), &allocator) << "Pages were registered for the wrapped pool";
+
+	// A free on another thread ends up in this thread's magazine instead of racing on the pool
+	sp::memory::Free(raw_mem);
+}
+
+TEST(PageMap, Whole_Spans_And_Single_Pages)
+{
+	// Large enough to cover at least one span of the map completely
+	const size_t reservationSize = 64 * ONE_MIBIBYTE;
+	char* reservation = static_cast<char*>(sp::memory::ReserveAddressSpace(reservationSize));
+	ASSERT_FALSE(sp::memory::FindPageOwner(reservation).IsValid()) << "Reservation without an owner was registered";
+
+	sp::memory::LinearAllocator owner(ONE_KIBIBYTE);
+	const size_t pageSize = sp::memory::GetPageSize();
+
+	sp::memory::RegisterPages(reservation + pageSize, reservationSize - 2 * pageSize, &owner);
+	ASSERT_FALSE(sp::memory::FindPageOwner(reservation).IsValid()) << "Page in front of the range was registered";
+	ASSERT_FALSE(sp::memory::FindPageOwner(reservation + reservationSize - 1).IsValid()) << "Page behind the range was registered";
+
+	for (size_t offset = pageSize; offset < reservationSize - pageSize; offset += ONE_MIBIBYTE / 2)
+	{
+		ASSERT_EQ(sp::memory::FindPageOwner(reservation + offset).GetAllocator(), &owner) << "Page inside the range has no owner";
+	}
+
+	// Punching a hole into the middle splits whole spans up again
+	sp::memory::UnregisterPages(reservation + 32 * ONE_MIBIBYTE, pageSize);
+	ASSERT_FALSE(sp::memory::FindPageOwner(reservation + 32 * ONE_MIBIBYTE).IsValid()) << "Unregistered page still has an owner";
+	ASSERT_EQ(sp::memory::FindPageOwner(reservation + 32 * ONE_MIBIBYTE - 1).GetAllocator(), &owner) << "Neighbour of the hole lost its owner";
+	ASSERT_EQ(sp::memory::FindPageOwner(reservation + 32 * ONE_MIBIBYTE + pageSize).GetAllocator(), &owner) << "Neighbour of the hole lost its owner";
+
+	sp::memory::FreeAddressSpace(reservation, reservationSize);
+	ASSERT_FALSE(sp::memory::FindPageOwner(reservation + ONE_MIBIBYTE).IsValid()) << "Freed address space is still registered";
+}
+
+TEST(PageMap, Outermost_Scope_Owns_Reservations)
+{
+	sp::memory::LinearAllocator outer(ONE_KIBIBYTE);
+	sp::memory::LinearAllocator inner(ONE_KIBIBYTE);
+
+	void* reservation = nullptr;
+	{
+		sp::memory::ScopedPageOwner outerScope(&outer);
+		sp::memory::ScopedPageOwner innerScope(&inner);
+		reservation = sp::memory::ReserveAddressSpace(ONE_MIBIBYTE, &inner);
+	}
+
+	ASSERT_EQ(sp::memory::FindPageOwner(reservation).GetAllocator(), &outer) << "Reservation was not registered for the outermost scope";
+	sp::memory::FreeAddressSpace(reservation, ONE_MIBIBYTE);
+}
+
+TEST(PageMap, Freeing_Unregistered_Memory_Asserts)
+{
+	int onStack = 0;
+	ASSERT_DEATH(sp::memory::Free(&onStack), ".*");
+}
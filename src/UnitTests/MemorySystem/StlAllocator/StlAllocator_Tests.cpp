@@ -0,0 +1,141 @@
+#include "gtest/gtest.h"
+
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "Allocator/NonGrowing/LinearAllocator.h"
+#include "Allocator/NonGrowing/PoolAllocator.h"
+#include "BoundsChecker/SimpleBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "StlAllocator/StlAllocator.h"
+#include "StlAllocator/MemoryResource.h"
+#include "Pointers/PointerUtil.h"
+
+namespace
+{
+	const size_t SCRATCH_BYTES = 1024 * 1024;
+
+	bool IsInside(const void* memory, const void* firstAllocation)
+	{
+		const char* pointer = static_cast<const char*>(memory);
+		const char* begin = static_cast<const char*>(firstAllocation);
+		return pointer >= begin && pointer < begin + SCRATCH_BYTES;
+	}
+
+	struct alignas(32) AlignedElement
+	{
+		uint32_t foo[8];
+	};
+}
+
+TEST(StlAllocator, Vector_Allocates_From_Linear_Allocator)
+{
+	sp::memory::LinearAllocator linearAlloc(SCRATCH_BYTES);
+	void* firstAllocation = linearAlloc.Alloc(1, 1, 0);
+
+	std::vector<uint32_t, sp::memory::StlAllocator<uint32_t>> values{ sp::memory::StlAllocator<uint32_t>(linearAlloc) };
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		values.push_back(i);
+	}
+
+	ASSERT_TRUE(IsInside(values.data(), firstAllocation)) << "Vector did not allocate from the LinearAllocator";
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(values[i], i) << "Vector content was not preserved while growing";
+	}
+}
+
+TEST(StlAllocator, Elements_Are_Aligned)
+{
+	sp::memory::LinearAllocator linearAlloc(SCRATCH_BYTES);
+	linearAlloc.Alloc(1, 1, 0);
+
+	std::vector<AlignedElement, sp::memory::StlAllocator<AlignedElement>> values{ sp::memory::StlAllocator<AlignedElement>(linearAlloc) };
+	values.resize(10);
+
+	ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(values.data(), 32)) << "Elements were not aligned to a 32";
+}
+
+TEST(StlAllocator, Node_Containers_Allocate_From_Pool)
+{
+	// Some implementations allocate a sentinel node as well
+	sp::memory::PoolAllocator pool(64, 101, 16, 0);
+	std::list<uint32_t, sp::memory::StlAllocator<uint32_t>> values{ sp::memory::StlAllocator<uint32_t>(pool) };
+
+	for (uint32_t i = 0; i < 100; ++i)
+	{
+		values.push_back(i);
+	}
+
+	values.pop_front();
+	values.push_back(100);
+
+	ASSERT_EQ(values.size(), 100u);
+	ASSERT_EQ(values.front(), 1u);
+	ASSERT_EQ(values.back(), 100u);
+}
+
+TEST(StlAllocator, Rebound_Copies_Compare_Equal)
+{
+	sp::memory::LinearAllocator firstAlloc(SCRATCH_BYTES);
+	sp::memory::LinearAllocator secondAlloc(SCRATCH_BYTES);
+
+	sp::memory::StlAllocator<uint32_t> first(firstAlloc);
+	sp::memory::StlAllocator<double> rebound(first);
+	sp::memory::StlAllocator<uint32_t> second(secondAlloc);
+
+	ASSERT_TRUE(first == rebound) << "Rebound allocator does not share the allocator";
+	ASSERT_TRUE(first != second) << "Allocators over different allocators compare equal";
+}
+
+TEST(StlAllocator, Map_Allocates_From_Realm)
+{
+	typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::SimpleBoundsChecker> LinearRealm;
+	typedef std::pair<const uint32_t, uint32_t> MapEntry;
+
+	LinearRealm realm(SCRATCH_BYTES);
+	std::map<uint32_t, uint32_t, std::less<uint32_t>, sp::memory::StlAllocator<MapEntry>> values{ sp::memory::StlAllocator<MapEntry>(realm) };
+
+	for (uint32_t i = 0; i < 100; ++i)
+	{
+		values[i] = i * 2;
+	}
+
+	ASSERT_EQ(values.size(), 100u);
+	ASSERT_EQ(values[50], 100u);
+}
+
+TEST(MemoryResource, Pmr_Containers_Allocate_From_Linear_Allocator)
+{
+	sp::memory::LinearAllocator linearAlloc(SCRATCH_BYTES);
+	void* firstAllocation = linearAlloc.Alloc(1, 1, 0);
+
+	sp::memory::MemoryResource resource(linearAlloc);
+	std::pmr::vector<uint32_t> values(&resource);
+	std::pmr::unordered_map<uint32_t, uint32_t> map(&resource);
+
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		values.push_back(i);
+		map[i] = i;
+	}
+
+	ASSERT_TRUE(IsInside(values.data(), firstAllocation)) << "Vector did not allocate from the LinearAllocator";
+	ASSERT_EQ(map.size(), 1000u);
+}
+
+TEST(MemoryResource, Resources_Over_The_Same_Allocator_Are_Equal)
+{
+	sp::memory::LinearAllocator firstAlloc(SCRATCH_BYTES);
+	sp::memory::LinearAllocator secondAlloc(SCRATCH_BYTES);
+
+	sp::memory::MemoryResource first(firstAlloc);
+	sp::memory::MemoryResource sameAllocator(firstAlloc);
+	sp::memory::MemoryResource second(secondAlloc);
+
+	ASSERT_TRUE(first.is_equal(sameAllocator)) << "Resources over the same allocator are not interchangeable";
+	ASSERT_FALSE(first.is_equal(second)) << "Resources over different allocators are interchangeable";
+}
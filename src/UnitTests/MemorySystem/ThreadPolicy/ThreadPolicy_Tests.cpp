@@ -0,0 +1,220 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Allocator/Growing/SizeClassAllocator.h"
+#include "Allocator/ThreadCaching/ThreadCachingPoolAllocator.h"
+#include "Allocator/NonGrowing/LinearAllocator.h"
+#include "BoundsChecker/SimpleBoundsChecker.h"
+#include "MemoryRealm/MemoryRealm.h"
+#include "MemoryTracker/NoMemoryTracker.h"
+#include "MemoryTagger/NoMemoryTagger.h"
+#include "ThreadPolicy/MutexThreadPolicy.h"
+#include "ThreadPolicy/SpinLockThreadPolicy.h"
+#include "ThreadPolicy/PerThreadInstanceThreadPolicy.h"
+
+namespace
+{
+	const size_t REALM_BYTES = 16 * 1024 * 1024;
+	const size_t THREAD_COUNT = 8;
+	const size_t ALLOCATIONS_PER_THREAD = 2000;
+
+	template <typename ThreadPolicy>
+	using SharedRealm = sp::memory::MemoryRealm<sp::memory::SizeClassAllocator, sp::memory::SimpleBoundsChecker,
+		sp::memory::NoMemoryTracker, sp::memory::NoMemoryTagger, ThreadPolicy>;
+
+	///
+	/// Every thread allocates blocks of varying size, tags them with its index and frees
+	/// every other one again. Canaries are validated on every free.
+	///
+	template <typename Realm>
+	void AllocateConcurrently(Realm& realm, std::vector<std::vector<uint32_t*>>& allocations)
+	{
+		allocations.resize(THREAD_COUNT);
+		std::vector<std::thread> threads;
+
+		for (size_t t = 0; t < THREAD_COUNT; ++t)
+		{
+			threads.emplace_back([&realm, &allocations, t]()
+			{
+				for (size_t i = 0; i < ALLOCATIONS_PER_THREAD; ++i)
+				{
+					const size_t count = 1 + (i % 16);
+					uint32_t* values = static_cast<uint32_t*>(realm.Alloc(count * sizeof(uint32_t), 4));
+					for (size_t idx = 0; idx < count; ++idx)
+					{
+						values[idx] = static_cast<uint32_t>(t);
+					}
+
+					if (i % 2 == 0)
+					{
+						realm.Dealloc(values);
+					}
+					else
+					{
+						allocations[t].push_back(values);
+					}
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	void ExpectUniqueAndIntact(const std::vector<std::vector<uint32_t*>>& allocations)
+	{
+		std::set<uint32_t*> uniqueAllocations;
+		for (size_t t = 0; t < allocations.size(); ++t)
+		{
+			for (uint32_t* allocation : allocations[t])
+			{
+				ASSERT_EQ(allocation[0], t) << "Allocation was overwritten by another thread";
+				uniqueAllocations.insert(allocation);
+			}
+		}
+
+		ASSERT_EQ(uniqueAllocations.size(), THREAD_COUNT * ALLOCATIONS_PER_THREAD / 2) << "A block was handed out twice";
+	}
+}
+
+TEST(ThreadPolicy, SpinLock_Provides_Mutual_Exclusion)
+{
+	sp::memory::SpinLockThreadPolicy spinLock;
+	size_t counter = 0;
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < THREAD_COUNT; ++t)
+	{
+		threads.emplace_back([&spinLock, &counter]()
+		{
+			for (size_t i = 0; i < 10000; ++i)
+			{
+				std::lock_guard<sp::memory::SpinLockThreadPolicy> lock(spinLock);
+				++counter;
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	ASSERT_EQ(counter, THREAD_COUNT * 10000) << "Increments were lost";
+}
+
+TEST(ThreadPolicy, Mutex_Realm_Is_Shareable_Between_Threads)
+{
+	SharedRealm<sp::memory::MutexThreadPolicy> realm(REALM_BYTES);
+	std::vector<std::vector<uint32_t*>> allocations;
+
+	AllocateConcurrently(realm, allocations);
+	ExpectUniqueAndIntact(allocations);
+}
+
+TEST(ThreadPolicy, SpinLock_Realm_Is_Shareable_Between_Threads)
+{
+	SharedRealm<sp::memory::SpinLockThreadPolicy> realm(REALM_BYTES);
+	std::vector<std::vector<uint32_t*>> allocations;
+
+	AllocateConcurrently(realm, allocations);
+	ExpectUniqueAndIntact(allocations);
+}
+
+TEST(ThreadPolicy, PerThread_Realm_Is_Shareable_Between_Threads)
+{
+	SharedRealm<sp::memory::PerThreadInstanceThreadPolicy> realm(REALM_BYTES);
+	std::vector<std::vector<uint32_t*>> allocations;
+
+	AllocateConcurrently(realm, allocations);
+	ExpectUniqueAndIntact(allocations);
+}
+
+TEST(ThreadPolicy, PerThread_Realm_Accepts_Frees_From_Other_Threads)
+{
+	SharedRealm<sp::memory::PerThreadInstanceThreadPolicy> realm(REALM_BYTES);
+	std::vector<std::vector<uint32_t*>> allocations;
+
+	AllocateConcurrently(realm, allocations);
+
+	// Free everything on a single thread while the others keep allocating from their instances
+	std::thread consumer([&realm, &allocations]()
+	{
+		for (std::vector<uint32_t*>& threadAllocations : allocations)
+		{
+			for (uint32_t* allocation : threadAllocations)
+			{
+				realm.Dealloc(allocation);
+			}
+		}
+	});
+
+	std::vector<std::vector<uint32_t*>> moreAllocations;
+	AllocateConcurrently(realm, moreAllocations);
+	consumer.join();
+
+	ExpectUniqueAndIntact(moreAllocations);
+}
+
+TEST(ThreadPolicy, PerThread_Instances_Are_Separate)
+{
+	typedef sp::memory::MemoryRealm<sp::memory::LinearAllocator, sp::memory::SimpleBoundsChecker,
+		sp::memory::NoMemoryTracker, sp::memory::NoMemoryTagger, sp::memory::PerThreadInstanceThreadPolicy> PerThreadLinearRealm;
+
+	// Every thread gets the full budget, so two threads can allocate more than one instance holds
+	PerThreadLinearRealm realm(64 * 1024);
+	void* first = realm.Alloc(40 * 1024, 16);
+	void* second = nullptr;
+
+	std::thread other([&realm, &second]()
+	{
+		second = realm.Alloc(40 * 1024, 16);
+	});
+	other.join();
+
+	ASSERT_NE(first, nullptr);
+	ASSERT_NE(second, nullptr) << "The second thread did not get its own instance";
+}
+
+TEST(ThreadPolicy, PerThread_Realm_Serves_More_Threads_Than_Instances)
+{
+	const size_t threadCount = sp::memory::THREAD_CACHE_MAX_THREADS + 16;
+	SharedRealm<sp::memory::PerThreadInstanceThreadPolicy> realm(1024 * 1024);
+
+	// All threads stay alive until every one allocated, the last ones share the overflow instance
+	std::atomic<size_t> allocatedCount(0);
+	std::vector<void*> allocations(threadCount, nullptr);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&realm, &allocatedCount, &allocations, t, threadCount]()
+		{
+			allocations[t] = realm.Alloc(64, 16);
+			allocatedCount.fetch_add(1);
+			while (allocatedCount.load() < threadCount)
+			{
+				std::this_thread::yield();
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::set<void*> uniqueAllocations(allocations.begin(), allocations.end());
+	ASSERT_EQ(uniqueAllocations.count(nullptr), 0u) << "A thread without an instance of its own did not get memory";
+	ASSERT_EQ(uniqueAllocations.size(), threadCount) << "A block was handed out twice";
+
+	for (void* allocation : allocations)
+	{
+		realm.Dealloc(allocation);
+	}
+}
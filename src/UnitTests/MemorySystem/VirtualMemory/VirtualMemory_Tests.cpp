@@ -1,12 +1,9 @@
 #include "gtest/gtest.h"
 
 #include "VirtualMemory/VirtualMemory.h"
+#include "Pointers/PointerUtil.h"
 
-///
-/// Currently windows only tests
-///
-
-const size_t WINDOWS_PAGE_SIZE = 4096; // 4KB page size on windows
+const size_t DEFAULT_PAGE_SIZE = 4096; // 4KB page size on windows and x86-64 linux
 const size_t ONE_KIBIBYTE = 1024;
 const size_t ONE_MIBIBYTE = 1024 * ONE_KIBIBYTE;
 const size_t ONE_GIBIBYTE = 1024 * ONE_MIBIBYTE;
@@ -14,20 +11,20 @@ const size_t ONE_GIBIBYTE = 1024 * ONE_MIBIBYTE;
 TEST(VirtualMemory, GetPageSize)
 {
 	size_t osPageSize = sp::memory::GetPageSize();
-	ASSERT_EQ(osPageSize, WINDOWS_PAGE_SIZE);
+	ASSERT_EQ(osPageSize, DEFAULT_PAGE_SIZE);
 }
 
 TEST(VirtualMemory, ReserveRequestedAddressSpace)
 {
 	void* memBegin = sp::memory::ReserveAddressSpace(ONE_MIBIBYTE);
 	ASSERT_NE(memBegin, nullptr) << "ReserveAddressSapce should not return a nullptr";
-	sp::memory::FreeAddressSpace(memBegin);
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE);
 }
 
 TEST(VirtualMemory, FreeRequestedAddressSpace)
 {
 	void* memBegin = sp::memory::ReserveAddressSpace(ONE_MIBIBYTE);
-	sp::memory::FreeAddressSpace(memBegin);
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE);
 }
 
 TEST(VirtualMemory, CommitPhysicalPages)
@@ -40,7 +37,7 @@ TEST(VirtualMemory, CommitPhysicalPages)
 	memcpy(physicalMemBegin, &source, sizeof(size_t));
 	ASSERT_EQ(static_cast<size_t*>(physicalMemBegin)[0], 100) << "Could not read 100 from physical memory";
 
-	sp::memory::FreeAddressSpace(memBegin);
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE);
 }
 
 TEST(VirtualMemory, CommitPhysicalPagesMedium)
@@ -53,7 +50,7 @@ TEST(VirtualMemory, CommitPhysicalPagesMedium)
 	memcpy(physicalMemBegin, &source, sizeof(size_t));
 	ASSERT_EQ(static_cast<size_t*>(physicalMemBegin)[0], 100) << "Could not read 100 from physical memory";
 
-	sp::memory::FreeAddressSpace(memBegin);
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE * 500);
 }
 
 TEST(VirtualMemory, CommitPhysicalPagesLarge)
@@ -66,7 +63,7 @@ TEST(VirtualMemory, CommitPhysicalPagesLarge)
 	memcpy(physicalMemBegin, &source, sizeof(size_t));
 	ASSERT_EQ(static_cast<size_t*>(physicalMemBegin)[0], 100) << "Could not read 100 from physical memory";
 
-	sp::memory::FreeAddressSpace(memBegin);
+	sp::memory::FreeAddressSpace(memBegin, ONE_GIBIBYTE);
 }
 
 TEST(VirtualMemory, DecommitPhysicalPages)
@@ -74,5 +71,114 @@ TEST(VirtualMemory, DecommitPhysicalPages)
 	void* memBegin = sp::memory::ReserveAddressSpace(ONE_MIBIBYTE);
 	void* physicalMemBegin = sp::memory::CommitPhysicalMemory(memBegin, ONE_MIBIBYTE);
 	sp::memory::DecommitPhysicalMemory(physicalMemBegin, ONE_MIBIBYTE);
-	sp::memory::FreeAddressSpace(memBegin);
-}
\ No newline at end of file
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE);
+}
+
+TEST(VirtualMemory, DecommittedPagesAreZeroedOnRecommit)
+{
+	void* memBegin = sp::memory::ReserveAddressSpace(ONE_MIBIBYTE);
+	void* physicalMemBegin = sp::memory::CommitPhysicalMemory(memBegin, ONE_MIBIBYTE);
+
+	static_cast<size_t*>(physicalMemBegin)[0] = 100;
+	sp::memory::DecommitPhysicalMemory(physicalMemBegin, ONE_MIBIBYTE);
+	physicalMemBegin = sp::memory::CommitPhysicalMemory(memBegin, ONE_MIBIBYTE);
+
+	ASSERT_EQ(static_cast<size_t*>(physicalMemBegin)[0], 0) << "Recommitted memory should not contain the old content";
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE);
+}
+
+TEST(VirtualMemory, CommitUnalignedRangeCommitsWholePages)
+{
+	char* memBegin = static_cast<char*>(sp::memory::ReserveAddressSpace(ONE_MIBIBYTE));
+	char* physicalMemBegin = static_cast<char*>(sp::memory::CommitPhysicalMemory(memBegin + 100, 10));
+	ASSERT_EQ(physicalMemBegin, memBegin) << "Commit should start at the page containing the requested address";
+
+	physicalMemBegin[sp::memory::GetPageSize() - 1] = 1;
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE);
+}
+
+TEST(VirtualMemory, TransparentHugePagesAreOptIn)
+{
+	ASSERT_FALSE(sp::memory::UsesTransparentHugePages()) << "Huge pages should be disabled by default";
+}
+
+TEST(VirtualMemory, HugePageReservationIsHugePageAligned)
+{
+	sp::memory::SetTransparentHugePages(true);
+	void* memBegin = sp::memory::ReserveAddressSpace(ONE_GIBIBYTE);
+	const bool hugePagesInUse = sp::memory::UsesTransparentHugePages();
+	sp::memory::SetTransparentHugePages(false);
+
+	ASSERT_NE(memBegin, nullptr) << "ReserveAddressSpace should not return a nullptr";
+	if (hugePagesInUse)
+	{
+		ASSERT_TRUE(sp::pointerUtil::IsAlignedTo(memBegin, sp::memory::HUGE_PAGE_SIZE)) << "Reservation should start on a huge page boundary";
+	}
+
+	void* physicalMemBegin = sp::memory::CommitPhysicalMemory(memBegin, sp::memory::HUGE_PAGE_SIZE * 2);
+	ASSERT_NE(physicalMemBegin, nullptr) << "CommitPhysicalMemory should not return a nullptr";
+	static_cast<size_t*>(physicalMemBegin)[0] = 100;
+	ASSERT_EQ(static_cast<size_t*>(physicalMemBegin)[0], 100) << "Could not read 100 from physical memory";
+
+	sp::memory::FreeAddressSpace(memBegin, ONE_GIBIBYTE);
+}
+
+TEST(VirtualMemory, NumaNodesAreAlwaysAvailable)
+{
+	const uint32_t nodeCount = sp::memory::GetNumaNodeCount();
+	ASSERT_GE(nodeCount, 1u) << "Without NUMA support there should still be a single node";
+	ASSERT_LE(nodeCount, sp::memory::NUMA_MAX_NODE_COUNT);
+	ASSERT_LT(sp::memory::GetCurrentNumaNode(), nodeCount) << "Current node is out of range";
+}
+
+TEST(VirtualMemory, ReservationOnNodeIsBackedByThatNode)
+{
+	const uint32_t node = sp::memory::GetCurrentNumaNode();
+	void* memBegin = sp::memory::ReserveAddressSpaceOnNode(ONE_MIBIBYTE, node);
+	ASSERT_NE(memBegin, nullptr) << "ReserveAddressSpaceOnNode should not return a nullptr";
+	ASSERT_EQ(sp::memory::GetNumaNodeOfPage(memBegin), sp::memory::NUMA_NODE_ANY) << "Uncommitted page should not have a node";
+
+	void* physicalMemBegin = sp::memory::CommitPhysicalMemory(memBegin, ONE_MIBIBYTE);
+	static_cast<size_t*>(physicalMemBegin)[0] = 100;
+
+	// Unknown if the OS does not report it, memory must not end up somewhere else though
+	const uint32_t pageNode = sp::memory::GetNumaNodeOfPage(physicalMemBegin);
+	ASSERT_TRUE(pageNode == node || pageNode == sp::memory::NUMA_NODE_ANY) << "Page was not committed on the requested node";
+
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE);
+}
+
+TEST(VirtualMemory, CommitOnNodeWorksForUnboundReservations)
+{
+	void* memBegin = sp::memory::ReserveAddressSpace(ONE_MIBIBYTE);
+	void* physicalMemBegin = sp::memory::CommitPhysicalMemoryOnNode(memBegin, ONE_MIBIBYTE, 0);
+	ASSERT_NE(physicalMemBegin, nullptr) << "CommitPhysicalMemoryOnNode should not return a nullptr";
+
+	static_cast<size_t*>(physicalMemBegin)[0] = 100;
+	ASSERT_EQ(static_cast<size_t*>(physicalMemBegin)[0], 100) << "Could not read 100 from physical memory";
+
+	const uint32_t pageNode = sp::memory::GetNumaNodeOfPage(physicalMemBegin);
+	ASSERT_TRUE(pageNode == 0 || pageNode == sp::memory::NUMA_NODE_ANY) << "Page was not committed on the requested node";
+
+	sp::memory::FreeAddressSpace(memBegin, ONE_MIBIBYTE);
+}
+
+TEST(VirtualMemory, InnermostNumaScopeWins)
+{
+	ASSERT_EQ(sp::memory::ScopedNumaNode::GetNode(), sp::memory::NUMA_NODE_ANY) << "Reservations should not be bound by default";
+	{
+		sp::memory::ScopedNumaNode outerScope(0);
+		ASSERT_EQ(sp::memory::ScopedNumaNode::GetNode(), 0u);
+		{
+			sp::memory::ScopedNumaNode innerScope(sp::memory::NUMA_NODE_ANY);
+			ASSERT_EQ(sp::memory::ScopedNumaNode::GetNode(), sp::memory::NUMA_NODE_ANY) << "Inner scope did not lift the binding";
+		}
+		ASSERT_EQ(sp::memory::ScopedNumaNode::GetNode(), 0u) << "Outer scope was not restored";
+	}
+	ASSERT_EQ(sp::memory::ScopedNumaNode::GetNode(), sp::memory::NUMA_NODE_ANY);
+}
+
+TEST(VirtualMemory, BindingToMissingNodeAsserts)
+{
+	ASSERT_DEATH(sp::memory::ScopedNumaNode(sp::memory::GetNumaNodeCount()), ".*");
+}